@@ -0,0 +1,166 @@
+#pragma once
+
+/**
+* \brief Default benchmark properties
+*/
+#define DEFAULT_BENCHMARK_SAMPLES 30
+#define DEFAULT_BENCHMARK_MIN_SAMPLE_TIME 0.002
+
+namespace Sonar
+{
+	class Benchmark
+	{
+	public:
+		/**
+		 * \brief Timings of one benchmark, all times are nanoseconds per iteration
+		 */
+		struct Result
+		{
+			std::string name;
+			unsigned long long int iterationsPerSample;
+			unsigned int samples;
+			double minTime;
+			double medianTime;
+			double meanTime;
+			double maxTime;
+		};
+
+		/**
+		 * \brief Class constructor
+		 *
+		 * \param samples Amount of timed samples per benchmark
+		 * \param minSampleTime Minimum length of a sample in seconds, fast functions run several times per sample so the clock doesn't dominate
+		 */
+		Benchmark( const unsigned int &samples = DEFAULT_BENCHMARK_SAMPLES, const double &minSampleTime = DEFAULT_BENCHMARK_MIN_SAMPLE_TIME );
+
+		/**
+		 * \brief Class destructor
+		 */
+		~Benchmark( );
+
+		/**
+		 * \brief Only run benchmarks whose name contains a string
+		 *
+		 * \param filter String to match (empty runs everything)
+		 */
+		void SetFilter( const std::string &filter );
+
+		/**
+		 * \brief Time a function and store the result
+		 *
+		 * \param name Benchmark name
+		 * \param function Function to time, called repeatedly (pass results to DoNotOptimize so the work isn't optimised away)
+		 */
+		template<typename Function>
+		void Run( const std::string &name, Function &&function );
+
+		/**
+		 * \brief Stop the compiler removing a value's calculation as unused
+		 *
+		 * \param value Value to keep
+		 */
+		template<typename T>
+		static void DoNotOptimize( const T &value );
+
+		/**
+		 * \brief Get the results of the benchmarks run so far
+		 *
+		 * \return Output returns the results
+		 */
+		const std::vector<Result> &GetResults( ) const;
+
+		/**
+		 * \brief Write the results as JSON
+		 *
+		 * \param filepath File to write
+		 *
+		 * \return Output returns true if the file was written
+		 */
+		bool WriteJSON( const std::string &filepath ) const;
+
+	private:
+		/**
+		 * \brief Time a batch of iterations
+		 *
+		 * \param function Function to time
+		 * \param iterations Amount of calls
+		 *
+		 * \return Output returns the batch time in seconds
+		 */
+		template<typename Function>
+		static double TimeBatch( Function &function, const unsigned long long int &iterations );
+
+		/**
+		 * \brief Turn sample times into a result and log it
+		 *
+		 * \param name Benchmark name
+		 * \param iterations Iterations per sample
+		 * \param sampleTimes Time of each sample in seconds
+		 */
+		void AddResult( const std::string &name, const unsigned long long int &iterations, std::vector<double> &sampleTimes );
+
+		/**
+		 * \brief Amount of timed samples per benchmark
+		 */
+		unsigned int _samples;
+
+		/**
+		 * \brief Minimum sample length in seconds
+		 */
+		double _minSampleTime;
+
+		/**
+		 * \brief Benchmark name filter
+		 */
+		std::string _filter;
+
+		/**
+		 * \brief Results so far
+		 */
+		std::vector<Result> _results;
+
+	};
+
+	template<typename Function>
+	void Benchmark::Run( const std::string &name, Function &&function )
+	{
+		if ( !_filter.empty( ) && std::string::npos == name.find( _filter ) )
+		{ return; }
+
+		// Double the batch until a sample is long enough to time accurately, this also warms up caches and allocators
+		unsigned long long int iterations = 1;
+
+		while ( TimeBatch( function, iterations ) < _minSampleTime )
+		{ iterations *= 2; }
+
+		std::vector<double> sampleTimes;
+		sampleTimes.reserve( _samples );
+
+		for ( unsigned int i = 0; i < _samples; i++ )
+		{ sampleTimes.push_back( TimeBatch( function, iterations ) ); }
+
+		AddResult( name, iterations, sampleTimes );
+	}
+
+	template<typename T>
+	void Benchmark::DoNotOptimize( const T &value )
+	{
+	#if defined( __GNUC__ ) || defined( __clang__ )
+		asm volatile( "" : : "r,m"( value ) : "memory" );
+	#else
+		static volatile const void *sink;
+		sink = &value;
+	#endif
+	}
+
+	template<typename Function>
+	double Benchmark::TimeBatch( Function &function, const unsigned long long int &iterations )
+	{
+		const auto start = std::chrono::steady_clock::now( );
+
+		for ( unsigned long long int i = 0; i < iterations; i++ )
+		{ function( ); }
+
+		return std::chrono::duration<double>( std::chrono::steady_clock::now( ) - start ).count( );
+	}
+}
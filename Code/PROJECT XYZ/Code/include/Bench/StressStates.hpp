@@ -0,0 +1,190 @@
+#pragma once
+
+/**
+* \brief Default stress scene properties
+*/
+#define DEFAULT_STRESS_SPRITE_TEXTURE "Resources/box.png"
+#define DEFAULT_STRESS_BACKGROUND_TEXTURE "Resources/Background.jpg"
+#define DEFAULT_STRESS_FONT "Resources/arial.ttf"
+#define DEFAULT_STRESS_MINIMAP_MAP_SIZE 4096.0f
+#define DEFAULT_STRESS_TILE_MAP_CELL_SIZE 16.0f
+#define DEFAULT_STRESS_TILE_MAP_SCROLL_SPEED 400.0f
+
+namespace Sonar
+{
+	/**
+	 * \brief Sprites bouncing around the window
+	 */
+	class SpriteStressState : public State
+	{
+	public:
+		SpriteStressState( GameDataRef data, const unsigned int &count );
+
+		~SpriteStressState( );
+
+		void Init( );
+
+		void PollInput( const float &dt, Event &event );
+		void Update( const float &dt );
+		void Draw( const float &dt );
+
+	private:
+		GameDataRef _data;
+
+		unsigned int _count;
+
+		std::vector<Sprite *> _sprites;
+
+		std::vector<glm::vec2> _velocities;
+
+	};
+
+	/**
+	 * \brief Rectangles, circles and triangles (a third of each) bouncing and spinning around the window
+	 */
+	class ShapeStressState : public State
+	{
+	public:
+		ShapeStressState( GameDataRef data, const unsigned int &count );
+
+		~ShapeStressState( );
+
+		void Init( );
+
+		void PollInput( const float &dt, Event &event );
+		void Update( const float &dt );
+		void Draw( const float &dt );
+
+	private:
+		GameDataRef _data;
+
+		unsigned int _count;
+
+		std::vector<Rectangle *> _rectangles;
+
+		std::vector<Circle *> _circles;
+
+		std::vector<Triangle *> _triangles;
+
+		std::vector<glm::vec2> _velocities;
+
+	};
+
+	/**
+	 * \brief Labels with their own text bouncing around the window
+	 */
+	class LabelStressState : public State
+	{
+	public:
+		LabelStressState( GameDataRef data, const unsigned int &count );
+
+		~LabelStressState( );
+
+		void Init( );
+
+		void PollInput( const float &dt, Event &event );
+		void Update( const float &dt );
+		void Draw( const float &dt );
+
+	private:
+		GameDataRef _data;
+
+		unsigned int _count;
+
+		std::vector<Label *> _labels;
+
+		std::vector<glm::vec2> _velocities;
+
+	};
+
+	/**
+	 * \brief Parallax with one scrolling background per layer, each layer moving at its own speed
+	 */
+	class ParallaxStressState : public State
+	{
+	public:
+		ParallaxStressState( GameDataRef data, const unsigned int &layerCount );
+
+		~ParallaxStressState( );
+
+		void Init( );
+
+		void PollInput( const float &dt, Event &event );
+		void Update( const float &dt );
+		void Draw( const float &dt );
+
+	private:
+		GameDataRef _data;
+
+		unsigned int _layerCount;
+
+		Parallax *_parallax;
+
+	};
+
+	/**
+	 * \brief Minimap tracking objects that move across the map every update
+	 */
+	class MinimapStressState : public State
+	{
+	public:
+		MinimapStressState( GameDataRef data, const unsigned int &count );
+
+		~MinimapStressState( );
+
+		void Init( );
+
+		void PollInput( const float &dt, Event &event );
+		void Update( const float &dt );
+		void Draw( const float &dt );
+
+	private:
+		GameDataRef _data;
+
+		unsigned int _count;
+
+		Minimap *_minimap;
+
+		std::vector<unsigned int> _ids;
+
+		std::vector<glm::vec2> _positions;
+
+		std::vector<glm::vec2> _velocities;
+
+	};
+
+	/**
+	 * \brief Tile map scrolled under the view with a few cells changed every update
+	 */
+	class TileMapStressState : public State
+	{
+	public:
+		TileMapStressState( GameDataRef data, const unsigned int &size );
+
+		~TileMapStressState( );
+
+		void Init( );
+
+		void PollInput( const float &dt, Event &event );
+		void Update( const float &dt );
+		void Draw( const float &dt );
+
+	private:
+		GameDataRef _data;
+
+		unsigned int _size;
+
+		MapManager *_map;
+
+		TileMap *_tileMap;
+
+		sf::Texture _tileset;
+
+		sf::View _view;
+
+		glm::vec2 _velocity;
+
+		unsigned int _changeCount;
+
+	};
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+/**
+* \brief Default stress test properties
+*/
+#define DEFAULT_STRESS_TEST_FRAMES 600
+#define DEFAULT_STRESS_TEST_WARMUP_FRAMES 60
+#define DEFAULT_STRESS_TEST_WINDOW_WIDTH 1280
+#define DEFAULT_STRESS_TEST_WINDOW_HEIGHT 720
+
+namespace Sonar
+{
+	class StressTest
+	{
+	public:
+		/**
+		 * \brief Frame statistics of one scene, all times are milliseconds
+		 */
+		struct Result
+		{
+			std::string name;
+			unsigned int objectCount;
+			unsigned int frames;
+			float minFrameTime;
+			float p50FrameTime;
+			float p95FrameTime;
+			float p99FrameTime;
+			float maxFrameTime;
+			float meanFrameTime;
+			float p50UpdateTime;
+			float p50DrawTime;
+			float meanDrawCalls;
+			unsigned int p50DrawCalls;
+			unsigned int p99DrawCalls;
+			unsigned int maxDrawCalls;
+			float meanVertexCount;
+		};
+
+		/**
+		 * \brief Class constructor, opens the window every scene is drawn to (vertical sync and the frame rate limit are off)
+		 *
+		 * \param width Window width
+		 * \param height Window height
+		 * \param frames Amount of measured frames per scene
+		 * \param warmupFrames Amount of frames run before measuring so textures are uploaded and caches are warm
+		 */
+		StressTest( const unsigned int &width = DEFAULT_STRESS_TEST_WINDOW_WIDTH, const unsigned int &height = DEFAULT_STRESS_TEST_WINDOW_HEIGHT, const unsigned int &frames = DEFAULT_STRESS_TEST_FRAMES, const unsigned int &warmupFrames = DEFAULT_STRESS_TEST_WARMUP_FRAMES );
+
+		/**
+		 * \brief Class destructor
+		 */
+		~StressTest( );
+
+		/**
+		 * \brief Get the game data scenes should be constructed with
+		 *
+		 * \return Output returns the game data
+		 */
+		GameDataRef GetGameData( ) const;
+
+		/**
+		 * \brief Only run scenes whose name contains a string
+		 *
+		 * \param filter String to match (empty runs everything)
+		 */
+		void SetFilter( const std::string &filter );
+
+		/**
+		 * \brief Check if a scene would be run with the current filter (so scenes that are skipped aren't built)
+		 *
+		 * \param name Scene name
+		 *
+		 * \return Output returns true if the scene should be run
+		 */
+		bool IsSelected( const std::string &name ) const;
+
+		/**
+		 * \brief Run a scene for the warmup and measured frames and store the result
+		 *
+		 * \param name Scene name
+		 * \param objectCount Amount of objects in the scene (only reported)
+		 * \param state State that builds and draws the scene, it replaces the previous scene's state
+		 *
+		 * \return Output returns false if the window was closed during the run
+		 */
+		bool Run( const std::string &name, const unsigned int &objectCount, StateRef state );
+
+		/**
+		 * \brief Get the results of the scenes run so far
+		 *
+		 * \return Output returns the results
+		 */
+		const std::vector<Result> &GetResults( ) const;
+
+		/**
+		 * \brief Write the results as JSON
+		 *
+		 * \param filepath File to write
+		 *
+		 * \return Output returns true if the file was written
+		 */
+		bool WriteJSON( const std::string &filepath ) const;
+
+	private:
+		/**
+		 * \brief Run a single frame the same way Game::Run does with one fixed step per frame
+		 *
+		 * \return Output returns the frame's statistics
+		 */
+		FrameStats::Frame RunFrame( );
+
+		/**
+		 * \brief Turn frame statistics into a result and log it
+		 *
+		 * \param name Scene name
+		 * \param objectCount Amount of objects in the scene
+		 * \param frames Statistics of each measured frame
+		 */
+		void AddResult( const std::string &name, const unsigned int &objectCount, const std::vector<FrameStats::Frame> &frames );
+
+		/**
+		 * \brief Get a percentile from sorted values (nearest rank)
+		 *
+		 * \param values Values sorted in ascending order
+		 * \param percentile Percentile between 0 and 100
+		 *
+		 * \return Output returns the value at the percentile
+		 */
+		template<typename T>
+		static T Percentile( const std::vector<T> &values, const float &percentile );
+
+		/**
+		 * \brief Game data for the scenes
+		 */
+		GameDataRef _data;
+
+		/**
+		 * \brief Fixed time step
+		 */
+		const float _dt = 1.0f / 60.0f;
+
+		/**
+		 * \brief Amount of measured frames per scene
+		 */
+		unsigned int _frames;
+
+		/**
+		 * \brief Amount of warmup frames per scene
+		 */
+		unsigned int _warmupFrames;
+
+		/**
+		 * \brief Scene name filter
+		 */
+		std::string _filter;
+
+		/**
+		 * \brief Results so far
+		 */
+		std::vector<Result> _results;
+
+		/**
+		 * \brief Frame clock
+		 */
+		Clock _clock;
+
+	};
+
+	template<typename T>
+	T StressTest::Percentile( const std::vector<T> &values, const float &percentile )
+	{
+		if ( values.empty( ) )
+		{ return T( ); }
+
+		const size_t rank = static_cast<size_t>( std::ceil( percentile / 100.0f * values.size( ) ) );
+
+		return values.at( std::min( values.size( ), std::max<size_t>( rank, 1 ) ) - 1 );
+	}
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "AI/NavigationGrid.hpp"
+
+namespace Sonar
+{
+	/**
+	 * \brief Direction to step in from every cell of a map layer to reach one target cell along the cheapest path, built and kept up to date by FlowFieldCache
+	 *
+	 * Any number of agents can share a field, each one looks up the direction for the cell it's in.
+	 * Movement is to any of the 8 neighbouring cells without cutting past a blocked corner, the same as Pathfinder.
+	 */
+	class FlowField
+	{
+	public:
+		/**
+		 * \brief Class constructor
+		 *
+		 * \param target Cell every direction leads to
+		 */
+		FlowField( const glm::uvec2 &target );
+
+		/**
+		 * \brief Class destructor
+		 */
+		~FlowField( );
+
+		/**
+		 * \brief Get the direction to step in from a cell
+		 *
+		 * \param x X position of the cell
+		 * \param y Y position of the cell
+		 *
+		 * \return Output returns a unit vector (zero at the target, outside the field or where the target can't be reached)
+		 */
+		glm::vec2 GetDirection( const unsigned int &x, const unsigned int &y ) const;
+
+		/**
+		 * \brief Get the neighbouring cell to step to from a cell
+		 *
+		 * \param x X position of the cell
+		 * \param y Y position of the cell
+		 *
+		 * \return Output returns the next cell (the cell itself at the target, outside the field or where the target can't be reached)
+		 */
+		glm::uvec2 GetNextCell( const unsigned int &x, const unsigned int &y ) const;
+
+		/**
+		 * \brief Get the cost of the cheapest path from a cell to the target (straight steps cost 1, diagonal steps cost the square root of 2)
+		 *
+		 * \param x X position of the cell
+		 * \param y Y position of the cell
+		 *
+		 * \return Output returns the cost (infinity if the target can't be reached)
+		 */
+		float GetCost( const unsigned int &x, const unsigned int &y ) const;
+
+		/**
+		 * \brief Check if the target can be reached from a cell
+		 *
+		 * \param x X position of the cell
+		 * \param y Y position of the cell
+		 *
+		 * \return Output returns true if it can be reached
+		 */
+		bool IsReachable( const unsigned int &x, const unsigned int &y ) const;
+
+		/**
+		 * \brief Get the target
+		 *
+		 * \return Output returns the target cell
+		 */
+		const glm::uvec2 &GetTarget( ) const;
+
+		/**
+		 * \brief Get the size of the field
+		 *
+		 * \return Output returns the width and height in cells
+		 */
+		glm::uvec2 GetSize( ) const;
+
+	private:
+		friend class FlowFieldCache;
+
+		/**
+		 * \brief Cell waiting in the open list
+		 */
+		struct OpenCell
+		{
+			float cost;
+			uint32_t cell;
+		};
+
+		/**
+		 * \brief Scratch storage an integration writes to, one per thread that integrates
+		 */
+		struct IntegrationContext
+		{
+			std::vector<OpenCell> open; // Binary heap
+			std::vector<uint32_t> invalidated; // Cells whose path went through a cell that was blocked
+		};
+
+		/**
+		 * \brief Integrate the whole field from the target
+		 *
+		 * \param grid Passability to integrate over
+		 * \param context Scratch storage to use
+		 */
+		void Build( const NavigationGrid &grid, IntegrationContext &context );
+
+		/**
+		 * \brief Only integrate the cells affected by cells whose passability changed (the grid mustn't have been resized)
+		 *
+		 * Cells whose path went through a blocked cell are cleared, then the cells around them and around the changed cells are integrated again.
+		 *
+		 * \param grid Passability to integrate over
+		 * \param changedCells Cells whose passability changed
+		 * \param context Scratch storage to use
+		 */
+		void Repair( const NavigationGrid &grid, const std::vector<uint32_t> &changedCells, IntegrationContext &context );
+
+		/**
+		 * \brief Run Dijkstra from the cells in the open list, lowering the cost of every cell a cheaper path is found for
+		 */
+		void Integrate( const NavigationGrid &grid, IntegrationContext &context );
+
+		/**
+		 * \brief Add a cell to the open list
+		 */
+		void Open( IntegrationContext &context, const uint32_t &cell ) const;
+
+		/**
+		 * \brief Clear a cell's cost and direction and queue it so the cells stepping into it are cleared too
+		 */
+		void Invalidate( IntegrationContext &context, const uint32_t &cell );
+
+		/**
+		 * \brief Cell every direction leads to
+		 */
+		glm::uvec2 _target;
+
+		/**
+		 * \brief Size of the field in cells
+		 */
+		int _width, _height;
+
+		/**
+		 * \brief Cost to reach the target from each cell, row by row
+		 */
+		std::vector<float> _costs;
+
+		/**
+		 * \brief Direction index to step in from each cell, row by row
+		 */
+		std::vector<uint8_t> _directions;
+
+	};
+}
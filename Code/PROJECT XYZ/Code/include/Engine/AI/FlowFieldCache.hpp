@@ -0,0 +1,185 @@
+#pragma once
+
+#include "AI/FlowField.hpp"
+#include "Core/JobSystem.hpp"
+
+namespace Sonar
+{
+	/**
+	 * \brief Builds a FlowField per target over a map layer and keeps them up to date, so units sharing a destination share one field instead of searching a path each
+	 *
+	 * Fields are cached by target and the least recently used ones are dropped once there are more than the capacity.
+	 * When cells change through MapManager::SetValue, every cached field only integrates the cells around the change again instead of the whole map.
+	 * Fields being built or repaired are spread across the job system's threads, each field is integrated on one thread.
+	 * Get fields and update from the thread that changes the map, fields are changed in place while they're updated.
+	 */
+	class FlowFieldCache
+	{
+	public:
+		/**
+		 * \brief Shared field, a field dropped from the cache stays valid (but is no longer updated) while anything still holds it
+		 */
+		typedef std::shared_ptr<const FlowField> FlowFieldRef;
+
+		/**
+		 * \brief Class constructor, every cell value is passable until set otherwise
+		 *
+		 * \param map Map to integrate over (must outlive the cache)
+		 * \param jobs [OPTIONAL] Job system fields are integrated on (nullptr integrates them on the calling thread)
+		 * \param layer [OPTIONAL] Map layer to integrate over
+		 * \param capacity [OPTIONAL] Fields kept before the least recently used are dropped (0 for no limit)
+		 */
+		FlowFieldCache( MapManager *map, JobSystem *jobs = nullptr, const unsigned int &layer = 0, const unsigned int &capacity = DEFAULT_FLOW_FIELD_CACHE_CAPACITY );
+
+		/**
+		 * \brief Class destructor
+		 */
+		~FlowFieldCache( );
+
+		/**
+		 * \brief Set if cells with a value can be walked through (cached fields are repaired on the next update)
+		 *
+		 * \param value Cell value
+		 * \param isPassable Can the cells be walked through
+		 */
+		void SetPassable( const MapCell &value, const bool &isPassable );
+
+		/**
+		 * \brief Check if cells with a value can be walked through
+		 *
+		 * \param value Cell value
+		 *
+		 * \return Output returns true if they can be walked through
+		 */
+		bool IsPassable( const MapCell &value ) const;
+
+		/**
+		 * \brief Get the field leading to a target, building it if it isn't cached (updates the cached fields first)
+		 *
+		 * \param target Target cell
+		 *
+		 * \return Output returns the field
+		 */
+		FlowFieldRef GetField( const glm::uvec2 &target );
+
+		/**
+		 * \brief Get the fields leading to several targets, the ones that aren't cached are built in parallel (updates the cached fields first)
+		 *
+		 * \param targets Target cells
+		 * \param fields Filled with a field per target, in the same order
+		 */
+		void GetFields( const std::vector<glm::uvec2> &targets, std::vector<FlowFieldRef> &fields );
+
+		/**
+		 * \brief Bring the cached fields up to date with the map, call once a frame after changing the map (GetField and GetFields do it too)
+		 *
+		 * \return Output returns the amount of fields that were repaired or rebuilt
+		 */
+		unsigned int Update( );
+
+		/**
+		 * \brief Drop a target's field from the cache
+		 *
+		 * \param target Target cell
+		 *
+		 * \return Output returns true if the field was cached
+		 */
+		bool RemoveField( const glm::uvec2 &target );
+
+		/**
+		 * \brief Drop every field from the cache
+		 */
+		void Clear( );
+
+		/**
+		 * \brief Get the amount of cached fields
+		 *
+		 * \return Output returns the field count
+		 */
+		unsigned int GetFieldCount( ) const;
+
+		/**
+		 * \brief Set the amount of fields kept before the least recently used are dropped
+		 *
+		 * \param capacity Field count (0 for no limit)
+		 */
+		void SetCapacity( const unsigned int &capacity );
+
+		/**
+		 * \brief Get the amount of fields kept before the least recently used are dropped
+		 *
+		 * \return Output returns the field count (0 for no limit)
+		 */
+		unsigned int GetCapacity( ) const;
+
+	private:
+		/**
+		 * \brief Field in the cache
+		 */
+		struct CachedField
+		{
+			std::shared_ptr<FlowField> field;
+			unsigned long long lastUsed; // Use count when the field was last retrieved
+		};
+
+		/**
+		 * \brief Build or repair fields across the job system's threads
+		 *
+		 * \param fields Fields to integrate
+		 * \param isRepair Repair the fields from the changed cells instead of building them
+		 */
+		void Integrate( const std::vector<FlowField *> &fields, const bool &isRepair );
+
+		/**
+		 * \brief Drop the least recently used fields until the cache is within its capacity, fields used since the given use count are kept
+		 */
+		void Evict( const unsigned long long &keepSince );
+
+		/**
+		 * \brief Get a target's cache key
+		 */
+		static unsigned long long GetKey( const glm::uvec2 &target )
+		{ return ( static_cast<unsigned long long>( target.x ) << 32 ) | target.y; }
+
+		/**
+		 * \brief Job system fields are integrated on
+		 */
+		JobSystem *_jobs;
+
+		/**
+		 * \brief Passability of the map layer integrated over
+		 */
+		NavigationGrid _grid;
+
+		/**
+		 * \brief Cells whose passability changed in the last grid refresh
+		 */
+		std::vector<uint32_t> _changedCells;
+
+		/**
+		 * \brief Cached fields by target
+		 */
+		std::unordered_map<unsigned long long, CachedField> _fields;
+
+		/**
+		 * \brief Fields kept before the least recently used are dropped (0 for no limit)
+		 */
+		unsigned int _capacity;
+
+		/**
+		 * \brief Counts every field retrieval, fields are stamped with it to find the least recently used
+		 */
+		unsigned long long _useCount;
+
+		/**
+		 * \brief One integration context per thread that integrates
+		 */
+		std::vector<FlowField::IntegrationContext> _contexts;
+
+		/**
+		 * \brief Fields being integrated, kept so the storage is reused
+		 */
+		std::vector<FlowField *> _integrating;
+
+	};
+}
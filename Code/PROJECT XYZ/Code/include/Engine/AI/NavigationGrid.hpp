@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Managers/MapManager.hpp"
+
+namespace Sonar
+{
+	/**
+	 * \brief Which cells of a map layer can be walked through, kept as one byte per cell row by row so searches don't go through the map's chunks
+	 *
+	 * Passability is set per cell value, refreshing only rebuilds the chunks whose version changed.
+	 */
+	class NavigationGrid
+	{
+	public:
+		/**
+		 * \brief Class constructor, every cell value is passable until set otherwise
+		 *
+		 * \param map Map to read (must outlive the grid)
+		 * \param layer [OPTIONAL] Map layer to read
+		 */
+		NavigationGrid( MapManager *map, const unsigned int &layer = 0 );
+
+		/**
+		 * \brief Class destructor
+		 */
+		~NavigationGrid( );
+
+		/**
+		 * \brief Set if cells with a value can be walked through (applied on the next refresh)
+		 *
+		 * \param value Cell value
+		 * \param isPassable Can the cells be walked through
+		 */
+		void SetPassable( const MapCell &value, const bool &isPassable );
+
+		/**
+		 * \brief Check if cells with a value can be walked through
+		 *
+		 * \param value Cell value
+		 *
+		 * \return Output returns true if they can be walked through
+		 */
+		bool IsPassable( const MapCell &value ) const;
+
+		/**
+		 * \brief Bring the grid up to date with the map
+		 *
+		 * \param changedCells [OPTIONAL] Filled with the cells whose passability changed (left empty when the map was resized, since every cell did)
+		 *
+		 * \return Output returns true if the grid was resized
+		 */
+		bool Refresh( std::vector<uint32_t> *changedCells = nullptr );
+
+		/**
+		 * \brief Check if a cell can be walked through (positions outside the grid can't be)
+		 *
+		 * \param x X position
+		 * \param y Y position
+		 *
+		 * \return Output returns true if it can be walked through
+		 */
+		bool IsWalkable( const int &x, const int &y ) const
+		{ return x >= 0 && y >= 0 && x < _width && y < _height && 0 != _grid[static_cast<std::size_t>( y ) * _width + x]; }
+
+		/**
+		 * \brief Get the grid's width
+		 *
+		 * \return Output returns the width in cells
+		 */
+		int GetWidth( ) const
+		{ return _width; }
+
+		/**
+		 * \brief Get the grid's height
+		 *
+		 * \return Output returns the height in cells
+		 */
+		int GetHeight( ) const
+		{ return _height; }
+
+	private:
+		/**
+		 * \brief Map and layer read
+		 */
+		MapManager *_map;
+		unsigned int _layer;
+
+		/**
+		 * \brief Passability by cell value
+		 */
+		std::vector<uint8_t> _passable;
+
+		/**
+		 * \brief Passability of each cell, row by row
+		 */
+		std::vector<uint8_t> _grid;
+		int _width, _height;
+
+		/**
+		 * \brief Map chunk versions the grid was built from
+		 */
+		std::vector<unsigned long long> _chunkVersions;
+
+		/**
+		 * \brief Is the whole grid out of date (the passability changed)
+		 */
+		bool _isGridChanged;
+
+	};
+}
@@ -0,0 +1,257 @@
+#pragma once
+
+#include "AI/NavigationGrid.hpp"
+#include "Core/JobSystem.hpp"
+
+namespace Sonar
+{
+	/**
+	 * \brief Finds paths across a map layer with A* or Jump Point Search, moving to any of the 8 neighbouring cells (never cutting past a blocked corner)
+	 *
+	 * Which cell values can be walked through is set per value in the pathfinder's own NavigationGrid, which only refreshes the chunks whose version changed.
+	 * Every search reuses a search context (costs, parents and open list sized to the map) so searches don't allocate once the contexts have grown to the map.
+	 * Paths can be found straight away or requested in batches that are worked through on the job system's threads within a time budget each frame.
+	 */
+	class Pathfinder
+	{
+	public:
+		/**
+		 * \brief Search algorithm
+		 */
+		enum class ALGORITHM
+		{
+			A_STAR, // Expands every neighbour
+			JUMP_POINT_SEARCH // Skips along straight runs of open cells, much faster on open maps
+		};
+
+		/**
+		 * \brief Called by ProcessRequests once a requested path has been searched
+		 *
+		 * \param id Request ID
+		 * \param path Cells from the start to the goal (empty if there's no path)
+		 */
+		typedef std::function<void( const unsigned int &id, const std::vector<glm::uvec2> &path )> Callback;
+
+		/**
+		 * \brief Class constructor, every cell value is passable until set otherwise
+		 *
+		 * \param map Map to search (must outlive the pathfinder)
+		 * \param jobs [OPTIONAL] Job system requests are processed on (nullptr processes them on the calling thread)
+		 * \param layer [OPTIONAL] Map layer to search
+		 */
+		Pathfinder( MapManager *map, JobSystem *jobs = nullptr, const unsigned int &layer = 0 );
+
+		/**
+		 * \brief Class destructor
+		 */
+		~Pathfinder( );
+
+		/**
+		 * \brief Set if cells with a value can be walked through
+		 *
+		 * \param value Cell value
+		 * \param isPassable Can the cells be walked through
+		 */
+		void SetPassable( const MapCell &value, const bool &isPassable );
+
+		/**
+		 * \brief Check if cells with a value can be walked through
+		 *
+		 * \param value Cell value
+		 *
+		 * \return Output returns true if they can be walked through
+		 */
+		bool IsPassable( const MapCell &value ) const;
+
+		/**
+		 * \brief Find a path straight away on the calling thread
+		 *
+		 * \param start Start cell
+		 * \param goal Goal cell
+		 * \param path Filled with the cells from the start to the goal (cleared if there's no path, its capacity is reused)
+		 * \param algorithm [OPTIONAL] Search algorithm
+		 *
+		 * \return Output returns true if a path was found
+		 */
+		bool FindPath( const glm::uvec2 &start, const glm::uvec2 &goal, std::vector<glm::uvec2> &path, const ALGORITHM &algorithm = ALGORITHM::JUMP_POINT_SEARCH );
+
+		/**
+		 * \brief Queue a path to be found by ProcessRequests
+		 *
+		 * \param start Start cell
+		 * \param goal Goal cell
+		 * \param callback Called with the path
+		 * \param algorithm [OPTIONAL] Search algorithm
+		 *
+		 * \return Output returns the request ID
+		 */
+		unsigned int RequestPath( const glm::uvec2 &start, const glm::uvec2 &goal, const Callback &callback, const ALGORITHM &algorithm = ALGORITHM::JUMP_POINT_SEARCH );
+
+		/**
+		 * \brief Cancel a queued request, its callback won't be called
+		 *
+		 * \param id Request ID
+		 *
+		 * \return Output returns true if the request was still queued
+		 */
+		bool CancelRequest( const unsigned int &id );
+
+		/**
+		 * \brief Search queued requests in order across the job system's threads until the time budget runs out, then call their callbacks in order
+		 *
+		 * Call once a frame from the thread that changes the map, the map mustn't change while requests are processed.
+		 *
+		 * \param timeBudget [OPTIONAL] Milliseconds to spend searching, every thread searches at least one request if any are queued
+		 *
+		 * \return Output returns the amount of requests searched
+		 */
+		unsigned int ProcessRequests( const float &timeBudget = DEFAULT_PATHFINDER_TIME_BUDGET );
+
+		/**
+		 * \brief Get the amount of queued requests
+		 *
+		 * \return Output returns the request count
+		 */
+		unsigned int GetPendingCount( ) const;
+
+		/**
+		 * \brief Get the amount of cells expanded by the searches of the last FindPath or ProcessRequests call
+		 *
+		 * \return Output returns the expanded cell count
+		 */
+		unsigned long long GetExpandedCount( ) const;
+
+	private:
+		/**
+		 * \brief Queued path request
+		 */
+		struct Request
+		{
+			unsigned int id;
+			glm::uvec2 start;
+			glm::uvec2 goal;
+			ALGORITHM algorithm;
+			Callback callback;
+			std::vector<glm::uvec2> path; // Kept between requests so the storage is reused
+			bool isSearched;
+		};
+
+		/**
+		 * \brief Cell waiting in the open list
+		 */
+		struct OpenCell
+		{
+			float estimate; // Cost so far plus the heuristic
+			float cost; // Cost so far, a higher cost breaks ties since it's closer to the goal
+			uint32_t cell;
+		};
+
+		/**
+		 * \brief Everything a search writes to, one per thread that searches
+		 *
+		 * Cells are only valid for the search whose generation they were stamped with, so nothing has to be cleared between searches.
+		 */
+		struct SearchContext
+		{
+			std::vector<float> costs;
+			std::vector<uint32_t> parents;
+			std::vector<uint32_t> openGenerations; // Generation the cell was last reached in
+			std::vector<uint32_t> closedGenerations; // Generation the cell was last expanded in
+			std::vector<OpenCell> open; // Binary heap
+			std::vector<uint32_t> jumpPoints; // Cells a path goes through, goal first
+			uint32_t generation = 0;
+			unsigned long long expandedCount = 0;
+		};
+
+		/**
+		 * \brief Search for a path
+		 *
+		 * \param context Search context to use
+		 *
+		 * \return Output returns true if a path was found
+		 */
+		bool Search( SearchContext &context, const glm::uvec2 &start, const glm::uvec2 &goal, const ALGORITHM &algorithm, std::vector<glm::uvec2> &path ) const;
+
+		/**
+		 * \brief Expand a cell's neighbours for A*
+		 */
+		void ExpandNeighbours( SearchContext &context, const uint32_t &cell, const uint32_t &goal ) const;
+
+		/**
+		 * \brief Expand a cell's jump points for Jump Point Search
+		 */
+		void ExpandJumpPoints( SearchContext &context, const uint32_t &cell, const uint32_t &goal ) const;
+
+		/**
+		 * \brief Jump from a cell in a direction until reaching the goal, a cell with a forced neighbour or a blocked cell
+		 *
+		 * \param x X position of the first cell jumped to
+		 * \param y Y position of the first cell jumped to
+		 * \param directionX X direction (-1, 0 or 1)
+		 * \param directionY Y direction (-1, 0 or 1)
+		 * \param goalX X position of the goal
+		 * \param goalY Y position of the goal
+		 * \param jumpPoint Set to the cell jumped to
+		 *
+		 * \return Output returns true if a jump point was found
+		 */
+		bool Jump( int x, int y, const int &directionX, const int &directionY, const int &goalX, const int &goalY, uint32_t &jumpPoint ) const;
+
+		/**
+		 * \brief Jump in a straight line (one of the directions is 0), see Jump
+		 */
+		bool JumpStraight( int x, int y, const int &directionX, const int &directionY, const int &goalX, const int &goalY, uint32_t &jumpPoint ) const;
+
+		/**
+		 * \brief Open a cell if the new cost beats the cost it was reached with
+		 */
+		void Open( SearchContext &context, const uint32_t &cell, const uint32_t &parent, const float &cost, const uint32_t &goal ) const;
+
+		/**
+		 * \brief Octile distance between two cells
+		 */
+		float Heuristic( const uint32_t &cell, const uint32_t &goal ) const;
+
+		/**
+		 * \brief Check if a cell can be walked through (positions outside the map can't be)
+		 */
+		bool IsWalkable( const int &x, const int &y ) const
+		{ return _grid.IsWalkable( x, y ); }
+
+		/**
+		 * \brief Job system requests are processed on
+		 */
+		JobSystem *_jobs;
+
+		/**
+		 * \brief Passability of the map layer searched
+		 */
+		NavigationGrid _grid;
+
+		/**
+		 * \brief One search context per thread that processes requests, the first is also used by FindPath
+		 */
+		std::vector<SearchContext> _contexts;
+
+		/**
+		 * \brief Queued requests, oldest first
+		 */
+		std::deque<Request> _requests;
+
+		/**
+		 * \brief Finished requests kept so their paths' storage is reused
+		 */
+		std::vector<Request> _freeRequests;
+
+		/**
+		 * \brief Next request ID
+		 */
+		unsigned int _nextID;
+
+		/**
+		 * \brief Cells expanded by the last FindPath or ProcessRequests call
+		 */
+		unsigned long long _expandedCount;
+
+	};
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+namespace Sonar
+{
+	/**
+	 * \brief Counts global heap allocations (only when the engine is built with SONAR_COUNT_ALLOCATIONS defined, as it replaces the global operator new and delete)
+	 */
+	class AllocationCounter
+	{
+	public:
+		/**
+		 * \brief Check if allocations are being counted
+		 *
+		 * \return Output returns true if the engine was built with SONAR_COUNT_ALLOCATIONS
+		 */
+		static bool IsEnabled( );
+
+		/**
+		 * \brief Get the amount of global allocations since the program started
+		 *
+		 * \return Output returns the allocation count (0 if counting is disabled)
+		 */
+		static unsigned long long int GetAllocationCount( );
+
+		/**
+		 * \brief Get the amount of global deallocations since the program started
+		 *
+		 * \return Output returns the deallocation count (0 if counting is disabled)
+		 */
+		static unsigned long long int GetDeallocationCount( );
+
+		/**
+		 * \brief Get the amount of bytes allocated globally since the program started
+		 *
+		 * \return Output returns the byte count (0 if counting is disabled)
+		 */
+		static unsigned long long int GetAllocatedBytes( );
+
+	};
+}
@@ -119,7 +119,17 @@ namespace Sonar
         *
         * \return Output returns lower case value of a string
         */
-        std::string Debug::ToLower( std::string string );
+        std::string ToLower( std::string string );
+
+        /**
+        * \brief Compare two strings ignoring case (doesn't allocate, unlike comparing ToLower copies)
+        *
+        * \param first First string
+        * \param second Second string
+        *
+        * \return Output returns true if the strings match ignoring case
+        */
+        static bool IsEqualIgnoringCase( const std::string &first, const std::string &second );
         
     private:
         /**
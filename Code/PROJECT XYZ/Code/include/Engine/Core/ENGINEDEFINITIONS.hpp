@@ -191,3 +191,110 @@
 #define DEFAULT_MINIMAP_INTERNAL_MAP_HEIGHT DEFAULT_MINIMAP_BACKGROUND_HEIGHT
 #define DEFAULT_MINIMAP_OBJECT_RADIUS 2.0f
 #define DEFAULT_MINIMAP_OBJECT_COLOR Color::Red
+
+/**
+* \brief Default sprite batch properties
+*/
+#define DEFAULT_SPRITE_BATCH_ENABLED false
+#define DEFAULT_SPRITE_BATCH_SORT_MODE Sonar::SpriteBatch::SORT_MODE::DEFERRED
+
+/**
+* \brief Default texture atlas properties
+*/
+#define DEFAULT_TEXTURE_ATLAS_PAGE_SIZE 2048
+#define DEFAULT_TEXTURE_ATLAS_PADDING 2
+
+/**
+* \brief Default frame stats properties
+*/
+#define DEFAULT_FRAME_STATS_HISTORY_SIZE 240
+#define DEFAULT_FRAME_STATS_TARGET_FRAME_TIME ( 1000.0f / 60.0f )
+#define DEFAULT_FRAME_STATS_OVERLAY_VISIBLE false
+#define DEFAULT_FRAME_STATS_OVERLAY_CORNER Sonar::FrameStats::CORNER::TOP_RIGHT
+#define DEFAULT_FRAME_STATS_OVERLAY_MARGIN 10.0f
+#define DEFAULT_FRAME_STATS_OVERLAY_BACKGROUND_ALPHA 0.35f
+#define DEFAULT_FRAME_STATS_OVERLAY_GRAPH_WIDTH 200.0f
+#define DEFAULT_FRAME_STATS_OVERLAY_GRAPH_HEIGHT 40.0f
+
+/**
+* \brief Default game loop properties
+*/
+#define DEFAULT_GAME_MULTITHREADED false
+
+/**
+* \brief Default job system properties
+*/
+#define DEFAULT_JOB_SYSTEM_THREAD_COUNT 0
+#define DEFAULT_JOB_SYSTEM_GRAIN_SIZE 64
+
+/**
+* \brief Default parallax properties
+*/
+#define DEFAULT_PARALLAX_UPDATE_GRAIN_SIZE 8
+
+/**
+* \brief Default loading state properties
+*/
+#define DEFAULT_LOADING_STATE_SPINNER_SIZE 48.0f
+#define DEFAULT_LOADING_STATE_SPINNER_COLOR Sonar::Color::Black
+#define DEFAULT_LOADING_STATE_SPINNER_SPEED 360.0f
+#define DEFAULT_LOADING_STATE_PROGRESS_BAR_WIDTH 240.0f
+#define DEFAULT_LOADING_STATE_PROGRESS_BAR_HEIGHT 6.0f
+
+/**
+* \brief Default frame allocator properties
+*/
+#define DEFAULT_FRAME_ALLOCATOR_CAPACITY ( 1024 * 1024 )
+
+/**
+* \brief Default profiler properties
+*/
+#define DEFAULT_PROFILER_EVENT_RESERVE 65536
+#define DEFAULT_PROFILER_CAPTURE_FRAMES 120
+#define DEFAULT_PROFILER_CAPTURE_KEY Sonar::Keyboard::Key::F9
+#define DEFAULT_PROFILER_TRACE_FILEPATH "sonar_trace.json"
+
+/**
+* \brief Default input recorder properties
+*/
+#define DEFAULT_INPUT_RECORDER_FLUSH_SIZE ( 64 * 1024 )
+
+/**
+* \brief Default asset manager properties
+*/
+#define DEFAULT_ASSET_MANAGER_SOUND_VOICES 32
+#define DEFAULT_ASSET_MANAGER_UPLOAD_TIME_BUDGET 2.0f // Milliseconds per frame
+#define DEFAULT_ASSET_MANAGER_TEXTURE_BUDGET 0 // Bytes (0 for no budget)
+#define DEFAULT_ASSET_MANAGER_FONT_BUDGET 0
+#define DEFAULT_ASSET_MANAGER_SOUND_BUDGET 0
+#define DEFAULT_ASSET_MANAGER_RESIDENCY_WINDOW_VISIBLE false
+
+/**
+* \brief Default asset pack properties
+*/
+#define DEFAULT_ASSET_PACK_FILEPATH "Resources.pak"
+
+/**
+* \brief Default leaderboard properties
+*/
+#define DEFAULT_LEADERBOARD_PAGE_SIZE 10
+#define DEFAULT_LEADERBOARD_COMPACTION_MINIMUM 4096 // Records in the file before it's worth compacting
+#define DEFAULT_LEADERBOARD_COMPACTION_RATIO 2 // Compact once the file holds this many records per entry
+
+/**
+* \brief Default pathfinder properties
+*/
+#define DEFAULT_PATHFINDER_TIME_BUDGET 2.0f // Milliseconds per frame
+
+/**
+* \brief Default flow field cache properties
+*/
+#define DEFAULT_FLOW_FIELD_CACHE_CAPACITY 16 // Fields kept before the least recently used are dropped
+
+/**
+* \brief Default collision world properties
+*/
+#define DEFAULT_COLLISION_WORLD_CELL_SIZE 64.0f
+#define DEFAULT_COLLISION_WORLD_LAYER 0x00000001
+#define DEFAULT_COLLISION_WORLD_MASK 0xFFFFFFFF
+#define DEFAULT_COLLISION_WORLD_QUERY_GRAIN_SIZE 16 // Queries per job
\ No newline at end of file
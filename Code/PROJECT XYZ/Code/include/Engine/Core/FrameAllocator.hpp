@@ -0,0 +1,126 @@
+#pragma once
+
+namespace Sonar
+{
+	/**
+	 * \brief Vector whose memory comes from a memory resource (pass &data->frameAllocator for frame scoped containers)
+	 */
+	template<typename T>
+	using FrameVector = std::pmr::vector<T>;
+
+	/**
+	 * \brief String whose memory comes from a memory resource (pass &data->frameAllocator for frame scoped strings)
+	 */
+	typedef std::pmr::string FrameString;
+
+	class FrameAllocator : public std::pmr::memory_resource
+	{
+	public:
+		/**
+		 * \brief Class constructor, the buffer is allocated once here
+		 *
+		 * \param capacity Size of the buffer in bytes
+		 */
+		FrameAllocator( const std::size_t &capacity = DEFAULT_FRAME_ALLOCATOR_CAPACITY );
+
+		/**
+		 * \brief Class destructor
+		 */
+		~FrameAllocator( );
+
+		/**
+		 * \brief Free everything allocated this frame by moving back to the start of the buffer (run at the start of each frame in Game.cpp)
+		 */
+		void Reset( );
+
+		/**
+		 * \brief Get the size of the buffer
+		 *
+		 * \return Output returns the capacity in bytes
+		 */
+		std::size_t GetCapacity( ) const;
+
+		/**
+		 * \brief Get the amount of the buffer used this frame
+		 *
+		 * \return Output returns the used bytes
+		 */
+		std::size_t GetUsedBytes( ) const;
+
+		/**
+		 * \brief Get the most of the buffer used in any frame
+		 *
+		 * \return Output returns the peak used bytes
+		 */
+		std::size_t GetPeakBytes( ) const;
+
+		/**
+		 * \brief Get the amount of allocations made this frame
+		 *
+		 * \return Output returns the allocation count
+		 */
+		unsigned int GetAllocationCount( ) const;
+
+		/**
+		 * \brief Get the amount of allocations this frame that didn't fit in the buffer and went to the heap
+		 *
+		 * \return Output returns the overflow count (should stay 0, raise the capacity otherwise)
+		 */
+		unsigned int GetOverflowCount( ) const;
+
+	private:
+		/**
+		 * \brief Bump the offset forward, falling back to the heap when the buffer is full
+		 *
+		 * \param bytes Size of the allocation
+		 * \param alignment Alignment of the allocation
+		 *
+		 * \return Output returns the memory
+		 */
+		void *do_allocate( std::size_t bytes, std::size_t alignment ) override;
+
+		/**
+		 * \brief Memory in the buffer is only freed by Reset, heap fallbacks are freed straight away
+		 *
+		 * \param pointer Memory to free
+		 * \param bytes Size of the allocation
+		 * \param alignment Alignment of the allocation
+		 */
+		void do_deallocate( void *pointer, std::size_t bytes, std::size_t alignment ) override;
+
+		/**
+		 * \brief Check if two memory resources are the same
+		 *
+		 * \param other Other memory resource
+		 *
+		 * \return Output returns true if they're the same object
+		 */
+		bool do_is_equal( const std::pmr::memory_resource &other ) const noexcept override;
+
+		/**
+		 * \brief Buffer memory
+		 */
+		std::unique_ptr<std::byte[ ]> _buffer;
+
+		/**
+		 * \brief Buffer size
+		 */
+		std::size_t _capacity;
+
+		/**
+		 * \brief Offset of the next free byte
+		 */
+		std::size_t _offset;
+
+		/**
+		 * \brief Most bytes used in a frame
+		 */
+		std::size_t _peakBytes;
+
+		/**
+		 * \brief Counters for the current frame
+		 */
+		unsigned int _allocationCount, _overflowCount;
+
+	};
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+namespace Sonar
+{
+	class FrameStats
+	{
+	public:
+		/**
+		 * \brief Statistics recorded for a single frame (times in milliseconds)
+		 */
+		struct Frame
+		{
+			float frameTime; // Time between the start of this frame and the previous one
+			float updateTime; // Time spent polling input and updating the active state
+			float drawTime; // Time spent drawing the active state and flushing the sprite batch
+			float imGuiTime; // Time spent updating and rendering ImGui
+			unsigned int fixedSteps; // Amount of fixed updates run this frame
+			unsigned int drawCalls; // Draw calls issued to the window
+			unsigned int vertexCount; // Vertices submitted with the draw calls
+			unsigned int allocations; // Global heap allocations made (only counted with SONAR_COUNT_ALLOCATIONS)
+			unsigned int frameAllocatorBytes; // Bytes taken from the frame allocator
+		};
+
+		/**
+		 * \brief Screen corner the overlay is anchored to
+		 */
+		enum class CORNER
+		{
+			TOP_LEFT,
+			TOP_RIGHT,
+			BOTTOM_LEFT,
+			BOTTOM_RIGHT
+		};
+
+		/**
+		 * \brief Class constructor
+		 */
+		FrameStats( );
+
+		/**
+		 * \brief Class destructor
+		 */
+		~FrameStats( );
+
+		/**
+		 * \brief Get the frame currently being recorded (filled in by Game.cpp during the frame)
+		 *
+		 * \return Output returns the current frame
+		 */
+		Frame &GetCurrentFrame( );
+
+		/**
+		 * \brief Add a draw call to the current frame
+		 *
+		 * \param vertexCount Amount of vertices drawn by the call
+		 */
+		void AddDrawCall( const unsigned int &vertexCount );
+
+		/**
+		 * \brief Store the current frame in the history and start a new one (run at the end of each frame in Game.cpp)
+		 */
+		void EndFrame( );
+
+		/**
+		 * \brief Get a completed frame from the history
+		 *
+		 * \param framesAgo How many frames back to go (0 is the last completed frame)
+		 *
+		 * \return Output returns the frame
+		 */
+		const Frame &GetFrame( const unsigned int &framesAgo = 0 ) const;
+
+		/**
+		 * \brief Get the amount of frames stored in the history
+		 *
+		 * \return Output returns the frame count (never more than DEFAULT_FRAME_STATS_HISTORY_SIZE)
+		 */
+		unsigned int GetFrameCount( ) const;
+
+		/**
+		 * \brief Get the amount of frames completed since the game started
+		 *
+		 * \return Output returns the total frame count
+		 */
+		unsigned long long int GetTotalFrameCount( ) const;
+
+		/**
+		 * \brief Get the average frame time over the history
+		 *
+		 * \return Output returns the average frame time in milliseconds
+		 */
+		float GetAverageFrameTime( ) const;
+
+		/**
+		 * \brief Get the frames per second averaged over the history
+		 *
+		 * \return Output returns the frames per second
+		 */
+		float GetFPS( ) const;
+
+		/**
+		 * \brief Show the performance overlay
+		 */
+		void ShowOverlay( );
+
+		/**
+		 * \brief Hide the performance overlay
+		 */
+		void HideOverlay( );
+
+		/**
+		 * \brief Check if the performance overlay is visible
+		 *
+		 * \return Output returns true if the overlay is visible and false if it isn't
+		 */
+		bool IsOverlayVisible( ) const;
+
+		/**
+		 * \brief Set the corner the overlay is anchored to
+		 *
+		 * \param corner Screen corner
+		 */
+		void SetOverlayCorner( const CORNER &corner );
+
+		/**
+		 * \brief Get the corner the overlay is anchored to
+		 *
+		 * \return Output returns the screen corner
+		 */
+		CORNER GetOverlayCorner( ) const;
+
+		/**
+		 * \brief Draw the performance overlay using ImGui if it's visible, its button captures a profiler trace the same as DEFAULT_PROFILER_CAPTURE_KEY (run between ImGui::SFML::Update and ImGui::SFML::Render)
+		 */
+		void DrawOverlay( ) const;
+
+	private:
+		/**
+		 * \brief Completed frames, overwritten oldest first once full
+		 */
+		std::array<Frame, DEFAULT_FRAME_STATS_HISTORY_SIZE> _frames;
+
+		/**
+		 * \brief Frame being recorded
+		 */
+		Frame _currentFrame;
+
+		/**
+		 * \brief Index the next completed frame is written to
+		 */
+		unsigned int _nextIndex;
+
+		/**
+		 * \brief Amount of frames stored
+		 */
+		unsigned int _frameCount;
+
+		/**
+		 * \brief Amount of frames completed since the game started
+		 */
+		unsigned long long int _totalFrameCount;
+
+		/**
+		 * \brief Sum of the frame times in the history (kept up to date so averaging doesn't loop)
+		 */
+		double _frameTimeSum;
+
+		/**
+		 * \brief Is the overlay visible
+		 */
+		bool _isOverlayVisible;
+
+		/**
+		 * \brief Overlay corner
+		 */
+		CORNER _overlayCorner;
+
+	};
+}
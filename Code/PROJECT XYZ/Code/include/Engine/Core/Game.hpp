@@ -1,7 +1,13 @@
 #pragma once
 
+#include "Core/FrameAllocator.hpp"
+#include "Core/FrameStats.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/SnapshotBuffer.hpp"
 #include "Core/StateMachine.hpp"
 #include "Core/Window.hpp"
+#include "Graphics/SpriteBatch.hpp"
+#include "Input/InputRecorder.hpp"
 #include "Managers/AssetManager.hpp"
 
 namespace Sonar
@@ -13,7 +19,13 @@ namespace Sonar
 	{
 		StateMachine machine; // State machine to handle the states
 		Window window; // Game window
-		AssetManager assets; // Asset manager
+		AssetManager assets{ &jobs }; // Asset manager (decodes asynchronous loads on the job system)
+		SpriteBatch spriteBatch; // Sprite batch renderer
+		FrameStats frameStats; // Per frame performance statistics
+		SnapshotBuffer snapshots; // Transforms published by Update and blended in Draw
+		JobSystem jobs; // Work-stealing job scheduler
+		FrameAllocator frameAllocator; // Linear allocator for frame scoped memory (reset at the start of every frame, draw thread only)
+		InputRecorder inputRecorder; // Records the input delivered each fixed step and replays it
         Debug *debug; // Debugger
         Color backgroundColor = Color::White;
 	};
@@ -32,8 +44,11 @@ namespace Sonar
          * \param width Game window width
          * \param height Game window height
          * \param title Game window title
+         * \param isMultithreaded Run the fixed step updates on their own thread while this thread draws (State::Update and State::Draw then run at the same time, so Draw should only read the transforms published to GameData::snapshots)
+         * \param recordFilepath [OPTIONAL] Input log the session's input is recorded to (empty to not record)
+         * \param replayFilepath [OPTIONAL] Input log replayed from the first step instead of live input (empty to not replay, takes priority over recording)
         */
-		Game( const int &width, const int &height, const std::string &title );
+		Game( const int &width, const int &height, const std::string &title, const bool &isMultithreaded = DEFAULT_GAME_MULTITHREADED, const std::string &recordFilepath = "", const std::string &replayFilepath = "" );
                         
 	private:
         /**
@@ -61,7 +76,51 @@ namespace Sonar
         */
 		void Run( );
 
-        unsigned long long int frames = 0;
+        /**
+         * \brief Run the game with the updates on a simulation thread and the drawing on this thread
+        */
+		void RunMultithreaded( );
+
+        /**
+         * \brief Fixed step update loop run by the simulation thread
+        */
+		void RunSimulation( );
+
+        /**
+         * \brief Are updates run on their own thread
+        */
+		bool _isMultithreaded;
+
+        /**
+         * \brief Simulation thread (multithreaded mode only)
+        */
+		std::thread _simulationThread;
+
+        /**
+         * \brief Keeps the simulation thread running
+        */
+		std::atomic<bool> _isSimulationRunning;
+
+        /**
+         * \brief Events polled by the window waiting to be passed to the simulation thread
+        */
+		std::vector<Event> _eventQueue;
+
+        /**
+         * \brief Guards the event queue
+        */
+		std::mutex _eventMutex;
+
+        /**
+         * \brief Held by the simulation thread for each whole fixed step and by the render thread while it draws or uses the asset manager
+        */
+		std::mutex _stateMutex;
+
+        /**
+         * \brief Fixed steps and update time (microseconds) from the simulation thread not yet added to the frame stats
+        */
+		std::atomic<unsigned int> _pendingFixedSteps;
+		std::atomic<long long> _pendingUpdateTime;
         
 	};
 }
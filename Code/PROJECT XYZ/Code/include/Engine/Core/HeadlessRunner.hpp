@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Core/Game.hpp"
+
+namespace Sonar
+{
+	class Event;
+
+	class HeadlessRunner
+	{
+	public:
+		/**
+		 * \brief Results of a headless run
+		 */
+		struct Report
+		{
+			unsigned long long int steps; // Fixed steps simulated
+			unsigned long long int events; // Events passed to PollInput
+			float simulatedTime; // Game time simulated in seconds (steps * dt)
+			float realTime; // Wall clock time the run took in seconds
+			float stepsPerSecond; // Fixed steps simulated per wall clock second
+		};
+
+		/**
+		 * \brief Function that generates synthetic events, called every step until it returns false
+		 *
+		 * \param step Index of the step being simulated
+		 * \param event Event to fill in
+		 *
+		 * \return Output returns true if an event was generated
+		 */
+		typedef std::function<bool( const unsigned long long int &step, Event &event )> EventGenerator;
+
+		/**
+		 * \brief Class constructor, the game data's window is never opened so no display is required
+		 *
+		 * \param dt Fixed time step (matches Game.hpp by default)
+		 */
+		HeadlessRunner( const float &dt = 1.0f / 60.0f );
+
+		/**
+		 * \brief Class destructor
+		 */
+		~HeadlessRunner( );
+
+		/**
+		 * \brief Get the game data states should be constructed with
+		 *
+		 * \return Output returns the game data
+		 */
+		GameDataRef GetGameData( ) const;
+
+		/**
+		 * \brief Add a state to the state machine (processed at the start of the next step)
+		 *
+		 * \param newState State to add
+		 * \param isReplacing is the state being replaced or added (replaced by default)
+		 */
+		void AddState( StateRef newState, const bool &isReplacing = true );
+
+		/**
+		 * \brief Queue an event to be passed to the active state's PollInput before a step's update
+		 *
+		 * \param step Index of the step (counted from the start of the runner)
+		 * \param event Event to pass
+		 */
+		void QueueEvent( const unsigned long long int &step, const Event &event );
+
+		/**
+		 * \brief Set a function that generates synthetic events every step
+		 *
+		 * \param generator Event generator (pass nullptr to remove it)
+		 */
+		void SetEventGenerator( const EventGenerator &generator );
+
+		/**
+		 * \brief Step the state machine as fast as possible without drawing
+		 *
+		 * \param steps Amount of fixed steps to simulate
+		 *
+		 * \return Output returns the results of the run
+		 */
+		Report Run( const unsigned long long int &steps );
+
+		/**
+		 * \brief Replay a log written by InputRecorder from its first step through to its last
+		 *
+		 * \param filepath Input log to replay
+		 *
+		 * \return Output returns the results of the run (no steps if the log couldn't be loaded)
+		 */
+		Report RunReplay( const std::string &filepath );
+
+		/**
+		 * \brief Stop the current run after the step being simulated (a Closed event does the same)
+		 */
+		void Stop( );
+
+		/**
+		 * \brief Get the amount of steps simulated since the runner was created
+		 *
+		 * \return Output returns the step index
+		 */
+		unsigned long long int GetCurrentStep( ) const;
+
+		/**
+		 * \brief Log a report through the debugger
+		 *
+		 * \param report Report to log
+		 */
+		void LogReport( const Report &report ) const;
+
+	private:
+		/**
+		 * \brief Fixed time step
+		 */
+		float _dt;
+
+		/**
+		 * \brief Game data for the states
+		 */
+		GameDataRef _data;
+
+		/**
+		 * \brief Queued events ordered by step
+		 */
+		std::deque<std::pair<unsigned long long int, Event>> _events;
+
+		/**
+		 * \brief Synthetic event generator
+		 */
+		EventGenerator _eventGenerator;
+
+		/**
+		 * \brief Steps simulated since the runner was created
+		 */
+		unsigned long long int _currentStep;
+
+		/**
+		 * \brief Is a run in progress
+		 */
+		bool _isRunning;
+
+		/**
+		 * \brief Wall clock for measuring runs
+		 */
+		Clock _clock;
+
+	};
+}
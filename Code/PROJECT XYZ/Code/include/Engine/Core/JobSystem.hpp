@@ -0,0 +1,203 @@
+#pragma once
+
+namespace Sonar
+{
+	class JobSystem
+	{
+	public:
+		/**
+		 * \brief Unit of work, jobs only run once all their dependencies have finished
+		 */
+		class Job
+		{
+		public:
+			/**
+			 * \brief Check if the job has finished running
+			 *
+			 * \return Output returns true if the job has finished
+			 */
+			bool IsFinished( ) const { return _isFinished; }
+
+		private:
+			friend class JobSystem;
+
+			/**
+			 * \brief Work to run
+			 */
+			std::function<void( )> _function;
+
+			/**
+			 * \brief Dependencies still to finish plus one until the job is submitted
+			 */
+			std::atomic<int> _pendingDependencies;
+
+			/**
+			 * \brief Jobs waiting on this one
+			 */
+			std::vector<std::shared_ptr<Job>> _dependents;
+
+			/**
+			 * \brief Has the job finished
+			 */
+			std::atomic<bool> _isFinished;
+
+			/**
+			 * \brief Guards the dependents and finishing
+			 */
+			std::mutex _mutex;
+
+		};
+
+		/**
+		 * \brief Shared pointer for jobs
+		 */
+		typedef std::shared_ptr<Job> JobRef;
+
+		/**
+		 * \brief Class constructor
+		 *
+		 * \param threadCount Amount of worker threads (0 uses one per core minus the calling thread)
+		 */
+		JobSystem( const unsigned int &threadCount = DEFAULT_JOB_SYSTEM_THREAD_COUNT );
+
+		/**
+		 * \brief Class destructor, stops and joins the worker threads
+		 */
+		~JobSystem( );
+
+		/**
+		 * \brief Create a job without scheduling it so dependencies can be added first
+		 *
+		 * \param function Work to run
+		 *
+		 * \return Output returns the job
+		 */
+		JobRef CreateJob( const std::function<void( )> &function );
+
+		/**
+		 * \brief Make a job wait for another job to finish (add before submitting the job)
+		 *
+		 * \param job Job that waits
+		 * \param dependency Job that has to finish first
+		 */
+		void AddDependency( const JobRef &job, const JobRef &dependency );
+
+		/**
+		 * \brief Submit a created job, it's queued as soon as its dependencies have finished
+		 *
+		 * \param job Job to submit
+		 */
+		void Submit( const JobRef &job );
+
+		/**
+		 * \brief Create and submit a job
+		 *
+		 * \param function Work to run
+		 *
+		 * \return Output returns the job
+		 */
+		JobRef Schedule( const std::function<void( )> &function );
+
+		/**
+		 * \brief Wait for a job to finish, running queued jobs on the calling thread instead of blocking
+		 *
+		 * \param job Job to wait for
+		 */
+		void Wait( const JobRef &job );
+
+		/**
+		 * \brief Wait for several jobs to finish, running queued jobs on the calling thread instead of blocking
+		 *
+		 * \param jobs Jobs to wait for
+		 */
+		void Wait( const std::vector<JobRef> &jobs );
+
+		/**
+		 * \brief Split a loop into ranges run across the workers and the calling thread, returns once every range has run
+		 *
+		 * \param count Amount of iterations
+		 * \param function Function run for each range of iterations [begin, end)
+		 * \param grainSize Minimum iterations per range (loops no larger than this run on the calling thread)
+		 */
+		void ParallelFor( const unsigned int &count, const std::function<void( const unsigned int &begin, const unsigned int &end )> &function, const unsigned int &grainSize = DEFAULT_JOB_SYSTEM_GRAIN_SIZE );
+
+		/**
+		 * \brief Get the amount of worker threads
+		 *
+		 * \return Output returns the worker thread count
+		 */
+		unsigned int GetThreadCount( ) const;
+
+	private:
+		/**
+		 * \brief Double ended queue of jobs, the owner works from the back and thieves steal from the front
+		 */
+		struct WorkQueue
+		{
+			std::deque<JobRef> jobs;
+			std::mutex mutex;
+		};
+
+		/**
+		 * \brief Worker thread loop
+		 *
+		 * \param index Index of the worker's queue
+		 */
+		void RunWorker( const unsigned int &index );
+
+		/**
+		 * \brief Run one queued job, the calling thread's own queue first and then stealing from the others
+		 *
+		 * \return Output returns true if a job was run
+		 */
+		bool RunQueuedJob( );
+
+		/**
+		 * \brief Queue a job that's ready to run on the calling thread's queue
+		 *
+		 * \param job Job to queue
+		 */
+		void Enqueue( const JobRef &job );
+
+		/**
+		 * \brief Mark a job as finished and release the jobs waiting on it
+		 *
+		 * \param job Job that has run
+		 */
+		void Finish( const JobRef &job );
+
+		/**
+		 * \brief Get the queue index of the calling thread (threads that aren't workers share the last queue)
+		 *
+		 * \return Output returns the queue index
+		 */
+		unsigned int GetQueueIndex( ) const;
+
+		/**
+		 * \brief One queue per worker plus one for every other thread
+		 */
+		std::vector<std::unique_ptr<WorkQueue>> _queues;
+
+		/**
+		 * \brief Worker threads
+		 */
+		std::vector<std::thread> _threads;
+
+		/**
+		 * \brief Amount of jobs waiting in the queues
+		 */
+		std::atomic<int> _queuedJobCount;
+
+		/**
+		 * \brief Keeps the workers running
+		 */
+		std::atomic<bool> _isRunning;
+
+		/**
+		 * \brief Wakes sleeping workers when jobs are queued
+		 */
+		std::condition_variable _wakeCondition;
+		std::mutex _wakeMutex;
+
+	};
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Core/Game.hpp"
+#include "Core/State.hpp"
+
+namespace Sonar
+{
+	class Rectangle;
+
+	class LoadingState : public State
+	{
+	public:
+		/**
+		 * \brief Class constructor
+		 *
+		 * \param data Game data object
+		 */
+		LoadingState( GameDataRef data );
+
+		/**
+		 * \brief Class destructor
+		 */
+		~LoadingState( );
+
+		/**
+		 * \brief Initialize the spinner
+		 */
+		void Init( );
+
+		/**
+		 * \brief Poll the input (the loading state ignores input)
+		 *
+		 * \param dt Delta time (difference between frames)
+		 * \param event Event to poll
+		 */
+		void PollInput( const float &dt, Event &event );
+
+		/**
+		 * \brief Spin the spinner
+		 *
+		 * \param dt Delta time (difference between frames)
+		 */
+		void Update( const float &dt );
+
+		/**
+		 * \brief Draw the spinner and the progress of any asynchronous asset loads
+		 *
+		 * \param dt Delta time (difference between frames)
+		 */
+		void Draw( const float &dt );
+
+	private:
+		/**
+		 * \brief Game data object
+		 */
+		GameDataRef _data;
+
+		/**
+		 * \brief Spinning square drawn in the middle of the window (a shape so nothing has to be loaded from disk)
+		 */
+		Rectangle *_spinner;
+
+		/**
+		 * \brief Bar under the spinner filled with the fraction of asynchronous asset loads completed
+		 */
+		Rectangle *_progressBar;
+
+	};
+}
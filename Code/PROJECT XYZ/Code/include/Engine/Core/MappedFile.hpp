@@ -0,0 +1,76 @@
+#pragma once
+
+namespace Sonar
+{
+	/**
+	 * \brief Read only memory mapping of a whole file, pages are read from disk as they're touched instead of the file being copied to the heap
+	 */
+	class MappedFile
+	{
+	public:
+		/**
+		 * \brief Class constructor
+		 */
+		MappedFile( );
+
+		/**
+		 * \brief Class destructor, unmaps the file
+		 */
+		~MappedFile( );
+
+		MappedFile( const MappedFile & ) = delete;
+		MappedFile &operator =( const MappedFile & ) = delete;
+
+		/**
+		 * \brief Map a file (any file already mapped is unmapped first)
+		 *
+		 * \param filepath File to map
+		 *
+		 * \return Output returns true if the file was mapped (an empty file opens with no data)
+		 */
+		bool Open( const std::string &filepath );
+
+		/**
+		 * \brief Unmap the file, pointers into it stop being valid
+		 */
+		void Close( );
+
+		/**
+		 * \brief Check if a file is mapped
+		 *
+		 * \return Output returns true if a file is open
+		 */
+		bool IsOpen( ) const;
+
+		/**
+		 * \brief Get the mapped bytes
+		 *
+		 * \return Output returns the start of the file (nullptr if it's empty or not open)
+		 */
+		const char *GetData( ) const;
+
+		/**
+		 * \brief Get the size of the mapped file
+		 *
+		 * \return Output returns the size in bytes
+		 */
+		std::size_t GetSize( ) const;
+
+	private:
+		/**
+		 * \brief Mapped bytes
+		 */
+		const char *_data;
+
+		/**
+		 * \brief Mapped size
+		 */
+		std::size_t _size;
+
+		/**
+		 * \brief Is a file open
+		 */
+		bool _isOpen;
+
+	};
+}
@@ -0,0 +1,201 @@
+#pragma once
+
+/**
+ * \brief Profile the rest of the enclosing scope under a name (compiled out when SONAR_DISABLE_PROFILER is defined)
+ */
+#define SONAR_PROFILE_CONCAT_INNER( a, b ) a##b
+#define SONAR_PROFILE_CONCAT( a, b ) SONAR_PROFILE_CONCAT_INNER( a, b )
+
+#ifdef SONAR_DISABLE_PROFILER
+	#define SONAR_PROFILE_SCOPE( name )
+#else
+	#define SONAR_PROFILE_SCOPE( name ) Sonar::ProfileScope SONAR_PROFILE_CONCAT( profileScope, __LINE__ )( name )
+#endif
+
+/**
+ * \brief Profile the rest of the enclosing function under its name
+ */
+#define SONAR_PROFILE_FUNCTION( ) SONAR_PROFILE_SCOPE( __FUNCTION__ )
+
+namespace Sonar
+{
+	class Profiler
+	{
+	public:
+		/**
+		 * \brief Get the profiler instance (shared by every thread)
+		 *
+		 * \return Output returns the profiler
+		 */
+		static Profiler *getInstance( );
+
+		/**
+		 * \brief Clear the previous capture and start recording scopes
+		 */
+		void BeginCapture( );
+
+		/**
+		 * \brief Start recording scopes for a set number of frames, the capture ends by itself
+		 *
+		 * \param frameCount Amount of frames to record
+		 * \param filepath [OPTIONAL] File the capture is written to as a Chrome trace once it ends (empty to only keep it in memory)
+		 */
+		void CaptureFrames( const unsigned int &frameCount, const std::string &filepath = "" );
+
+		/**
+		 * \brief Get the amount of frames left in a capture started with CaptureFrames
+		 *
+		 * \return Output returns the frame count (0 if the capture isn't limited to a number of frames)
+		 */
+		unsigned int GetFramesLeft( ) const;
+
+		/**
+		 * \brief Stop recording scopes
+		 */
+		void EndCapture( );
+
+		/**
+		 * \brief Check if scopes are being recorded
+		 *
+		 * \return Output returns true if a capture is running
+		 */
+		bool IsCapturing( ) const;
+
+		/**
+		 * \brief Mark the end of a frame, ends a capture started with CaptureFrames once enough frames are recorded (run at the end of each frame in Game.cpp)
+		 */
+		void EndFrame( );
+
+		/**
+		 * \brief Name the calling thread in the trace
+		 *
+		 * \param name Thread name
+		 */
+		void SetThreadName( const std::string &name );
+
+		/**
+		 * \brief Record a finished scope (used by ProfileScope)
+		 *
+		 * \param name Scope name, must outlive the capture (string literals)
+		 * \param start Start time in microseconds
+		 * \param end End time in microseconds
+		 */
+		void AddEvent( const char *name, const long long &start, const long long &end );
+
+		/**
+		 * \brief Get the current profiler time
+		 *
+		 * \return Output returns the time in microseconds
+		 */
+		long long GetTime( ) const;
+
+		/**
+		 * \brief Get the amount of scopes recorded in the current or last capture
+		 *
+		 * \return Output returns the event count
+		 */
+		unsigned int GetEventCount( );
+
+		/**
+		 * \brief Write the current or last capture as Chrome trace_event JSON (open in chrome://tracing or Perfetto)
+		 *
+		 * \param filepath File to write
+		 *
+		 * \return Output returns true if the file was written
+		 */
+		bool WriteChromeTrace( const std::string &filepath );
+
+	private:
+		/**
+		 * \brief Class constructor
+		 */
+		Profiler( );
+
+		/**
+		 * \brief Recorded scope
+		 */
+		struct Event
+		{
+			const char *name;
+			long long start;
+			long long duration;
+		};
+
+		/**
+		 * \brief Events recorded by one thread (threads only lock their own buffer while recording)
+		 */
+		struct ThreadBuffer
+		{
+			std::vector<Event> events;
+			std::string name;
+			unsigned int id;
+			std::mutex mutex;
+		};
+
+		/**
+		 * \brief Get the calling thread's buffer, creating it on first use
+		 *
+		 * \return Output returns the thread buffer
+		 */
+		ThreadBuffer &GetThreadBuffer( );
+
+		/**
+		 * \brief Every thread's buffer
+		 */
+		std::vector<std::unique_ptr<ThreadBuffer>> _threadBuffers;
+
+		/**
+		 * \brief Guards the list of thread buffers
+		 */
+		std::mutex _threadBuffersMutex;
+
+		/**
+		 * \brief Is a capture running
+		 */
+		std::atomic<bool> _isCapturing;
+
+		/**
+		 * \brief Frames left in a CaptureFrames capture (0 for a manual capture)
+		 */
+		unsigned int _framesLeft;
+
+		/**
+		 * \brief File a CaptureFrames capture is written to once it ends (empty to only keep it in memory)
+		 */
+		std::string _traceFilepath;
+
+		/**
+		 * \brief Profiler time
+		 */
+		Clock _clock;
+
+	};
+
+	class ProfileScope
+	{
+	public:
+		/**
+		 * \brief Start timing a scope (only reads the clock while a capture is running)
+		 *
+		 * \param name Scope name, must outlive the capture (string literals)
+		 */
+		ProfileScope( const char *name );
+
+		/**
+		 * \brief Stop timing the scope and record it
+		 */
+		~ProfileScope( );
+
+	private:
+		/**
+		 * \brief Scope name
+		 */
+		const char *_name;
+
+		/**
+		 * \brief Start time in microseconds (-1 when not capturing)
+		 */
+		long long _start;
+
+	};
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+namespace Sonar
+{
+	class SnapshotBuffer
+	{
+	public:
+		/**
+		 * \brief Transform of an object at the end of a fixed step
+		 */
+		struct Transform
+		{
+			glm::vec2 position;
+			glm::vec2 scale = glm::vec2( 1.0f );
+			float rotation = 0.0f;
+		};
+
+		/**
+		 * \brief Class constructor
+		 */
+		SnapshotBuffer( );
+
+		/**
+		 * \brief Class destructor
+		 */
+		~SnapshotBuffer( );
+
+		/**
+		 * \brief Set an object's transform in the snapshot being written (call from State::Update)
+		 *
+		 * \param id Object ID, keep them small and dense as they index an array
+		 * \param transform Object transform
+		 */
+		void SetTransform( const unsigned int &id, const Transform &transform );
+
+		/**
+		 * \brief Set an object's transform in the snapshot being written (call from State::Update)
+		 *
+		 * \param id Object ID, keep them small and dense as they index an array
+		 * \param position Object position
+		 * \param rotation Object rotation in degrees
+		 * \param scale Object scale
+		 */
+		void SetTransform( const unsigned int &id, const glm::vec2 &position, const float &rotation = 0.0f, const glm::vec2 &scale = glm::vec2( 1.0f ) );
+
+		/**
+		 * \brief Remove an object from the snapshot being written
+		 *
+		 * \param id Object ID
+		 */
+		void RemoveTransform( const unsigned int &id );
+
+		/**
+		 * \brief Publish the snapshot being written, it becomes the latest and the old latest becomes the previous (run after every fixed step in Game.cpp)
+		 */
+		void Publish( );
+
+		/**
+		 * \brief Take a copy of the latest two published snapshots for drawing (run before State::Draw in Game.cpp)
+		 */
+		void Acquire( );
+
+		/**
+		 * \brief Check if an object is in the acquired snapshots
+		 *
+		 * \param id Object ID
+		 *
+		 * \return Output returns true if the object has a transform
+		 */
+		bool HasTransform( const unsigned int &id ) const;
+
+		/**
+		 * \brief Get an object's transform blended between the acquired snapshots (call from State::Draw)
+		 *
+		 * \param id Object ID
+		 * \param interpolation Blend factor between the previous (0) and latest (1) snapshot, the value State::Draw receives
+		 *
+		 * \return Output returns the blended transform
+		 */
+		Transform GetTransform( const unsigned int &id, const float &interpolation ) const;
+
+		/**
+		 * \brief Get the time since the latest snapshot was published
+		 *
+		 * \return Output returns the time in seconds
+		 */
+		float GetTimeSinceLatest( ) const;
+
+	private:
+		/**
+		 * \brief Transform slot in a snapshot
+		 */
+		struct Entry
+		{
+			Transform transform;
+			bool isSet;
+		};
+
+		/**
+		 * \brief Snapshot being written by the simulation
+		 */
+		std::vector<Entry> _write;
+
+		/**
+		 * \brief Latest and previous published snapshots (swapped, never reallocated)
+		 */
+		std::vector<Entry> _latest, _previous;
+
+		/**
+		 * \brief Copies of the published snapshots used for drawing
+		 */
+		std::vector<Entry> _drawLatest, _drawPrevious;
+
+		/**
+		 * \brief Time the latest snapshot was published
+		 */
+		std::atomic<long long> _latestTime;
+
+		/**
+		 * \brief Clock for timing the snapshots
+		 */
+		Clock _clock;
+
+		/**
+		 * \brief Guards the published snapshots
+		 */
+		std::mutex _mutex;
+
+	};
+}
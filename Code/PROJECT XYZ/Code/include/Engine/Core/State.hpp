@@ -17,6 +17,11 @@ namespace Sonar
         */
 		virtual void Init( ) = 0;
 
+        /**
+         * \brief Load assets and build objects on a background thread before Init, only called when added through StateMachine::AddStateAsync (overriding is optional)
+        */
+		virtual void Preload( ) { }
+
         /**
          * \brief Poll the input from the Joystick, Keyboard and Mouse (overriding is essential)
          *
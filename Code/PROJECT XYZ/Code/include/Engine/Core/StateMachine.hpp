@@ -25,6 +25,14 @@ namespace Sonar
          * \param isReplacing is the state being replaced or added (replaced by default)
         */
 		void AddState( StateRef newState, const bool &isReplacing = true );
+        /**
+         * \brief Create a state and run its Preload on a background thread, it's added once ready (replaces any preload still running, waiting for it to finish)
+         *
+         * \param factory Function that creates the state (runs on the background thread, so it can build widgets and load assets)
+         * \param loadingState [OPTIONAL] State shown until the new state is ready, otherwise the current state stays active
+         * \param isReplacing is the state being replaced or added (replaced by default)
+        */
+		void AddStateAsync( const std::function<StateRef( )> &factory, StateRef loadingState = nullptr, const bool &isReplacing = true );
         /**
          * \brief Remove the current state from the stack
         */
@@ -41,6 +49,20 @@ namespace Sonar
         */
 		StateRef &GetActiveState( );
 
+        /**
+         * \brief Check if there are no states on the stack
+         *
+         * \return Output returns true if the stack is empty and false if it isn't
+        */
+		bool IsEmpty( ) const;
+
+        /**
+         * \brief Check if a state is being preloaded
+         *
+         * \return Output returns true if a state added with AddStateAsync isn't ready yet
+        */
+		bool IsLoading( ) const;
+
 	private:
         /**
          * \brief Stack of states
@@ -63,5 +85,22 @@ namespace Sonar
          * \brief Is the state being replaced
         */
         bool _isReplacing;
+
+        /**
+         * \brief State being preloaded on a background thread
+        */
+		std::future<StateRef> _loadingFuture;
+        /**
+         * \brief State to show while preloading
+        */
+		StateRef _loadingState;
+        /**
+         * \brief Is the loading state on top of the stack
+        */
+		bool _isLoadingStateActive;
+        /**
+         * \brief Is the preloaded state replacing the current state
+        */
+		bool _isLoadingReplacing;
 	};
 }
@@ -14,6 +14,8 @@
 #ifndef GAMEPAD_H
 #define GAMEPAD_H
 
+#ifdef _WIN32
+
 // Needed for 'ZeroMemory' function
 #include <Windows.h>
 
@@ -107,7 +109,47 @@ private:
 	XINPUT_STATE state; // Current gamepad state
 };
 
+// Externally define 'XInput_ButtonIDs' struct as 'xButtons'
+extern XInput_ButtonIDs xButtons;
+
+#else
+
+// XInput is Windows only, other platforms get a gamepad that is never
+// connected (SFML still handles joystick input, only rumble is lost)
+class Gamepad
+{
+public:
+
+	Gamepad() : pad_id(-1) {}
+	Gamepad(int id) : pad_id(id - 1) {}
+
+	void Update() {}
+	void Refresh() {}
+
+	void SetRumble(float left = 0.0f, float right = 0.0f) {}
+
+	int GetID() { return pad_id; }
+	bool Connected() { return false; }
+
+	bool GetButtonPressed(int button) { return false; }
+	bool GetButtonDown(int button) { return false; }
+
+	bool LStick_InDeadzone() { return true; }
+	bool RStick_InDeadzone() { return true; }
+
+	float LeftStick_X() { return 0.0f; }
+	float LeftStick_Y() { return 0.0f; }
+	float RightStick_X() { return 0.0f; }
+	float RightStick_Y() { return 0.0f; }
+
+	float LeftTrigger() { return 0.0f; }
+	float RightTrigger() { return 0.0f; }
+
+private:
+
+	int pad_id;
+};
+
 #endif
 
-// Externally define 'XInput_ButtonIDs' struct as 'xButtons'
-extern XInput_ButtonIDs xButtons;
\ No newline at end of file
+#endif
\ No newline at end of file
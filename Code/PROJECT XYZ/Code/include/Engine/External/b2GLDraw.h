@@ -6,6 +6,8 @@
 #include <gl/GL.h>
 #elif __APPLE__
 #include <GLUT/GLUT.h>
+#else
+#include <GL/gl.h>
 #endif
 
 #include <Box2D/Box2D.h>
@@ -0,0 +1,260 @@
+#pragma once
+
+#include "Core/JobSystem.hpp"
+#include "Graphics/Drawable.hpp"
+
+namespace Sonar
+{
+    /**
+    * \brief Broadphase for drawable collisions, drawables are kept in a uniform spatial hash so only the ones sharing a cell are tested against each other
+    *
+    * Moving, resizing, scaling or rotating a registered drawable marks it, marked drawables are only rehashed on the next update (and only if they changed cells).
+    * Every drawable has a layer and a mask, two drawables are only tested if each one's layer is in the other one's mask.
+    * Queries and pair generation are spread across the job system's threads, the drawables mustn't change while they run.
+    * Registered drawables can be changed from any thread, but adding, removing, updating and querying have to happen on one thread while nothing is changing them.
+    */
+    class CollisionWorld
+    {
+    public:
+        /**
+        * \brief Test run on the drawables whose bounds overlap
+        */
+        enum class COLLISION_TEST
+        {
+            BOUNDS, // The broadphase bounds overlapping is enough
+            BOUNDING_BOX, // Drawable::BoundingBoxCollision
+            CIRCLE // Drawable::CircleCollision
+        };
+
+        /**
+        * \brief Two colliding drawables
+        */
+        typedef std::pair<Drawable *, Drawable *> CollisionPair;
+
+        /**
+        * \brief Class constructor
+        *
+        * \param cellSize [OPTIONAL] Width and height of a hash cell (around the size of the most common drawable works best)
+        * \param jobs [OPTIONAL] Job system queries are spread across (nullptr runs them on the calling thread)
+        */
+        CollisionWorld( const float &cellSize = DEFAULT_COLLISION_WORLD_CELL_SIZE, JobSystem *jobs = nullptr );
+
+        /**
+        * \brief Class destructor, every drawable still added is removed
+        */
+        ~CollisionWorld( );
+
+        /**
+        * \brief Add a drawable (a drawable can only be in one world at a time, it's removed when it's destroyed)
+        *
+        * \param drawable Drawable to add
+        * \param layer [OPTIONAL] Layer bits the drawable is on
+        * \param mask [OPTIONAL] Layer bits the drawable collides with
+        *
+        * \return Output returns true if it was added (false if it's already in a world)
+        */
+        bool Add( Drawable *drawable, const unsigned int &layer = DEFAULT_COLLISION_WORLD_LAYER, const unsigned int &mask = DEFAULT_COLLISION_WORLD_MASK );
+
+        /**
+        * \brief Remove a drawable
+        *
+        * \param drawable Drawable to remove
+        *
+        * \return Output returns true if it was in the world
+        */
+        bool Remove( Drawable *drawable );
+
+        /**
+        * \brief Set a drawable's layer and mask
+        *
+        * \param drawable Drawable in the world
+        * \param layer Layer bits the drawable is on
+        * \param mask Layer bits the drawable collides with
+        */
+        void SetFilter( Drawable *drawable, const unsigned int &layer, const unsigned int &mask );
+
+        /**
+        * \brief Check if a drawable is in the world
+        *
+        * \param drawable Drawable to check
+        *
+        * \return Output returns true if it's in the world
+        */
+        bool Contains( const Drawable *drawable ) const;
+
+        /**
+        * \brief Rehash the drawables that changed since the last update (queries do it too)
+        *
+        * \return Output returns the amount of drawables that changed cells
+        */
+        unsigned int Update( );
+
+        /**
+        * \brief Find the drawables overlapping an area
+        *
+        * \param bounds Area to check (left, top, width and height, the same as Drawable::GetGlobalBounds)
+        * \param overlaps Filled with the drawables whose bounding box (position and size) overlaps the area
+        * \param mask [OPTIONAL] Only drawables on one of these layers are found
+        */
+        void QueryOverlaps( const glm::vec4 &bounds, std::vector<Drawable *> &overlaps, const unsigned int &mask = DEFAULT_COLLISION_WORLD_MASK );
+
+        /**
+        * \brief Find the drawables overlapping several areas, the areas are spread across the job system's threads
+        *
+        * \param bounds Areas to check (left, top, width and height)
+        * \param overlaps Filled with the drawables overlapping each area, in the same order (the inner vectors' storage is reused)
+        * \param mask [OPTIONAL] Only drawables on one of these layers are found
+        */
+        void QueryOverlaps( const std::vector<glm::vec4> &bounds, std::vector<std::vector<Drawable *>> &overlaps, const unsigned int &mask = DEFAULT_COLLISION_WORLD_MASK );
+
+        /**
+        * \brief Find the drawables colliding with a drawable in the world, filtered by the layers and masks
+        *
+        * \param drawable Drawable in the world
+        * \param collisions Filled with the colliding drawables
+        * \param test [OPTIONAL] Test run on the drawables whose bounds overlap
+        */
+        void QueryCollisions( const Drawable *drawable, std::vector<Drawable *> &collisions, const COLLISION_TEST &test = COLLISION_TEST::BOUNDING_BOX );
+
+        /**
+        * \brief Find every pair of colliding drawables, filtered by the layers and masks, the cells are spread across the job system's threads
+        *
+        * \param pairs Filled with each colliding pair once (the drawable added first is first)
+        * \param test [OPTIONAL] Test run on the drawables whose bounds overlap
+        */
+        void GetPairs( std::vector<CollisionPair> &pairs, const COLLISION_TEST &test = COLLISION_TEST::BOUNDING_BOX );
+
+        /**
+        * \brief Get the amount of drawables in the world
+        *
+        * \return Output returns the drawable count
+        */
+        unsigned int GetCount( ) const;
+
+        /**
+        * \brief Get the width and height of a hash cell
+        *
+        * \return Output returns the cell size
+        */
+        float GetCellSize( ) const;
+
+    private:
+        friend class Drawable;
+
+        /**
+        * \brief Drawable in the world
+        */
+        struct Proxy
+        {
+            Drawable *drawable; // nullptr if the proxy is free
+            glm::vec4 box; // Min x, min y, max x and max y of the drawable's bounding box (position and size)
+            glm::vec4 bounds; // Min x, min y, max x and max y covering the drawable's bounding box and circle, what the proxy is hashed by
+            glm::ivec4 cells; // Min and max cell covered
+            unsigned int layer;
+            unsigned int mask;
+            unsigned long long order; // When the drawable was added, pairs are ordered by it
+            bool isMarked; // Changed since the last update
+        };
+
+        /**
+        * \brief Mark a drawable's proxy as changed, called by the drawable
+        *
+        * \param proxy Drawable's proxy
+        */
+        void MarkChanged( const unsigned int &proxy );
+
+        /**
+        * \brief Work out a drawable's bounding box and the bounds it covers
+        */
+        void GetBounds( const Drawable *drawable, glm::vec4 &box, glm::vec4 &bounds ) const;
+
+        /**
+        * \brief Work out the cells some bounds cover
+        */
+        glm::ivec4 GetCells( const glm::vec4 &bounds ) const;
+
+        /**
+        * \brief Add a proxy to or remove it from every cell it covers
+        */
+        void InsertIntoCells( const unsigned int &proxy );
+        void RemoveFromCells( const unsigned int &proxy );
+
+        /**
+        * \brief Find the drawables overlapping bounds (min x, min y, max x and max y), the world must be up to date
+        */
+        void FindOverlaps( const glm::vec4 &bounds, std::vector<Drawable *> &overlaps, const unsigned int &mask ) const;
+
+        /**
+        * \brief Check if two proxies collide (filters, bounds and the collision test)
+        */
+        bool IsColliding( const Proxy &first, const Proxy &second, const COLLISION_TEST &test ) const;
+
+        /**
+        * \brief Check if two bounds overlap, touching counts
+        */
+        static bool IsOverlapping( const glm::vec4 &first, const glm::vec4 &second )
+        { return first.x <= second.z && second.x <= first.z && first.y <= second.w && second.y <= first.w; }
+
+        /**
+        * \brief Get a cell's hash key
+        */
+        static unsigned long long GetKey( const int &x, const int &y )
+        { return ( static_cast<unsigned long long>( static_cast<uint32_t>( x ) ) << 32 ) | static_cast<uint32_t>( y ); }
+
+        /**
+        * \brief Width and height of a hash cell
+        */
+        float _cellSize;
+
+        /**
+        * \brief Job system queries are spread across
+        */
+        JobSystem *_jobs;
+
+        /**
+        * \brief Drawables in the world, indexed by proxy
+        */
+        std::vector<Proxy> _proxies;
+
+        /**
+        * \brief Proxies free to reuse
+        */
+        std::vector<unsigned int> _freeProxies;
+
+        /**
+        * \brief Proxies marked since the last update
+        */
+        std::vector<unsigned int> _markedProxies;
+
+        /**
+        * \brief Guards marking, drawables can change on several threads at once
+        */
+        std::mutex _markMutex;
+
+        /**
+        * \brief Proxies in each occupied cell, emptied cells are kept so their storage is reused
+        */
+        std::unordered_map<unsigned long long, std::vector<unsigned int>> _cells;
+
+        /**
+        * \brief Cells holding more than one proxy and their positions, gathered for pair generation
+        */
+        std::vector<std::pair<glm::ivec2, const std::vector<unsigned int> *>> _pairCells;
+
+        /**
+        * \brief Pairs found by each thread, kept so the storage is reused
+        */
+        std::vector<std::vector<CollisionPair>> _threadPairs;
+
+        /**
+        * \brief Amount of drawables in the world
+        */
+        unsigned int _count;
+
+        /**
+        * \brief Counts every drawable added
+        */
+        unsigned long long _addCount;
+
+    };
+}
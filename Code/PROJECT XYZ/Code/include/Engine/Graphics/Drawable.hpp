@@ -14,6 +14,7 @@
 
 namespace Sonar
 {
+    class CollisionWorld;
     class Mouse;
 
     /**
@@ -36,6 +37,13 @@ namespace Sonar
         */
         void Draw( );
 
+        /**
+        * \brief Draw object to application window at a snapshot transform instead of its own (the object itself isn't changed)
+        *
+        * \param transform Position, rotation and scale to draw at, from SnapshotBuffer::GetTransform
+        */
+        void Draw( const SnapshotBuffer::Transform &transform );
+
         /**
         * \brief Set x and y position
         *
@@ -474,11 +482,34 @@ namespace Sonar
         */
         Drawable( GameDataRef data );
 
+        /**
+        * \brief Class copy constructor, the copy isn't in a collision world
+        *
+        * \param drawable Object to copy
+        */
+        Drawable( const Drawable &drawable );
+
         /**
         * \brief Class destructor
         */
         ~Drawable( ) ;
 
+        /**
+        * \brief Copy another object's properties, the object stays in its own collision world (if it's in one) instead of joining the other object's
+        *
+        * \param drawable Object to copy
+        *
+        * \return Output returns the object
+        */
+        Drawable &operator=( const Drawable &drawable );
+
+        /**
+        * \brief Check if the object is within the visible window
+        *
+        * \return Output returns true if any part of the object is inside the window and false if it should be culled
+        */
+        bool IsInsideWindow( ) const;
+
         /**
         * \brief Object to be drawn to the screen, assigned the address of the object from a child class
         */
@@ -495,6 +526,13 @@ namespace Sonar
         GameDataRef _data;
 
     private:
+        friend class CollisionWorld;
+
+        /**
+        * \brief Mark the object as changed in its collision world, called whenever its bounds change
+        */
+        void MarkBoundsChanged( );
+
         /**
         * \brief Object position vector (x and y)
         */
@@ -565,5 +603,11 @@ namespace Sonar
         */
         Clock _clock;
 
+        /**
+        * \brief Collision world the object is in (nullptr if it isn't in one) and its proxy in the world
+        */
+        CollisionWorld *_collisionWorld;
+        unsigned int _collisionProxy;
+
     };
 }
@@ -23,7 +23,7 @@ namespace Sonar
         ~Font( );
 
         /**
-        * \brief Sets the font file
+        * \brief Sets the font file, fonts using the same file share one SFML font (and its glyph pages)
         *
         * \param filePath Font file path
         */
@@ -77,9 +77,9 @@ namespace Sonar
         std::string _filePath;
 
         /**
-        * \brief SFML font object
+        * \brief Handle to the SFML font object (copies of this object share it)
         */
-        sf::Font _font;
+        std::shared_ptr<sf::Font> _font;
 
     };
 }
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Managers/AssetPack.hpp"
+
+namespace Sonar
+{
+    class ResourceCache
+    {
+    public:
+        /**
+        * \brief Get the resource cache instance (shared by every thread)
+        *
+        * \return Output returns the resource cache
+        */
+        static ResourceCache *getInstance( );
+
+        /**
+        * \brief Mount an asset pack, files it contains are then loaded from the mapped pack instead of being opened, by the cache and every AssetManager (later packs take priority, packs stay mounted until exit)
+        *
+        * \param filepath Pack file (built with AssetPack::Build or sonar_pack)
+        *
+        * \return Output returns true if the pack was mounted
+        */
+        bool MountPack( const std::string &filepath );
+
+        /**
+        * \brief Find the mounted pack containing a file (safe to call from any thread)
+        *
+        * \param filepath File path
+        *
+        * \return Output returns the pack (nullptr if no mounted pack contains the file)
+        */
+        AssetPack *FindPack( const std::string &filepath );
+
+        /**
+        * \brief Get a texture, the file is only loaded if no other handle to it is alive
+        *
+        * \param filepath File path of the image (paths to the same file share a texture)
+        *
+        * \return Output returns a handle to the texture (an empty texture that isn't cached if the file couldn't be loaded)
+        */
+        std::shared_ptr<sf::Texture> GetTexture( const std::string &filepath );
+
+        /**
+        * \brief Get a font, the file is only loaded if no other handle to it is alive
+        *
+        * \param filepath File path of the font (paths to the same file share a font)
+        *
+        * \return Output returns a handle to the font (an empty font that isn't cached if the file couldn't be loaded)
+        */
+        std::shared_ptr<sf::Font> GetFont( const std::string &filepath );
+
+        /**
+        * \brief Get the amount of textures alive in the cache
+        *
+        * \return Output returns the texture count
+        */
+        unsigned int GetTextureCount( );
+
+        /**
+        * \brief Get the amount of fonts alive in the cache
+        *
+        * \return Output returns the font count
+        */
+        unsigned int GetFontCount( );
+
+    private:
+        /**
+        * \brief Class constructor
+        */
+        ResourceCache( );
+
+        /**
+        * \brief Class destructor
+        */
+        ~ResourceCache( );
+
+        /**
+        * \brief Get the key a file is cached under
+        *
+        * \param filepath File path
+        *
+        * \return Output returns the canonical path (the path unchanged if the file doesn't exist)
+        */
+        static std::string GetKey( const std::string &filepath );
+
+        /**
+        * \brief Find a resource or load it and add it to the cache, the cache is only locked to look the file up and to publish it so other files load at the same time
+        *
+        * \param resources Cached resources of the type
+        * \param loading Loads in flight of the type, threads asking for a file that's loading wait for it instead of loading it again
+        * \param filepath File path
+        *
+        * \return Output returns a handle to the resource
+        */
+        template<typename T>
+        std::shared_ptr<T> Acquire( std::unordered_map<std::string, std::weak_ptr<T>> &resources, std::unordered_map<std::string, std::shared_future<std::shared_ptr<T>>> &loading, const std::string &filepath );
+
+        /**
+        * \brief Load a file into a resource, from a mounted pack if one contains it
+        *
+        * \param resource Resource to load into (a font from a pack is replaced by one that also keeps the pack's bytes alive)
+        * \param filepath File path
+        *
+        * \return Output returns true if the resource was loaded
+        */
+        bool Load( std::shared_ptr<sf::Texture> &resource, const std::string &filepath );
+        bool Load( std::shared_ptr<sf::Font> &resource, const std::string &filepath );
+
+        /**
+        * \brief Mounted packs, never unmounted so fonts reading glyphs from their mapped files stay valid
+        */
+        std::vector<std::unique_ptr<AssetPack>> _packs;
+
+        /**
+        * \brief Guards the mounted packs (separate from the caches so lookups don't wait on loads being published)
+        */
+        std::mutex _packMutex;
+
+        /**
+        * \brief Textures by canonical path, only handles keep them alive so they're freed with the last one
+        */
+        std::unordered_map<std::string, std::weak_ptr<sf::Texture>> _textures;
+
+        /**
+        * \brief Fonts by canonical path, only handles keep them alive so they're freed with the last one
+        */
+        std::unordered_map<std::string, std::weak_ptr<sf::Font>> _fonts;
+
+        /**
+        * \brief Textures and fonts being loaded by canonical path
+        */
+        std::unordered_map<std::string, std::shared_future<std::shared_ptr<sf::Texture>>> _loadingTextures;
+        std::unordered_map<std::string, std::shared_future<std::shared_ptr<sf::Font>>> _loadingFonts;
+
+        /**
+        * \brief Guards the caches and loads in flight (states preloading on a background thread create sprites and labels)
+        */
+        std::mutex _mutex;
+
+    };
+}
@@ -5,6 +5,7 @@
 namespace Sonar
 {
     class Sprite;
+    class TextureAtlas;
 
     class ScrollingBackground
     {
@@ -53,6 +54,14 @@ namespace Sonar
         */
         void SetBackgrounds( const std::vector<std::string> &backgrounds );
 
+        /**
+        * \brief Set the backgrounds
+        *
+        * \param atlas Built texture atlas containing the backgrounds
+        * \param backgrounds All the backgrounds to be set using the file paths they were added to the atlas with
+        */
+        void SetBackgrounds( const TextureAtlas &atlas, const std::vector<std::string> &backgrounds );
+
         /**
         * \brief Update the scrolling backgrounds
         *
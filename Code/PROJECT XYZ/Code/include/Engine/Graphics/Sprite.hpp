@@ -28,11 +28,25 @@ namespace Sonar
         */
         Sprite( GameDataRef data, Texture *texture );
 
+        /**
+        * \brief Class constructor
+        *
+        * \param data Game data object
+        * \param atlas Built texture atlas containing the image
+        * \param filepath File path the image was added to the atlas with
+        */
+        Sprite( GameDataRef data, const TextureAtlas &atlas, const std::string &filepath );
+
         /**
         * \brief Class destructor
         */
         ~Sprite( );
 
+        /**
+        * \brief Draw the sprite to the application window (queued in the game's sprite batch when batching is enabled)
+        */
+        void Draw( );
+
         /**
         * \brief Set x and y position
         *
@@ -243,6 +257,14 @@ namespace Sonar
         */
 		void SetTexture( Texture *texture, const bool &resetRect = false );
 
+        /**
+        * \brief Set the sprite texture to an image's atlas page and its texture rect to the image's region
+        *
+        * \param atlas Built texture atlas containing the image (must outlive the sprite)
+        * \param filepath File path the image was added to the atlas with
+        */
+        void SetTexture( const TextureAtlas &atlas, const std::string &filepath );
+
         /**
         * \brief Set the sprite rectangle
         *
@@ -298,6 +320,20 @@ namespace Sonar
         */
         bool PixelPerfectCollisionCheck( const Sprite &object, const unsigned char &alphaLimit = 0 );
 
+        /**
+        * \brief Set the blend mode used when drawing the sprite
+        *
+        * \param blendMode SFML blend mode (alpha blending by default)
+        */
+        void SetBlendMode( const sf::BlendMode &blendMode );
+
+        /**
+        * \brief Get the blend mode used when drawing the sprite
+        *
+        * \return Output returns the blend mode
+        */
+        const sf::BlendMode &GetBlendMode( ) const;
+
         /**
         * \brief Get the underlying SFML sprite object
         *
@@ -316,5 +352,10 @@ namespace Sonar
         */
         Texture *_texture;
 
+        /**
+        * \brief Blend mode used when drawing the sprite
+        */
+        sf::BlendMode _blendMode;
+
     };
 }
@@ -0,0 +1,158 @@
+#pragma once
+
+namespace Sonar
+{
+    class SpriteBatch
+    {
+    public:
+        /**
+        * \brief How the queued sprites are grouped into draw calls
+        */
+        enum class SORT_MODE
+        {
+            DEFERRED, // Keeps the submission order, consecutive sprites sharing a texture and blend mode are merged
+            TEXTURE // Groups every sprite in the frame by texture and blend mode (draw order between groups is not kept)
+        };
+
+        /**
+        * \brief Class constructor
+        */
+        SpriteBatch( );
+
+        /**
+        * \brief Class destructor
+        */
+        ~SpriteBatch( );
+
+        /**
+        * \brief Enable batching, sprites are queued instead of drawn straight away
+        */
+        void Enable( );
+
+        /**
+        * \brief Disable batching, sprites are drawn individually
+        */
+        void Disable( );
+
+        /**
+        * \brief Check if batching is enabled
+        *
+        * \return Output returns true if batching is enabled and false if it isn't
+        */
+        bool IsEnabled( ) const;
+
+        /**
+        * \brief Set the sort mode
+        *
+        * \param sortMode How the sprites are grouped
+        */
+        void SetSortMode( const SORT_MODE &sortMode );
+
+        /**
+        * \brief Get the sort mode
+        *
+        * \return Output returns the sort mode
+        */
+        SORT_MODE GetSortMode( ) const;
+
+        /**
+        * \brief Queue a sprite's quad to be drawn on the next flush
+        *
+        * \param sprite SFML sprite to queue
+        * \param blendMode Blend mode the sprite is drawn with
+        */
+        void Add( const sf::Sprite &sprite, const sf::BlendMode &blendMode = sf::BlendAlpha );
+
+        /**
+        * \brief Draw every queued batch, one draw call per batch
+        *
+        * \param target Render target to draw to
+        */
+        void Flush( sf::RenderTarget &target );
+
+        /**
+        * \brief Store the current frame's counters and reset them (run at the end of each frame in Game.cpp)
+        */
+        void EndFrame( );
+
+        /**
+        * \brief Get the amount of sprites submitted last frame
+        *
+        * \return Output returns the sprite count
+        */
+        unsigned int GetSpriteCount( ) const;
+
+        /**
+        * \brief Get the amount of draw calls issued by the batch last frame
+        *
+        * \return Output returns the draw call count
+        */
+        unsigned int GetDrawCallCount( ) const;
+
+        /**
+        * \brief Get the amount of draw calls saved last frame (sprites submitted minus draw calls issued)
+        *
+        * \return Output returns the merged draw call count
+        */
+        unsigned int GetMergedDrawCallCount( ) const;
+
+        /**
+        * \brief Get the amount of vertices submitted by the batch last frame
+        *
+        * \return Output returns the vertex count
+        */
+        unsigned int GetVertexCount( ) const;
+
+    private:
+        /**
+        * \brief Sprites sharing the same texture and blend mode
+        */
+        struct Batch
+        {
+            const sf::Texture *texture;
+            sf::BlendMode blendMode;
+            sf::VertexArray vertices;
+        };
+
+        /**
+        * \brief Get a batch the sprite can be appended to, creating one if needed
+        *
+        * \param texture Texture of the sprite
+        * \param blendMode Blend mode of the sprite
+        *
+        * \return Output returns the batch
+        */
+        Batch &GetBatch( const sf::Texture *texture, const sf::BlendMode &blendMode );
+
+        /**
+        * \brief Batches (kept between frames so their vertex memory is reused)
+        */
+        std::vector<Batch> _batches;
+
+        /**
+        * \brief Number of batches in use since the last flush
+        */
+        unsigned int _activeBatches;
+
+        /**
+        * \brief Is batching enabled
+        */
+        bool _isEnabled;
+
+        /**
+        * \brief Sort mode
+        */
+        SORT_MODE _sortMode;
+
+        /**
+        * \brief Counters for the current frame
+        */
+        unsigned int _spriteCount, _drawCallCount, _vertexCount;
+
+        /**
+        * \brief Counters for the last completed frame
+        */
+        unsigned int _lastSpriteCount, _lastDrawCallCount, _lastVertexCount;
+
+    };
+}
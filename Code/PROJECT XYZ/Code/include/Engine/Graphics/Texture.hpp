@@ -6,14 +6,14 @@ namespace Sonar
     {
     public:
         /**
-        * \brief Default class constructor
+        * \brief Default class constructor, the texture is owned by this object rather than the resource cache
         */
         Texture( );
 
         /**
         * \brief Class constructor
         *
-        * \param filepath File path of the image
+        * \param filepath File path of the image (shared through the resource cache)
         */
         Texture( const std::string &filepath );
         
@@ -23,14 +23,14 @@ namespace Sonar
         ~Texture( );
 
         /**
-        * \brief Set the texture from an image file
+        * \brief Set the texture from an image file, textures using the same file share one SFML texture
         *
 		* \param filepath File path of the image
         */
         void SetTexture( const std::string &filepath );
         
         /**
-        * \brief Set the texture from another texture
+        * \brief Share another texture's SFML texture
         *
         * \param texture Texture object
         */
@@ -51,7 +51,7 @@ namespace Sonar
         glm::vec2 GetSize( ) const;
 
         /**
-        * \brief Set the repeat status
+        * \brief Set the repeat status (applies to every texture sharing the same file)
         *
         * \param repeated Does the texture repeat
         */
@@ -66,9 +66,9 @@ namespace Sonar
 
     private:
         /**
-        * \brief SFML texture object
+        * \brief Handle to the SFML texture object
         */
-        sf::Texture *_texture;
+        std::shared_ptr<sf::Texture> _texture;
         
     };
 }
@@ -0,0 +1,205 @@
+#pragma once
+
+namespace Sonar
+{
+    class Texture;
+
+    class TextureAtlas
+    {
+    public:
+        /**
+        * \brief Area of an image inside the atlas
+        */
+        struct Region
+        {
+            unsigned int page; // Index of the page the image was packed into
+            glm::ivec4 rectangle; // Left, top, width and height inside the page
+        };
+
+        /**
+        * \brief Class constructor
+        *
+        * \param pageSize Width and height of each atlas page
+        * \param padding Empty pixels left around every image to stop neighbours bleeding in when filtering
+        */
+        TextureAtlas( const unsigned int &pageSize = DEFAULT_TEXTURE_ATLAS_PAGE_SIZE, const unsigned int &padding = DEFAULT_TEXTURE_ATLAS_PADDING );
+
+        /**
+        * \brief Class destructor
+        */
+        ~TextureAtlas( );
+
+        /**
+        * \brief Add an image to be packed on the next build
+        *
+        * \param filepath File path of the image (also used to retrieve its region)
+        */
+        void AddImage( const std::string &filepath );
+
+        /**
+        * \brief Add every image inside a directory to be packed on the next build
+        *
+        * \param directory Directory to search (not recursive)
+        * \param extension File extension of the images to add (.png by default)
+        */
+        void AddDirectory( const std::string &directory, const std::string &extension = ".png" );
+
+        /**
+        * \brief Pack all the added images into as few pages as possible using skyline packing
+        *
+        * \param cacheFilepath [OPTIONAL] Layout file, if it matches the added images the pages are loaded from disk instead of packed, otherwise it is written after packing
+        *
+        * \return Output returns true if every image was packed or loaded
+        */
+        bool Build( const std::string &cacheFilepath = "" );
+
+        /**
+        * \brief Check if an image is in the atlas
+        *
+        * \param filepath File path of the image
+        *
+        * \return Output returns true if the image has a region
+        */
+        bool HasRegion( const std::string &filepath ) const;
+
+        /**
+        * \brief Get the region of an image
+        *
+        * \param filepath File path of the image
+        *
+        * \return Output returns the page and rectangle of the image
+        */
+        const Region &GetRegion( const std::string &filepath ) const;
+
+        /**
+        * \brief Get an atlas page
+        *
+        * \param index Index of the page
+        *
+        * \return Output returns the page texture
+        */
+        Texture *GetPage( const unsigned int &index ) const;
+
+        /**
+        * \brief Get the amount of pages
+        *
+        * \return Output returns the page count
+        */
+        unsigned int GetPageCount( ) const;
+
+        /**
+        * \brief Check if the last build was loaded from the cache
+        *
+        * \return Output returns true if packing was skipped
+        */
+        bool IsLoadedFromCache( ) const;
+
+    private:
+        /**
+        * \brief Top edge segment of the packed area
+        */
+        struct SkylineNode
+        {
+            int x, y, width;
+        };
+
+        /**
+        * \brief Skyline of a single page
+        */
+        typedef std::vector<SkylineNode> Skyline;
+
+        /**
+        * \brief Find the lowest position a rectangle fits on the skyline and add it
+        *
+        * \param skyline Skyline of the page
+        * \param pageSize Size of the page
+        * \param size Size of the rectangle (padding included)
+        * \param position Top left position of the placed rectangle
+        *
+        * \return Output returns true if the rectangle fits on the page
+        */
+        bool PackRectangle( Skyline &skyline, const glm::ivec2 &pageSize, const glm::ivec2 &size, glm::ivec2 &position ) const;
+
+        /**
+        * \brief Get the height a rectangle would sit at if placed at a skyline node
+        *
+        * \param skyline Skyline of the page
+        * \param index Skyline node the rectangle's left edge starts at
+        * \param pageSize Size of the page
+        * \param size Size of the rectangle
+        *
+        * \return Output returns the y position or -1 if it doesn't fit
+        */
+        int GetSkylineHeight( const Skyline &skyline, const unsigned int &index, const glm::ivec2 &pageSize, const glm::ivec2 &size ) const;
+
+        /**
+        * \brief Load the pages and regions from a layout file
+        *
+        * \param cacheFilepath Layout file path
+        *
+        * \return Output returns true if the layout matches the added images and was loaded
+        */
+        bool LoadCache( const std::string &cacheFilepath );
+
+        /**
+        * \brief Write the pages and regions to disk
+        *
+        * \param cacheFilepath Layout file path
+        * \param pages Packed page images
+        */
+        void SaveCache( const std::string &cacheFilepath, const std::vector<sf::Image> &pages ) const;
+
+        /**
+        * \brief Get the file path of a cached page image
+        *
+        * \param cacheFilepath Layout file path
+        * \param index Index of the page
+        *
+        * \return Output returns the page image file path
+        */
+        std::string GetPageFilepath( const std::string &cacheFilepath, const unsigned int &index ) const;
+
+        /**
+        * \brief Get the size and modification time of every added image (used to validate the cache)
+        *
+        * \return Output returns the source file information
+        */
+        nlohmann::json GetSourceInfo( ) const;
+
+        /**
+        * \brief Delete the pages
+        */
+        void ClearPages( );
+
+        /**
+        * \brief Images to pack
+        */
+        std::vector<std::string> _filepaths;
+
+        /**
+        * \brief Regions of the packed images
+        */
+        std::map<std::string, Region> _regions;
+
+        /**
+        * \brief Atlas pages
+        */
+        std::vector<Texture *> _pages;
+
+        /**
+        * \brief Width and height of each page
+        */
+        unsigned int _pageSize;
+
+        /**
+        * \brief Padding around each image
+        */
+        unsigned int _padding;
+
+        /**
+        * \brief Was the last build loaded from the cache
+        */
+        bool _isLoadedFromCache;
+
+    };
+}
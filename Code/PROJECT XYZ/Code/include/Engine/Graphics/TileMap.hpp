@@ -0,0 +1,174 @@
+#pragma once
+
+#include "Core/Game.hpp"
+#include "Managers/MapManager.hpp"
+
+namespace Sonar
+{
+    /**
+    * \brief Draws a map layer with a tileset, one vertex array and draw call per visible map chunk
+    *
+    * Chunk meshes are built the first time they're visible and only rebuilt when a cell in the chunk changes,
+    * chunks outside the window's current view are skipped.
+    */
+    class TileMap
+    {
+    public:
+        /**
+        * \brief Picks the tile drawn for a cell value
+        *
+        * \param value Cell value
+        *
+        * \return Output returns the tile index in the tileset (row by row, -1 draws nothing)
+        */
+        typedef std::function<int( const MapCell &value )> TileFunction;
+
+        /**
+        * \brief Class constructor
+        *
+        * \param data Game data object
+        * \param map Map to draw (must outlive the tile map)
+        * \param layer [OPTIONAL] Map layer to draw
+        */
+        TileMap( GameDataRef data, MapManager *map, const unsigned int &layer = 0 );
+
+        /**
+        * \brief Class destructor
+        */
+        ~TileMap( );
+
+        /**
+        * \brief Draw the chunks inside the current view, rebuilding any that changed
+        */
+        void Draw( );
+
+        /**
+        * \brief Set the tileset
+        *
+        * \param texture Tileset texture (must outlive the tile map or be replaced first, one from the asset manager is marked used whenever the map draws)
+        * \param tileSize Size of a tile in the texture in pixels
+        */
+        void SetTileset( const sf::Texture *texture, const glm::uvec2 &tileSize );
+
+        /**
+        * \brief Set which tile each cell value draws (by default the value is the tile index and ' ' draws nothing)
+        *
+        * \param tileFunction Function picking the tile
+        */
+        void SetTileFunction( const TileFunction &tileFunction );
+
+        /**
+        * \brief Set the size each cell is drawn at (defaults to the tileset's tile size)
+        *
+        * \param cellSize Width and height of a cell
+        */
+        void SetCellSize( const glm::vec2 &cellSize );
+
+        /**
+        * \brief Get the size each cell is drawn at
+        *
+        * \return Output returns the cell size
+        */
+        glm::vec2 GetCellSize( ) const;
+
+        /**
+        * \brief Set the position of the map's top left corner
+        *
+        * \param position X and Y position
+        */
+        void SetPosition( const glm::vec2 &position );
+
+        /**
+        * \brief Get the position of the map's top left corner
+        *
+        * \return Output returns the position
+        */
+        glm::vec2 GetPosition( ) const;
+
+        /**
+        * \brief Get the amount of chunks drawn last time the tile map was drawn
+        *
+        * \return Output returns the chunk count
+        */
+        unsigned int GetDrawnChunkCount( ) const;
+
+        /**
+        * \brief Get the amount of chunks rebuilt last time the tile map was drawn
+        *
+        * \return Output returns the chunk count
+        */
+        unsigned int GetRebuiltChunkCount( ) const;
+
+    private:
+        /**
+        * \brief Mesh of a map chunk
+        */
+        struct Chunk
+        {
+            sf::VertexArray vertices;
+            unsigned long long version = 0; // Map chunk version the mesh was built from (0 if it hasn't been built)
+        };
+
+        /**
+        * \brief Build a chunk's mesh from the map
+        *
+        * \param chunkX X position of the chunk in chunks
+        * \param chunkY Y position of the chunk in chunks
+        * \param chunk Chunk to build
+        */
+        void BuildChunk( const unsigned int &chunkX, const unsigned int &chunkY, Chunk &chunk );
+
+        /**
+        * \brief Drop every chunk mesh so they're rebuilt when next visible
+        */
+        void ClearChunks( );
+
+        /**
+        * \brief Game data object
+        */
+        GameDataRef _data;
+
+        /**
+        * \brief Map and layer drawn
+        */
+        MapManager *_map;
+        unsigned int _layer;
+
+        /**
+        * \brief Tileset
+        */
+        const sf::Texture *_tileset;
+        glm::uvec2 _tileSize;
+
+        /**
+        * \brief Picks the tile drawn for a cell value
+        */
+        TileFunction _tileFunction;
+
+        /**
+        * \brief Size each cell is drawn at
+        */
+        glm::vec2 _cellSize;
+
+        /**
+        * \brief Position of the map's top left corner
+        */
+        glm::vec2 _position;
+
+        /**
+        * \brief Chunk meshes, row by row
+        */
+        std::vector<Chunk> _chunks;
+
+        /**
+        * \brief Chunk count the meshes were made for, the meshes are dropped when the map is resized
+        */
+        glm::uvec2 _chunkCount;
+
+        /**
+        * \brief Counters from the last draw
+        */
+        unsigned int _drawnChunkCount, _rebuiltChunkCount;
+
+    };
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+namespace Sonar
+{
+	class Event;
+
+	class InputRecorder
+	{
+	public:
+		/**
+		 * \brief Class constructor
+		 */
+		InputRecorder( );
+
+		/**
+		 * \brief Class destructor, finishes any recording in progress
+		 */
+		~InputRecorder( );
+
+		/**
+		 * \brief Start recording the events delivered to State::PollInput, steps count from the start of the recording
+		 *
+		 * \param filepath File to write the log to
+		 * \param dt Fixed step the session runs at (stored so replays can check they match)
+		 *
+		 * \return Output returns true if the file was opened
+		 */
+		bool StartRecording( const std::string &filepath, const float &dt );
+
+		/**
+		 * \brief Finish the recording, writing the session length and closing the file
+		 *
+		 * \return Output returns true if the log was written
+		 */
+		bool StopRecording( );
+
+		/**
+		 * \brief Check if events are being recorded
+		 *
+		 * \return Output returns true if recording
+		 */
+		bool IsRecording( ) const;
+
+		/**
+		 * \brief Start replaying a log from its first step, live input should be ignored until the replay ends
+		 *
+		 * \param filepath Log to replay
+		 *
+		 * \return Output returns true if the log was loaded
+		 */
+		bool StartReplay( const std::string &filepath );
+
+		/**
+		 * \brief Stop replaying
+		 */
+		void StopReplay( );
+
+		/**
+		 * \brief Check if a log is being replayed
+		 *
+		 * \return Output returns true if replaying
+		 */
+		bool IsReplaying( ) const;
+
+		/**
+		 * \brief Get the fixed step the replayed log was recorded at
+		 *
+		 * \return Output returns the delta time in seconds
+		 */
+		float GetReplayDt( ) const;
+
+		/**
+		 * \brief Get the length of the replayed log
+		 *
+		 * \return Output returns the amount of fixed steps recorded
+		 */
+		unsigned long long int GetReplayLength( ) const;
+
+		/**
+		 * \brief Record an event on the current step (does nothing when not recording)
+		 *
+		 * \param event Event delivered to State::PollInput
+		 */
+		void Record( const Event &event );
+
+		/**
+		 * \brief Get the next replayed event for the current step
+		 *
+		 * \param event Event to fill
+		 *
+		 * \return Output returns true if an event was returned, false once the step has none left
+		 */
+		bool GetReplayEvent( Event &event );
+
+		/**
+		 * \brief Move on to the next fixed step, ends the replay after its last step (run after every fixed step)
+		 */
+		void EndStep( );
+
+		/**
+		 * \brief Get the current step since recording or replaying started
+		 *
+		 * \return Output returns the step index
+		 */
+		unsigned long long int GetStep( ) const;
+
+	private:
+		/**
+		 * \brief Write an unsigned value using 7 bits per byte
+		 *
+		 * \param value Value to write
+		 */
+		void WriteVarint( unsigned long long int value );
+
+		/**
+		 * \brief Write a signed value, zigzag encoded so small negatives stay small
+		 *
+		 * \param value Value to write
+		 */
+		void WriteSigned( const int &value );
+
+		/**
+		 * \brief Write a float as its raw 4 bytes
+		 *
+		 * \param value Value to write
+		 */
+		void WriteFloat( const float &value );
+
+		/**
+		 * \brief Read an unsigned value written by WriteVarint
+		 *
+		 * \param value Value to fill
+		 *
+		 * \return Output returns false if the log ended early
+		 */
+		bool ReadVarint( unsigned long long int &value );
+
+		/**
+		 * \brief Read a signed value written by WriteSigned
+		 *
+		 * \param value Value to fill
+		 *
+		 * \return Output returns false if the log ended early
+		 */
+		bool ReadSigned( int &value );
+
+		/**
+		 * \brief Read a float written by WriteFloat
+		 *
+		 * \param value Value to fill
+		 *
+		 * \return Output returns false if the log ended early
+		 */
+		bool ReadFloat( float &value );
+
+		/**
+		 * \brief Write the buffered records to the file
+		 */
+		void Flush( );
+
+		/**
+		 * \brief Log being written
+		 */
+		std::ofstream _file;
+
+		/**
+		 * \brief Records waiting to be written, or the log being decoded
+		 */
+		std::vector<char> _buffer;
+
+		/**
+		 * \brief Read position while decoding a log
+		 */
+		size_t _readPosition;
+
+		/**
+		 * \brief Decoded events of the replayed log and the step each arrived on
+		 */
+		std::vector<std::pair<unsigned long long int, Event>> _replayEvents;
+
+		/**
+		 * \brief Next replayed event
+		 */
+		size_t _replayIndex;
+
+		/**
+		 * \brief Current step since recording or replaying started
+		 */
+		unsigned long long int _step;
+
+		/**
+		 * \brief Step of the last recorded event
+		 */
+		unsigned long long int _lastEventStep;
+
+		/**
+		 * \brief Amount of steps in the replayed log
+		 */
+		unsigned long long int _replayLength;
+
+		/**
+		 * \brief Fixed step the replayed log was recorded at
+		 */
+		float _replayDt;
+
+		/**
+		 * \brief Current mode
+		 */
+		bool _isRecording, _isReplaying;
+
+	};
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+/**
+* \brief Asset handle layout, the low bits are the slot index and the high bits the slot's generation
+*/
+#define SONAR_ASSET_HANDLE_INDEX_BITS 20
+#define SONAR_ASSET_HANDLE_INDEX_MASK ( ( 1u << SONAR_ASSET_HANDLE_INDEX_BITS ) - 1 )
+#define SONAR_ASSET_HANDLE_GENERATION_MASK ( 0xFFFFFFFFu >> SONAR_ASSET_HANDLE_INDEX_BITS )
+
+namespace Sonar
+{
+	/**
+	 * \brief 32-bit reference to a loaded asset, it stops resolving once the asset is unloaded even if the slot is reused
+	 */
+	class AssetHandle
+	{
+	public:
+		/**
+		 * \brief Default class constructor (an invalid handle)
+		 */
+		constexpr AssetHandle( ) : _value( 0 ) { }
+
+		/**
+		 * \brief Class constructor
+		 *
+		 * \param index Slot index
+		 * \param generation Slot generation (never 0)
+		 */
+		constexpr AssetHandle( const uint32_t &index, const uint32_t &generation ) : _value( ( ( generation & SONAR_ASSET_HANDLE_GENERATION_MASK ) << SONAR_ASSET_HANDLE_INDEX_BITS ) | ( index & SONAR_ASSET_HANDLE_INDEX_MASK ) ) { }
+
+		/**
+		 * \brief Get the slot index
+		 *
+		 * \return Output returns the index
+		 */
+		constexpr uint32_t GetIndex( ) const
+		{ return _value & SONAR_ASSET_HANDLE_INDEX_MASK; }
+
+		/**
+		 * \brief Get the slot generation
+		 *
+		 * \return Output returns the generation
+		 */
+		constexpr uint32_t GetGeneration( ) const
+		{ return _value >> SONAR_ASSET_HANDLE_INDEX_BITS; }
+
+		/**
+		 * \brief Get the packed 32-bit value
+		 *
+		 * \return Output returns the value
+		 */
+		constexpr uint32_t GetValue( ) const
+		{ return _value; }
+
+		/**
+		 * \brief Check if the handle was ever assigned to an asset (it may still be stale)
+		 *
+		 * \return Output returns true if the handle isn't the default invalid handle
+		 */
+		constexpr bool IsValid( ) const
+		{ return 0 != _value; }
+
+		constexpr bool operator ==( const AssetHandle &other ) const
+		{ return _value == other._value; }
+
+		constexpr bool operator !=( const AssetHandle &other ) const
+		{ return _value != other._value; }
+
+	private:
+		/**
+		 * \brief Packed index and generation
+		 */
+		uint32_t _value;
+
+	};
+
+	/**
+	 * \brief Hashed asset name, constexpr names are hashed at compile time so looking them up never touches a string
+	 */
+	class AssetName
+	{
+	public:
+		/**
+		 * \brief Class constructor
+		 *
+		 * \param name Asset name
+		 */
+		constexpr AssetName( const char *name ) : _hash( Hash( name ) ) { }
+
+		/**
+		 * \brief Class constructor
+		 *
+		 * \param name Asset name
+		 */
+		AssetName( const std::string &name ) : _hash( Hash( name.c_str( ) ) ) { }
+
+		/**
+		 * \brief Get the name's hash
+		 *
+		 * \return Output returns the hash
+		 */
+		constexpr uint32_t GetHash( ) const
+		{ return _hash; }
+
+		/**
+		 * \brief Hash a name (32-bit FNV-1a)
+		 *
+		 * \param name Name to hash
+		 *
+		 * \return Output returns the hash
+		 */
+		static constexpr uint32_t Hash( const char *name )
+		{
+			uint32_t hash = 2166136261u;
+
+			for ( ; '\0' != *name; name++ )
+			{ hash = ( hash ^ static_cast<uint8_t>( *name ) ) * 16777619u; }
+
+			return hash;
+		}
+
+	private:
+		/**
+		 * \brief Name hash
+		 */
+		uint32_t _hash;
+
+	};
+}
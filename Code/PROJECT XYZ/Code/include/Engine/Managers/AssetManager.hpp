@@ -1,108 +1,625 @@
 #pragma once
 
+#include "Core/JobSystem.hpp"
+#include "Managers/AssetPack.hpp"
+#include "Managers/AssetSlots.hpp"
+
 namespace Sonar
 {
+	/**
+	 * \brief Future for an asynchronous load, ready once the asset is uploaded (holds an invalid handle if it couldn't be loaded)
+	*/
+	typedef std::shared_future<AssetHandle> AssetFuture;
+
 	class AssetManager
 	{
 	public:
 		/**
-		 * \brief Default class constructor
+		 * \brief Asset types
+		*/
+		enum class ASSET_TYPE
+		{
+			TEXTURE,
+			FONT,
+			SOUND,
+			MUSIC
+		};
+
+		/**
+		 * \brief Memory report of a loaded asset
+		*/
+		struct ResidentAsset
+		{
+			ASSET_TYPE type;
+			std::string name;
+			std::string fileName;
+			std::size_t size; // Estimated bytes in memory (texture width x height x 4, sound samples, font file, 0 for streamed music)
+			unsigned long long lastUsedFrame; // Frame the asset was last loaded, retrieved or marked used in
+			bool isEvicted; // Released to stay under budget, reloaded when it's next retrieved
+		};
+
+		/**
+		 * \brief Progress of the asynchronous loads requested since the last batch finished (a new batch starts when a load is requested with nothing in flight)
 		*/
-		AssetManager( ) { }
+		struct LoadProgress
+		{
+			unsigned int requested; // Loads requested in the batch
+			unsigned int decoded; // Loads read and decoded on the job system
+			unsigned int completed; // Loads uploaded and ready to use (including failed ones)
+			unsigned int failed; // Loads that couldn't be read or decoded
 
-		/** 
+			/**
+			 * \brief Get the fraction of the batch completed
+			 *
+			 * \return Output returns the fraction (0 to 1, 1 when nothing was requested)
+			*/
+			float GetFraction( ) const
+			{ return ( 0 == requested ) ? 1.0f : static_cast<float>( completed ) / requested; }
+
+			/**
+			 * \brief Check if every load in the batch has completed
+			 *
+			 * \return Output returns true if nothing is in flight
+			*/
+			bool IsFinished( ) const
+			{ return completed == requested; }
+		};
+
+		/**
+		 * \brief Class constructor
+		 *
+		 * \param jobs Job system asynchronous loads are decoded on (decoded on the calling thread if nullptr)
+		*/
+		AssetManager( JobSystem *jobs = nullptr );
+
+		/**
 		 * \brief Class destructor
 		*/
-		~AssetManager( ) { }
+		~AssetManager( );
+
+		/**
+		 * \brief Mount an asset pack in the ResourceCache, files it contains are then loaded from the mapped pack instead of being opened (mount packs before loading, later packs take priority)
+		 *
+		 * \param filepath Pack file (built with AssetPack::Build or sonar_pack)
+		 *
+		 * \return Output returns true if the pack was mounted
+		*/
+		bool MountPack( const std::string &filepath );
 
 		/**
-		 * \brief Load a texture in the engine for later use
+		 * \brief Load a texture in the engine for later use (loading a name again reloads it in place and keeps its handle)
 		 *
 		 * \param name Texture name (used to retrieve it)
 		 * \param fileName Filepath and filename to the texture
+		 *
+		 * \return Output returns the texture's handle (invalid if it couldn't be loaded)
+		*/
+		AssetHandle LoadTexture( const std::string &name, const std::string &fileName );
+
+		/**
+		 * \brief Get a texture (reloaded first if it was evicted)
+		 *
+		 * \param handle Texture handle
+		 *
+		 * \return Output returns the requested texture (an empty texture if the handle is stale)
+		*/
+		const sf::Texture &GetTexture( const AssetHandle &handle );
+
+		/**
+		 * \brief Get a texture by name (keep the handle instead when looking it up every frame)
+		 *
+		 * \param name Texture name
+		 *
+		 * \return Output returns the requested texture (an empty texture if it isn't loaded)
 		*/
-		void LoadTexture( const std::string &name, const std::string &fileName );
+		const sf::Texture &GetTexture( const AssetName &name );
 
 		/**
-		 * \brief Get a texture
+		 * \brief Get a texture's handle
 		 *
 		 * \param name Texture name
 		 *
-		 * \return Output returns the requested texture
+		 * \return Output returns the handle (invalid if it isn't loaded)
 		*/
-		const sf::Texture &GetTexture( const std::string &name ) const;
+		AssetHandle GetTextureHandle( const AssetName &name ) const;
 
 		/**
-		 * \brief Load a font in the engine for later use
+		 * \brief Unload a texture, its handle stops resolving
+		 *
+		 * \param handle Texture handle
+		*/
+		void UnloadTexture( const AssetHandle &handle );
+
+		/**
+		 * \brief Load a font in the engine for later use (loading a name again reloads it in place and keeps its handle)
 		 *
 		 * \param name Font name (used to retrieve it)
 		 * \param fileName Filepath and filename to the font
+		 *
+		 * \return Output returns the font's handle (invalid if it couldn't be loaded)
+		*/
+		AssetHandle LoadFont( const std::string &name, const std::string &fileName );
+
+		/**
+		 * \brief Get a font (reloaded first if it was evicted)
+		 *
+		 * \param handle Font handle
+		 *
+		 * \return Output returns the requested font (an empty font if the handle is stale)
+		*/
+		const sf::Font &GetFont( const AssetHandle &handle );
+
+		/**
+		 * \brief Get a font by name (keep the handle instead when looking it up every frame)
+		 *
+		 * \param name Font name
+		 *
+		 * \return Output returns the requested font (an empty font if it isn't loaded)
 		*/
-		void LoadFont( const std::string &name, const std::string &fileName );
+		const sf::Font &GetFont( const AssetName &name );
 
 		/**
-		 * \brief Get a font
+		 * \brief Get a font's handle
 		 *
 		 * \param name Font name
 		 *
-		 * \return Output returns the requested font
+		 * \return Output returns the handle (invalid if it isn't loaded)
 		*/
-		const sf::Font &GetFont( const std::string &name ) const;
+		AssetHandle GetFontHandle( const AssetName &name ) const;
 
 		/**
-		 * \brief Load a sound in the engine for later use
+		 * \brief Unload a font, its handle stops resolving
+		 *
+		 * \param handle Font handle
+		*/
+		void UnloadFont( const AssetHandle &handle );
+
+		/**
+		 * \brief Load a sound in the engine for later use (loading a name again reloads it in place and keeps its handle)
 		 *
 		 * \param name Sound name (used to retrieve it)
 		 * \param fileName Filepath and filename to the sound
+		 *
+		 * \return Output returns the sound's handle (invalid if it couldn't be loaded)
+		*/
+		AssetHandle LoadSound( const std::string &name, const std::string &fileName );
+
+		/**
+		 * \brief Get a sound voice ready to play, voices come from a pool so several sounds can play at once
+		 *
+		 * \param handle Sound handle
+		 *
+		 * \return Output returns a stopped voice (or the longest playing one if they're all busy) with the sound's buffer set
+		*/
+		sf::Sound &GetSound( const AssetHandle &handle );
+
+		/**
+		 * \brief Get a sound voice ready to play by name (keep the handle instead when playing it every frame)
+		 *
+		 * \param name Sound name
+		 *
+		 * \return Output returns a stopped voice (or the longest playing one if they're all busy) with the sound's buffer set
 		*/
-		void LoadSound( const std::string &name, const std::string &fileName );
+		sf::Sound &GetSound( const AssetName &name );
 
 		/**
-		 * \brief Get a sound
+		 * \brief Get a sound's buffer (reloaded first if it was evicted)
+		 *
+		 * \param handle Sound handle
+		 *
+		 * \return Output returns the requested sound buffer (an empty buffer if the handle is stale)
+		*/
+		const sf::SoundBuffer &GetSoundBuffer( const AssetHandle &handle );
+
+		/**
+		 * \brief Get a sound's handle
 		 *
 		 * \param name Sound name
 		 *
-		 * \return Output returns the requested sound
+		 * \return Output returns the handle (invalid if it isn't loaded)
+		*/
+		AssetHandle GetSoundHandle( const AssetName &name ) const;
+
+		/**
+		 * \brief Unload a sound, its handle stops resolving
+		 *
+		 * \param handle Sound handle
 		*/
-		const sf::Sound &GetSound( const std::string &name ) const;
+		void UnloadSound( const AssetHandle &handle );
 
 		/**
-		 * \brief Load a music in the engine for later use
+		 * \brief Load a music in the engine for later use (loading a name again reopens it in place and keeps its handle)
 		 *
 		 * \param name Music name (used to retrieve it)
 		 * \param fileName Filepath and filename to the music
+		 *
+		 * \return Output returns the music's handle (invalid if it couldn't be opened)
 		*/
-		void LoadMusic( const std::string &name, const std::string &fileName );
+		AssetHandle LoadMusic( const std::string &name, const std::string &fileName );
 
 		/**
 		 * \brief Get a music
 		 *
+		 * \param handle Music handle
+		 *
+		 * \return Output returns the requested music (an empty music if the handle is stale)
+		*/
+		sf::Music &GetMusic( const AssetHandle &handle );
+
+		/**
+		 * \brief Get a music by name
+		 *
+		 * \param name Music name
+		 *
+		 * \return Output returns the requested music (an empty music if it isn't loaded)
+		*/
+		sf::Music &GetMusic( const AssetName &name );
+
+		/**
+		 * \brief Get a music's handle
+		 *
 		 * \param name Music name
 		 *
-		 * \return Output returns the requested music
+		 * \return Output returns the handle (invalid if it isn't loaded)
+		*/
+		AssetHandle GetMusicHandle( const AssetName &name ) const;
+
+		/**
+		 * \brief Unload a music, its handle stops resolving
+		 *
+		 * \param handle Music handle
+		*/
+		void UnloadMusic( const AssetHandle &handle );
+
+		/**
+		 * \brief Load a texture on the job system, the image is decoded on a worker and uploaded to the GPU by ProcessUploads
+		 *
+		 * \param name Texture name (used to retrieve it)
+		 * \param fileName Filepath and filename to the texture
+		 *
+		 * \return Output returns a future for the texture's handle
+		*/
+		AssetFuture LoadTextureAsync( const std::string &name, const std::string &fileName );
+
+		/**
+		 * \brief Load a font on the job system, the font file is read and parsed on a worker and added by ProcessUploads
+		 *
+		 * \param name Font name (used to retrieve it)
+		 * \param fileName Filepath and filename to the font
+		 *
+		 * \return Output returns a future for the font's handle
+		*/
+		AssetFuture LoadFontAsync( const std::string &name, const std::string &fileName );
+
+		/**
+		 * \brief Load a sound on the job system, the file is decoded to PCM samples on a worker and uploaded to the audio device by ProcessUploads
+		 *
+		 * \param name Sound name (used to retrieve it)
+		 * \param fileName Filepath and filename to the sound
+		 *
+		 * \return Output returns a future for the sound's handle
+		*/
+		AssetFuture LoadSoundAsync( const std::string &name, const std::string &fileName );
+
+		/**
+		 * \brief Open a music on the job system (only its header is read, the rest streams while playing) and add it in ProcessUploads
+		 *
+		 * \param name Music name (used to retrieve it)
+		 * \param fileName Filepath and filename to the music
+		 *
+		 * \return Output returns a future for the music's handle
+		*/
+		AssetFuture LoadMusicAsync( const std::string &name, const std::string &fileName );
+
+		/**
+		 * \brief Upload decoded asynchronous loads and complete their futures (run once a frame on the thread that draws, in Game.cpp)
+		 *
+		 * \param timeBudget Milliseconds to spend uploading, at least one load is uploaded if any are decoded
+		*/
+		void ProcessUploads( const float &timeBudget = DEFAULT_ASSET_MANAGER_UPLOAD_TIME_BUDGET );
+
+		/**
+		 * \brief Get the progress of the current batch of asynchronous loads (safe to call from any thread)
+		 *
+		 * \return Output returns the progress
+		*/
+		LoadProgress GetLoadProgress( ) const;
+
+		/**
+		 * \brief Mark a texture as used this frame, anything drawing a texture it kept a reference to calls it when drawing so the texture isn't evicted while it's in use (and is reloaded if it was)
+		 *
+		 * \param texture Texture retrieved from the manager (other textures are ignored)
+		*/
+		void MarkUsed( const sf::Texture &texture );
+
+		/**
+		 * \brief Mark a font as used this frame, anything drawing text with a font it kept a reference to calls it when drawing so the font isn't evicted while it's in use (and is reloaded if it was)
+		 *
+		 * \param font Font retrieved from the manager (other fonts are ignored)
+		*/
+		void MarkUsed( const sf::Font &font );
+
+		/**
+		 * \brief Set the memory budget of an asset type, EndFrame evicts the least recently used assets of a type over budget
+		 *
+		 * \param type Asset type (music streams, so its budget is ignored)
+		 * \param bytes Budget in bytes (0 for no budget)
+		*/
+		void SetBudget( const ASSET_TYPE &type, const std::size_t &bytes );
+
+		/**
+		 * \brief Get the memory budget of an asset type
+		 *
+		 * \param type Asset type
+		 *
+		 * \return Output returns the budget in bytes (0 for no budget)
+		*/
+		std::size_t GetBudget( const ASSET_TYPE &type ) const;
+
+		/**
+		 * \brief Get the estimated memory used by the resident assets of a type
+		 *
+		 * \param type Asset type
+		 *
+		 * \return Output returns the size in bytes
+		*/
+		std::size_t GetResidentSize( const ASSET_TYPE &type ) const;
+
+		/**
+		 * \brief Get every loaded asset with its estimated size
+		 *
+		 * \return Output returns the assets, largest first and evicted assets last
+		*/
+		std::vector<ResidentAsset> GetResidentAssets( ) const;
+
+		/**
+		 * \brief Evict the least recently used assets of each type over budget, assets retrieved or marked used this frame are kept (run once a frame on the thread that draws, in Game.cpp)
+		*/
+		void EndFrame( );
+
+		/**
+		 * \brief Show the asset residency window
+		*/
+		void ShowResidencyWindow( );
+
+		/**
+		 * \brief Hide the asset residency window
+		*/
+		void HideResidencyWindow( );
+
+		/**
+		 * \brief Check if the asset residency window is visible
+		 *
+		 * \return Output returns true if the window is visible and false if it isn't
 		*/
-		const sf::Music &GetMusic( const std::string &name ) const;
+		bool IsResidencyWindowVisible( ) const;
+
+		/**
+		 * \brief Draw the asset residency window using ImGui if it's visible (run between ImGui::SFML::Update and ImGui::SFML::Render)
+		*/
+		void DrawResidencyWindow( ) const;
 
 	private:
+
+		/**
+		 * \brief Asynchronous load, filled in by its job and uploaded on the drawing thread
+		*/
+		struct PendingLoad
+		{
+			ASSET_TYPE type;
+			std::string name;
+			std::string fileName;
+			AssetPack *pack = nullptr; // Mounted pack the file is read from (nullptr to open the file)
+			AssetPack::View packed; // Pack bytes the font or music keeps reading from
+			JobSystem::JobRef job; // Decoding job (nullptr when decoded on the requesting thread)
+			bool isDecoded = false; // Set by the job, only read once the job has finished
+			sf::Image image; // Decoded texture
+			std::unique_ptr<sf::Font> font; // Parsed font
+			std::vector<sf::Int16> samples; // Decoded sound
+			unsigned int channelCount = 0;
+			unsigned int sampleRate = 0;
+			std::unique_ptr<sf::Music> music; // Opened music
+			std::promise<AssetHandle> promise;
+		};
+
+		/**
+		 * \brief Queue an asynchronous load and start decoding it
+		 *
+		 * \param type Asset type
+		 * \param name Asset name
+		 * \param fileName Filepath and filename to the asset
+		 *
+		 * \return Output returns a future for the asset's handle
+		*/
+		AssetFuture LoadAsync( const ASSET_TYPE &type, const std::string &name, const std::string &fileName );
+
+		/**
+		 * \brief Read and decode an asynchronous load (run on a job system worker)
+		 *
+		 * \param load Load to decode
+		*/
+		static void Decode( PendingLoad &load );
+
+		/**
+		 * \brief Add a decoded load to its slots
+		 *
+		 * \param load Decoded load
+		 *
+		 * \return Output returns the asset's handle (invalid if it couldn't be loaded)
+		*/
+		AssetHandle Upload( PendingLoad &load );
+
+		/**
+		 * \brief Load an asset into a new slot, or into the existing slot if the name is already loaded
+		 *
+		 * \param slots Slots of the asset type
+		 * \param name Asset name
+		 * \param fileName Filepath and filename the asset is loaded from
+		 * \param load Function that loads the file into an asset and fills in the pack bytes it keeps reading from
+		 *
+		 * \return Output returns the asset's handle (invalid if it couldn't be loaded)
+		*/
+		template<typename T, typename Loader>
+		AssetHandle Load( AssetSlots<T> &slots, const std::string &name, const std::string &fileName, Loader &&load );
+
+		/**
+		 * \brief Record where a loaded asset came from and estimate its size
+		 *
+		 * \param slots Slots of the asset type
+		 * \param handle Asset handle
+		 * \param fileName Filepath and filename the asset was loaded from
+		 * \param source Pack bytes the asset keeps reading from (nullptr if it doesn't need any)
+		 *
+		 * \return Output returns the handle
+		*/
+		template<typename T>
+		AssetHandle Track( AssetSlots<T> &slots, const AssetHandle &handle, const std::string &fileName, const std::shared_ptr<const std::vector<char>> &source );
+
+		/**
+		 * \brief Retrieve an asset, reloading it if it was evicted
+		 *
+		 * \param slots Slots of the asset type
+		 * \param handle Asset handle
+		 *
+		 * \return Output returns the asset (a shared empty asset if the handle is stale)
+		*/
+		template<typename T>
+		T &Use( AssetSlots<T> &slots, const AssetHandle &handle );
+
+		/**
+		 * \brief Evict the least recently used assets of a type until it's under budget
+		 *
+		 * \param slots Slots of the asset type
+		 * \param type Asset type
+		*/
+		template<typename T>
+		void EnforceBudget( AssetSlots<T> &slots, const ASSET_TYPE &type );
+
+		/**
+		 * \brief Add the memory reports of a type's assets
+		 *
+		 * \param slots Slots of the asset type
+		 * \param type Asset type
+		 * \param assets Reports to add to
+		*/
+		template<typename T>
+		void CollectResidentAssets( const AssetSlots<T> &slots, const ASSET_TYPE &type, std::vector<ResidentAsset> &assets ) const;
+
+		/**
+		 * \brief Load a file into an asset, from a mounted pack if one contains it (a failed load leaves the asset as it was)
+		 *
+		 * \param asset Asset to load into
+		 * \param fileName Filepath and filename
+		 * \param source Filled with the pack bytes the asset keeps reading from (fonts and music, nullptr for assets that copy what they decode)
+		 *
+		 * \return Output returns true if the asset was loaded
+		*/
+		bool Read( sf::Texture &asset, const std::string &fileName, std::shared_ptr<const std::vector<char>> &source );
+		bool Read( sf::Font &asset, const std::string &fileName, std::shared_ptr<const std::vector<char>> &source );
+		bool Read( sf::SoundBuffer &asset, const std::string &fileName, std::shared_ptr<const std::vector<char>> &source );
+		bool Read( sf::Music &asset, const std::string &fileName, std::shared_ptr<const std::vector<char>> &source );
+
+		/**
+		 * \brief Estimate the memory an asset keeps loaded
+		 *
+		 * \param asset Loaded asset
+		 * \param fileName Filepath and filename it was loaded from
+		 *
+		 * \return Output returns the size in bytes
+		*/
+		std::size_t EstimateSize( const sf::Texture &asset, const std::string &fileName ) const;
+		std::size_t EstimateSize( const sf::Font &asset, const std::string &fileName ) const;
+		std::size_t EstimateSize( const sf::SoundBuffer &asset, const std::string &fileName ) const;
+		std::size_t EstimateSize( const sf::Music &asset, const std::string &fileName ) const;
+
+		/**
+		 * \brief Release an asset's memory while keeping the object (and references to it) alive
+		 *
+		 * \param asset Asset to release
+		*/
+		static void Release( sf::Texture &asset );
+		static void Release( sf::Font &asset );
+		static void Release( sf::SoundBuffer &asset );
+
+		/**
+		 * \brief Check if a voice is playing a sound buffer
+		 *
+		 * \param buffer Sound buffer
+		 *
+		 * \return Output returns true if a voice is playing or paused on the buffer
+		*/
+		bool IsPlaying( const sf::SoundBuffer &buffer ) const;
+
+		/**
+		 * \brief Find the mounted pack containing a file, packs are shared with the ResourceCache (which keeps them mounted until exit, after the fonts and music streaming from them are gone)
+		 *
+		 * \param fileName Filepath and filename
+		 *
+		 * \return Output returns the pack (nullptr if no mounted pack contains the file)
+		*/
+		AssetPack *FindPack( const std::string &fileName ) const;
+
+		/**
+		 * \brief Textures
+		*/
+		AssetSlots<sf::Texture> _textures;
+
+		/**
+		 * \brief Fonts
+		*/
+		AssetSlots<sf::Font> _fonts;
+
+		/**
+		 * \brief Sound buffers
+		*/
+		AssetSlots<sf::SoundBuffer> _sounds;
+
+		/**
+		 * \brief Musics
+		*/
+		AssetSlots<sf::Music> _musics;
+
+		/**
+		 * \brief Sound voices handed out by GetSound
+		*/
+		std::array<sf::Sound, DEFAULT_ASSET_MANAGER_SOUND_VOICES> _voices;
+
+		/**
+		 * \brief Memory budget of each asset type in bytes (0 for no budget)
+		*/
+		std::array<std::size_t, 4> _budgets;
+
+		/**
+		 * \brief Frames ended so far, assets are stamped with it when they're used
+		*/
+		unsigned long long _frame;
+
+		/**
+		 * \brief Is the residency window visible
+		*/
+		bool _isResidencyWindowVisible;
+
 		/**
-		 * \brief Textures map
+		 * \brief Job system loads are decoded on
 		*/
-		std::map<std::string, sf::Texture> _textures;
+		JobSystem *_jobs;
 
 		/**
-		 * \brief Fonts map
+		 * \brief Asynchronous loads waiting to be uploaded, in the order they were requested
 		*/
-		std::map<std::string, sf::Font> _fonts;
+		std::deque<std::shared_ptr<PendingLoad>> _pendingLoads;
 
 		/**
-		 * \brief Sounds map
+		 * \brief Guards the pending loads and batch counters (loads can be requested and progress read from the simulation thread)
 		*/
-		std::map<std::string, sf::SoundBuffer> _sounds;
+		mutable std::mutex _pendingMutex;
 
 		/**
-		 * \brief Musics map
+		 * \brief Counters of the current batch of loads
 		*/
-		std::map<std::string, sf::Music> _musics;
+		unsigned int _requestedLoads;
+		unsigned int _completedLoads;
+		unsigned int _failedLoads;
 
 	};
 }
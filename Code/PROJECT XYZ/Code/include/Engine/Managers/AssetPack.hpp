@@ -0,0 +1,188 @@
+#pragma once
+
+#include "Core/MappedFile.hpp"
+
+/**
+* \brief Asset pack format
+*/
+#define SONAR_ASSET_PACK_MAGIC "SPAK"
+#define SONAR_ASSET_PACK_VERSION 1
+#define SONAR_ASSET_PACK_FLAG_COMPRESSED 0x1
+
+namespace Sonar
+{
+	/**
+	 * \brief Read only archive of resource files, the file is memory mapped and entries are found through an index loaded when it opens
+	 *
+	 * Layout: a header (magic, version, entry count, index offset), the entries' data, then the index (one record and path per entry).
+	 * Entries can be compressed with the LZ4 block format, compressed entries are decompressed on read and shared by the views of them, they're freed with the last view.
+	 */
+	class AssetPack
+	{
+	public:
+		/**
+		 * \brief Contiguous read only bytes of an entry, valid for as long as the pack stays open and the view (or a copy of it) is kept
+		 */
+		struct View
+		{
+			const char *data = nullptr;
+			std::size_t size = 0;
+			std::shared_ptr<const std::vector<char>> bytes; // Decompressed entry the view keeps alive (nullptr if the view points into the mapped file)
+
+			/**
+			 * \brief Check if the view points to an entry
+			 *
+			 * \return Output returns true if the entry was found
+			 */
+			bool IsValid( ) const
+			{ return nullptr != data; }
+		};
+
+		/**
+		 * \brief Class constructor
+		 */
+		AssetPack( );
+
+		/**
+		 * \brief Class destructor, unmaps the file
+		 */
+		~AssetPack( );
+
+		AssetPack( const AssetPack & ) = delete;
+		AssetPack &operator =( const AssetPack & ) = delete;
+
+		/**
+		 * \brief Map a pack and load its index (any pack already open is closed first)
+		 *
+		 * \param filepath Pack file
+		 *
+		 * \return Output returns true if the pack was opened
+		 */
+		bool Open( const std::string &filepath );
+
+		/**
+		 * \brief Unmap the pack, views into it stop being valid
+		 */
+		void Close( );
+
+		/**
+		 * \brief Check if a pack is open
+		 *
+		 * \return Output returns true if a pack is mapped
+		 */
+		bool IsOpen( ) const;
+
+		/**
+		 * \brief Check if the pack has an entry
+		 *
+		 * \param path Entry path (the path the file would be loaded from, e.g. "Resources/box.png")
+		 *
+		 * \return Output returns true if the entry exists
+		 */
+		bool Contains( const std::string &path ) const;
+
+		/**
+		 * \brief Read an entry (safe to call from several threads)
+		 *
+		 * \param path Entry path
+		 *
+		 * \return Output returns the entry's bytes, straight from the mapped file unless the entry is compressed (invalid if there's no entry), keep the view for as long as the bytes are read
+		 */
+		View Read( const std::string &path );
+
+		/**
+		 * \brief Get the amount of entries
+		 *
+		 * \return Output returns the entry count
+		 */
+		unsigned int GetEntryCount( ) const;
+
+		/**
+		 * \brief Pack every file under some directories, entries are named by their path from the directory's parent ("Resources" packs "Resources/box.png")
+		 *
+		 * \param filepath Pack file to write
+		 * \param directories Directories to pack
+		 * \param isCompressed Compress entries that shrink (audio is always stored so music streams straight from the mapped file)
+		 *
+		 * \return Output returns true if the pack was written
+		 */
+		static bool Build( const std::string &filepath, const std::vector<std::string> &directories, const bool &isCompressed = true );
+
+		/**
+		 * \brief Normalize a path the way entries are named
+		 *
+		 * \param path Path to normalize
+		 *
+		 * \return Output returns the normalized path
+		 */
+		static std::string NormalizePath( const std::string &path );
+
+		/**
+		 * \brief Compress bytes into an LZ4 block
+		 *
+		 * \param data Bytes to compress
+		 * \param size Amount of bytes
+		 *
+		 * \return Output returns the block
+		 */
+		static std::vector<char> Compress( const char *data, const std::size_t &size );
+
+		/**
+		 * \brief Decompress an LZ4 block
+		 *
+		 * \param block Compressed block
+		 * \param blockSize Size of the block
+		 * \param output Buffer to decompress into
+		 * \param size Exact size of the decompressed bytes
+		 *
+		 * \return Output returns true if the block decompressed to exactly size bytes
+		 */
+		static bool Decompress( const char *block, const std::size_t &blockSize, char *output, const std::size_t &size );
+
+	private:
+		/**
+		 * \brief Pack header, at the start of the file
+		 */
+		struct Header
+		{
+			char magic[4];
+			uint32_t version;
+			uint32_t entryCount;
+			uint32_t reserved;
+			uint64_t indexOffset;
+		};
+
+		/**
+		 * \brief Index record, followed by the entry's path
+		 */
+		struct Record
+		{
+			uint64_t offset; // From the start of the file
+			uint64_t storedSize; // Size in the file
+			uint64_t size; // Size once decompressed
+			uint32_t flags;
+			uint32_t pathLength;
+		};
+
+		/**
+		 * \brief Mapped pack
+		 */
+		MappedFile _file;
+
+		/**
+		 * \brief Index by entry path
+		 */
+		std::unordered_map<std::string, Record> _entries;
+
+		/**
+		 * \brief Compressed entries that have been read, by entry path (only views keep them alive)
+		 */
+		std::unordered_map<std::string, std::weak_ptr<const std::vector<char>>> _decompressed;
+
+		/**
+		 * \brief Guards the decompressed entries
+		 */
+		std::mutex _mutex;
+
+	};
+}
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "Managers/AssetHandle.hpp"
+
+namespace Sonar
+{
+	/**
+	 * \brief Dense array of assets addressed by generation checked handles, freed slots are reused
+	 */
+	template<typename T>
+	class AssetSlots
+	{
+	public:
+		/**
+		 * \brief Memory bookkeeping of an asset, used to keep each asset type under its budget
+		 */
+		struct Residency
+		{
+			std::string fileName; // File the asset was loaded from (reloaded from it after being evicted)
+			std::size_t size = 0; // Estimated bytes the asset keeps in memory
+			unsigned long long lastUsedFrame = 0; // Frame the asset was last loaded, retrieved or marked used in
+			bool isEvicted = false; // Has the asset's memory been released until it's used again
+			std::shared_ptr<const std::vector<char>> source; // Decompressed pack entry the asset keeps reading from while it's loaded (fonts), nullptr if it doesn't need one
+		};
+
+		/**
+		 * \brief Class constructor
+		 */
+		AssetSlots( ) { }
+
+		/**
+		 * \brief Class destructor
+		 */
+		~AssetSlots( ) { }
+
+		/**
+		 * \brief Add an asset
+		 *
+		 * \param name Asset name (logged if its hash matches another asset's)
+		 * \param asset Asset to store
+		 *
+		 * \return Output returns the asset's handle (invalid if every slot index is used)
+		 */
+		AssetHandle Add( const std::string &name, std::unique_ptr<T> asset );
+
+		/**
+		 * \brief Remove an asset, its handle stops resolving
+		 *
+		 * \param handle Asset handle
+		 *
+		 * \return Output returns true if the asset was removed
+		 */
+		bool Remove( const AssetHandle &handle );
+
+		/**
+		 * \brief Find an asset
+		 *
+		 * \param handle Asset handle
+		 *
+		 * \return Output returns the asset or nullptr if the handle is stale or invalid
+		 */
+		T *Find( const AssetHandle &handle ) const;
+
+		/**
+		 * \brief Find the handle of a stored asset
+		 *
+		 * \param asset Asset (retrieved from these slots)
+		 *
+		 * \return Output returns the handle (invalid if the asset isn't stored here)
+		 */
+		AssetHandle FindHandle( const T &asset ) const;
+
+		/**
+		 * \brief Get an asset's residency
+		 *
+		 * \param handle Asset handle
+		 *
+		 * \return Output returns the residency or nullptr if the handle is stale or invalid
+		 */
+		Residency *GetResidency( const AssetHandle &handle );
+
+		/**
+		 * \brief Run a function for every asset
+		 *
+		 * \param function Function given each asset's handle, name and residency
+		 */
+		template<typename Function>
+		void ForEach( Function &&function ) const;
+
+		/**
+		 * \brief Get the handle of a named asset
+		 *
+		 * \param name Asset name
+		 *
+		 * \return Output returns the handle (invalid if no asset has the name)
+		 */
+		AssetHandle GetHandle( const AssetName &name ) const;
+
+		/**
+		 * \brief Get the amount of assets stored
+		 *
+		 * \return Output returns the asset count
+		 */
+		unsigned int GetCount( ) const;
+
+	private:
+		/**
+		 * \brief Asset slot
+		 */
+		struct Slot
+		{
+			std::unique_ptr<T> asset; // Asset (kept on the heap so references stay valid when the array grows)
+			std::string name; // Name the asset was added with
+			Residency residency;
+			uint32_t generation = 1; // Bumped when the asset is removed so older handles stop resolving
+		};
+
+		/**
+		 * \brief Slots
+		 */
+		std::vector<Slot> _slots;
+
+		/**
+		 * \brief Indices of empty slots
+		 */
+		std::vector<uint32_t> _freeSlots;
+
+		/**
+		 * \brief Slot index by name hash
+		 */
+		std::unordered_map<uint32_t, uint32_t> _names;
+
+		/**
+		 * \brief Slot index by asset address (assets never move, so anything holding one can look its slot up)
+		 */
+		std::unordered_map<const T *, uint32_t> _indices;
+
+	};
+
+	template<typename T>
+	AssetHandle AssetSlots<T>::Add( const std::string &name, std::unique_ptr<T> asset )
+	{
+		uint32_t index;
+
+		if ( !_freeSlots.empty( ) )
+		{
+			index = _freeSlots.back( );
+			_freeSlots.pop_back( );
+		}
+		else
+		{
+			if ( _slots.size( ) > SONAR_ASSET_HANDLE_INDEX_MASK )
+			{ return AssetHandle( ); }
+
+			index = _slots.size( );
+			_slots.emplace_back( );
+		}
+
+		Slot &slot = _slots.at( index );
+		slot.asset = std::move( asset );
+		slot.name = name;
+
+		const AssetName assetName( name );
+		const auto existing = _names.find( assetName.GetHash( ) );
+
+		if ( _names.end( ) != existing && _slots.at( existing->second ).name != name )
+		{ Debug::LogStatic( "Asset names \"" + name + "\" and \"" + _slots.at( existing->second ).name + "\" have the same hash, \"" + name + "\" replaces it in name lookups" ); }
+
+		_names[assetName.GetHash( )] = index;
+		_indices[slot.asset.get( )] = index;
+
+		return AssetHandle( index, slot.generation );
+	}
+
+	template<typename T>
+	bool AssetSlots<T>::Remove( const AssetHandle &handle )
+	{
+		if ( nullptr == Find( handle ) )
+		{ return false; }
+
+		Slot &slot = _slots.at( handle.GetIndex( ) );
+
+		const auto name = _names.find( AssetName( slot.name ).GetHash( ) );
+
+		if ( _names.end( ) != name && handle.GetIndex( ) == name->second )
+		{ _names.erase( name ); }
+
+		_indices.erase( slot.asset.get( ) );
+
+		slot.asset.reset( );
+		slot.name.clear( );
+		slot.residency = Residency( );
+
+		// Generation 0 would let the slot produce the invalid handle
+		slot.generation = ( slot.generation + 1 ) & SONAR_ASSET_HANDLE_GENERATION_MASK;
+
+		if ( 0 == slot.generation )
+		{ slot.generation = 1; }
+
+		_freeSlots.push_back( handle.GetIndex( ) );
+
+		return true;
+	}
+
+	template<typename T>
+	T *AssetSlots<T>::Find( const AssetHandle &handle ) const
+	{
+		if ( handle.GetIndex( ) >= _slots.size( ) )
+		{ return nullptr; }
+
+		const Slot &slot = _slots[handle.GetIndex( )];
+
+		if ( slot.generation != handle.GetGeneration( ) )
+		{ return nullptr; }
+
+		return slot.asset.get( );
+	}
+
+	template<typename T>
+	AssetHandle AssetSlots<T>::FindHandle( const T &asset ) const
+	{
+		const auto index = _indices.find( &asset );
+
+		if ( _indices.end( ) == index )
+		{ return AssetHandle( ); }
+
+		return AssetHandle( index->second, _slots[index->second].generation );
+	}
+
+	template<typename T>
+	typename AssetSlots<T>::Residency *AssetSlots<T>::GetResidency( const AssetHandle &handle )
+	{
+		if ( nullptr == Find( handle ) )
+		{ return nullptr; }
+
+		return &_slots[handle.GetIndex( )].residency;
+	}
+
+	template<typename T>
+	template<typename Function>
+	void AssetSlots<T>::ForEach( Function &&function ) const
+	{
+		for ( uint32_t index = 0; index < _slots.size( ); index++ )
+		{
+			const Slot &slot = _slots[index];
+
+			if ( nullptr != slot.asset )
+			{ function( AssetHandle( index, slot.generation ), slot.name, slot.residency ); }
+		}
+	}
+
+	template<typename T>
+	AssetHandle AssetSlots<T>::GetHandle( const AssetName &name ) const
+	{
+		const auto index = _names.find( name.GetHash( ) );
+
+		if ( _names.end( ) == index )
+		{ return AssetHandle( ); }
+
+		return AssetHandle( index->second, _slots.at( index->second ).generation );
+	}
+
+	template<typename T>
+	unsigned int AssetSlots<T>::GetCount( ) const
+	{ return _slots.size( ) - _freeSlots.size( ); }
+}
@@ -1,10 +1,86 @@
 #pragma once
 
+#include "Core/MappedFile.hpp"
+#include "Managers/FileWriteQueue.hpp"
+
 namespace Sonar
 {
 	class FileManager
 	{
 	public:
+		/**
+		* \brief Forward iterator over the lines of a mapped file, each line is a view into the mapping (no copies, line endings are left out)
+		*/
+		class LineIterator
+		{
+		public:
+			typedef std::forward_iterator_tag iterator_category;
+			typedef std::string_view value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const std::string_view *pointer;
+			typedef const std::string_view &reference;
+
+			/**
+			 * \brief Class constructor
+			 *
+			 * \param position Start of the line
+			 * \param end End of the file
+			*/
+			LineIterator( const char *position, const char *end );
+
+			const std::string_view &operator *( ) const
+			{ return _line; }
+
+			const std::string_view *operator ->( ) const
+			{ return &_line; }
+
+			LineIterator &operator ++( );
+
+			bool operator ==( const LineIterator &other ) const
+			{ return _position == other._position; }
+
+			bool operator !=( const LineIterator &other ) const
+			{ return _position != other._position; }
+
+		private:
+			/**
+			* \brief Find the end of the line at the current position
+			*/
+			void ReadLine( );
+
+			const char *_position; // Start of the current line
+			const char *_next; // Start of the next line
+			const char *_end; // End of the file
+			std::string_view _line; // Current line
+
+		};
+
+		/**
+		* \brief Lines of a mapped file for range based for loops (valid until the file manager maps another file or writes to this one)
+		*/
+		class LineRange
+		{
+		public:
+			/**
+			 * \brief Class constructor
+			 *
+			 * \param begin Start of the file
+			 * \param end End of the file
+			*/
+			LineRange( const char *begin, const char *end ) : _begin( begin ), _end( end ) { }
+
+			LineIterator begin( ) const
+			{ return LineIterator( _begin, _end ); }
+
+			LineIterator end( ) const
+			{ return LineIterator( _end, _end ); }
+
+		private:
+			const char *_begin;
+			const char *_end;
+
+		};
+
 		/**
 		* \brief How should the data be written to the file
 		*/
@@ -71,7 +147,18 @@ namespace Sonar
 		void WriteToFile( const std::string &filepath, const std::vector<std::string> &data, const WRITE_PROPERTY &writeProperty = WRITE_PROPERTY::ADD_TO_NEW_LINE, const bool &createIfDoesntExist = true, const bool &overwriteIfExists = false );
 
 		/**
-		* \brief Get all the file's data
+		* \brief Replace the file's contents on the background I/O thread, the file is swapped in whole so a crash never leaves it half written
+		*
+		* \param filePath File path of the file
+		* \param data New contents of the file
+		* \param callback [OPTIONAL] Called on the I/O thread once the file has been written
+		*
+		* \return Output returns a future set once the file has been written (true if it was written)
+		*/
+		std::shared_future<bool> WriteToFileAsync( const std::string &filepath, const std::string &data, const FileWriteQueue::Callback &callback = nullptr );
+
+		/**
+		* \brief Get all the file's data (copies every line, iterate GetLines instead for large files)
 		*
 		* \return Output returns the while file data
 		*/
@@ -87,7 +174,54 @@ namespace Sonar
 		*/
 		std::string GetLineFromFile( const std::string &filepath,const unsigned int &lineNumber );
 
+		/**
+		* \brief Get a specific line from the file without copying it, the file stays mapped and its line index is built on first use so later lines are found in constant time
+		*
+		* \param filePath File path of the file
+		* \param lineNumber The line to get (0 is the first line, an invalid line number returns an empty view)
+		*
+		* \return Output returns a view of the line, valid until the file manager maps another file or writes to this one
+		*/
+		std::string_view GetLineView( const std::string &filepath, const unsigned int &lineNumber );
+
+		/**
+		* \brief Get the amount of lines in the file
+		*
+		* \param filePath File path of the file
+		*
+		* \return Output returns the line count (0 if the file couldn't be opened)
+		*/
+		unsigned int GetLineCount( const std::string &filepath );
+
+		/**
+		* \brief Get the file's lines to iterate over without copying them or building the line index
+		*
+		* \param filePath File path of the file
+		*
+		* \return Output returns the lines (empty if the file couldn't be opened)
+		*/
+		LineRange GetLines( const std::string &filepath );
+
 	private:
+		/**
+		* \brief Map a file for reading once any queued write to it has finished, the current mapping is reused until the file changes on disk
+		*
+		* \param filePath File path of the file
+		*
+		* \return Output returns true if the file is mapped
+		*/
+		bool MapFile( const std::string &filepath );
+
+		/**
+		* \brief Unmap the mapped file and drop its line index
+		*/
+		void UnmapFile( );
+
+		/**
+		* \brief Build the line index of the mapped file if it hasn't been built yet
+		*/
+		void IndexLines( );
+
 		/**
 		* \brief Open a file (call again to get updated version of the contents)
 		*
@@ -109,9 +243,29 @@ namespace Sonar
 		std::fstream _file;
 
 		/**
-		* \brief Loaded file data stored in memory
+		* \brief File mapped for reading
+		*/
+		MappedFile _mappedFile;
+
+		/**
+		* \brief File path of the mapped file
+		*/
+		std::string _mappedFilepath;
+
+		/**
+		* \brief Last write time of the mapped file when it was mapped
+		*/
+		std::filesystem::file_time_type _mappedWriteTime;
+
+		/**
+		* \brief Offset of the start of each line in the mapped file
+		*/
+		std::vector<std::size_t> _lineOffsets;
+
+		/**
+		* \brief Has the line index of the mapped file been built
 		*/
-		std::vector<std::string> _fileData;
+		bool _isIndexed;
 
 		/**
 		* \brief File status (default is CLOSED)
@@ -0,0 +1,153 @@
+#pragma once
+
+namespace Sonar
+{
+	/**
+	 * \brief Write behind queue, files are saved on a background I/O thread so saving never stalls a frame
+	 *
+	 * Writes replace the whole file through a temporary file that's flushed to disk and renamed over the original,
+	 * so a crash mid save leaves either the old or the new file. Writes to a path that's still queued are coalesced, only the latest data is written.
+	 */
+	class FileWriteQueue
+	{
+	public:
+		/**
+		 * \brief Called on the I/O thread once a write has finished
+		 *
+		 * \param isWritten True if the file was written
+		 */
+		typedef std::function<void( const bool &isWritten )> Callback;
+
+		/**
+		 * \brief Get the queue instance (shared by every thread)
+		 *
+		 * \return Output returns the queue
+		 */
+		static FileWriteQueue *getInstance( );
+
+		/**
+		 * \brief Class destructor, finishes the queued writes and joins the I/O thread
+		 */
+		~FileWriteQueue( );
+
+		FileWriteQueue( const FileWriteQueue & ) = delete;
+		FileWriteQueue &operator =( const FileWriteQueue & ) = delete;
+
+		/**
+		 * \brief Queue a write that replaces a file's contents
+		 *
+		 * \param filepath File to write
+		 * \param data New contents of the file
+		 * \param callback [OPTIONAL] Called on the I/O thread once the write has finished
+		 *
+		 * \return Output returns a future set once the write has finished (true if the file was written), a coalesced write shares the future of the write it joined
+		 */
+		std::shared_future<bool> Write( const std::string &filepath, std::string data, const Callback &callback = nullptr );
+
+		/**
+		 * \brief Wait for a file's queued write to finish, returns straight away if nothing is queued for it (call before reading a file that may be being saved)
+		 *
+		 * \param filepath File to wait for
+		 */
+		void Wait( const std::string &filepath );
+
+		/**
+		 * \brief Wait for every queued write to finish
+		 */
+		void Flush( );
+
+		/**
+		 * \brief Get the amount of writes queued or being written
+		 *
+		 * \return Output returns the pending write count
+		 */
+		unsigned int GetPendingCount( ) const;
+
+		/**
+		 * \brief Replace a file's contents on the calling thread via a temporary file, flushing it to disk before renaming it over the original
+		 *
+		 * \param filepath File to write
+		 * \param data New contents of the file
+		 *
+		 * \return Output returns true if the file was written
+		 */
+		static bool WriteAtomically( const std::string &filepath, const std::string &data );
+
+	private:
+		/**
+		 * \brief Class constructor, starts the I/O thread
+		 */
+		FileWriteQueue( );
+
+		/**
+		 * \brief Queued write
+		 */
+		struct Request
+		{
+			std::string data;
+			std::vector<Callback> callbacks;
+			std::shared_ptr<std::promise<bool>> promise;
+			std::shared_future<bool> future;
+		};
+
+		/**
+		 * \brief I/O thread loop
+		 */
+		void Run( );
+
+		/**
+		 * \brief Check if a file has a write queued or being written (lock _mutex first)
+		 *
+		 * \param filepath File to check
+		 *
+		 * \return Output returns true if the file has a pending write
+		 */
+		bool IsPending( const std::string &filepath ) const;
+
+		/**
+		 * \brief Paths in the order they were first queued
+		 */
+		std::deque<std::string> _order;
+
+		/**
+		 * \brief Queued writes by path
+		 */
+		std::unordered_map<std::string, Request> _requests;
+
+		/**
+		 * \brief Path being written by the I/O thread (empty if none)
+		 */
+		std::string _writingFilepath;
+
+		/**
+		 * \brief Amount of writes queued or being written, checked without locking so reads of files that aren't being saved don't wait
+		 */
+		std::atomic<unsigned int> _pendingCount;
+
+		/**
+		 * \brief Keeps the I/O thread running
+		 */
+		bool _isRunning;
+
+		/**
+		 * \brief Guards the queue
+		 */
+		mutable std::mutex _mutex;
+
+		/**
+		 * \brief Wakes the I/O thread when a write is queued
+		 */
+		std::condition_variable _queuedCondition;
+
+		/**
+		 * \brief Wakes waiting threads when a write finishes
+		 */
+		std::condition_variable _finishedCondition;
+
+		/**
+		 * \brief I/O thread
+		 */
+		std::thread _thread;
+
+	};
+}
@@ -51,7 +51,7 @@ namespace Sonar
 		void SaveScore( const std::string &filepath, const long long &score, const std::string &name );
 
 		/**
-		* \brief Checks if the score is greater than any scores in the list
+		* \brief Checks if the score is greater than any scores in the list (binary search, the scores are sorted highest first)
 		*
 		* \param scores Scores to check the new score against
 		* \param score Score to check if is a new score
@@ -96,7 +96,7 @@ namespace Sonar
 		void UpdateScores( const unsigned int &position, const long long &score, const std::string &name );
 
 		/**
-		* \brief Save the file with the local scores
+		* \brief Save the file with the local scores on the background I/O thread
 		*
 		* \param filePath File path of the scores file
 		*/
@@ -117,5 +117,10 @@ namespace Sonar
 		*/
 		unsigned int _maxNumOfHighScores;
 
+		/**
+		* \brief File the scores in memory were loaded from or saved to (saving to it again skips reloading it)
+		*/
+		std::string _loadedFilepath;
+
 	};
 }
@@ -0,0 +1,265 @@
+#pragma once
+
+#include "Managers/HighScoreManager.hpp"
+
+/**
+* \brief Leaderboard file format
+*/
+#define SONAR_LEADERBOARD_MAGIC "SLBD"
+#define SONAR_LEADERBOARD_VERSION 1
+
+namespace Sonar
+{
+	/**
+	 * \brief Leaderboard of each player's best score, built to hold millions of entries
+	 *
+	 * Entries are kept in an order statistic tree (a treap whose nodes know their subtree size) so submitting, ranking and paging are O(log n).
+	 * Higher scores rank first, equal scores rank in the order they were reached.
+	 *
+	 * File layout: a header (magic, version) followed by records (score, date time, name length, name), each improved score is appended as a record.
+	 * Once most records have been superseded the file is compacted to one record per player, written on the background I/O thread.
+	 */
+	class Leaderboard
+	{
+	public:
+		/**
+		 * \brief Class constructor, the leaderboard is kept in memory only until a file is opened
+		 */
+		Leaderboard( );
+
+		/**
+		 * \brief Class destructor, finishes writing and closes the file
+		 */
+		~Leaderboard( );
+
+		Leaderboard( const Leaderboard & ) = delete;
+		Leaderboard &operator =( const Leaderboard & ) = delete;
+
+		/**
+		 * \brief Load a leaderboard file, new scores are appended to it (any file already open is closed first, a missing file is created)
+		 *
+		 * \param filepath Leaderboard file
+		 *
+		 * \return Output returns true if the file was opened
+		 */
+		bool Open( const std::string &filepath );
+
+		/**
+		 * \brief Finish writing and close the file, the leaderboard is cleared
+		 */
+		void Close( );
+
+		/**
+		 * \brief Check if a file is open
+		 *
+		 * \return Output returns true if scores are being saved to a file
+		 */
+		bool IsOpen( ) const;
+
+		/**
+		 * \brief Submit a score, it only replaces the player's entry if it beats their best
+		 *
+		 * \param name Name of the player
+		 * \param score Score reached
+		 *
+		 * \return Output returns the player's new rank (0 is first) or -1 if the score didn't beat their best
+		 */
+		int Submit( const std::string &name, const long long &score );
+
+		/**
+		 * \brief Get a player's rank
+		 *
+		 * \param name Name of the player
+		 *
+		 * \return Output returns the rank (0 is first) or -1 if the player has no entry
+		 */
+		int GetRank( const std::string &name ) const;
+
+		/**
+		 * \brief Get the rank a score would have if it was submitted now by a new player
+		 *
+		 * \param score Score to rank
+		 *
+		 * \return Output returns the amount of entries with a higher score
+		 */
+		unsigned int GetRankOfScore( const long long &score ) const;
+
+		/**
+		 * \brief Get the entry at a rank
+		 *
+		 * \param rank Rank of the entry (0 is first)
+		 * \param entry Entry to fill in
+		 *
+		 * \return Output returns true if there's an entry at the rank
+		 */
+		bool GetEntry( const unsigned int &rank, ScoreInfo &entry ) const;
+
+		/**
+		 * \brief Get a page of entries
+		 *
+		 * \param page Page index (0 is the top of the leaderboard)
+		 * \param pageSize Entries per page
+		 *
+		 * \return Output returns the page's entries in rank order (fewer than the page size on the last page)
+		 */
+		std::vector<ScoreInfo> GetPage( const unsigned int &page, const unsigned int &pageSize = DEFAULT_LEADERBOARD_PAGE_SIZE ) const;
+
+		/**
+		 * \brief Get the amount of entries
+		 *
+		 * \return Output returns the entry count
+		 */
+		unsigned int GetCount( ) const;
+
+		/**
+		 * \brief Rewrite the file with one record per player on the background I/O thread (runs by itself once most records have been superseded)
+		 */
+		void Compact( );
+
+	private:
+		/**
+		 * \brief Tree node for a player's best score
+		 */
+		struct Entry
+		{
+			const std::string *name = nullptr; // Key in _players
+			long long score = 0;
+			unsigned long long dateTime = 0;
+			unsigned long long sequence = 0; // Order the score was reached in, breaks ties
+			uint32_t priority = 0; // Heap priority keeping the tree balanced
+			uint32_t left = 0; // Child node indices (0 is no child)
+			uint32_t right = 0;
+			uint32_t size = 0; // Amount of nodes in the subtree
+		};
+
+		/**
+		 * \brief Set a player's best score if it beats their current best
+		 *
+		 * \param name Name of the player
+		 * \param score Score reached
+		 * \param dateTime Date time the score was reached at
+		 *
+		 * \return Output returns the player's node or 0 if the score wasn't their best
+		 */
+		uint32_t Apply( const std::string &name, const long long &score, const unsigned long long &dateTime );
+
+		/**
+		 * \brief Check if a node ranks ahead of another
+		 */
+		bool Precedes( const uint32_t &node, const uint32_t &other ) const;
+
+		/**
+		 * \brief Recalculate a node's subtree size from its children
+		 */
+		void Resize( const uint32_t &node );
+
+		/**
+		 * \brief Join two trees, every node of the left tree ranks ahead of the right tree
+		 *
+		 * \return Output returns the joined tree
+		 */
+		uint32_t Merge( const uint32_t &left, const uint32_t &right );
+
+		/**
+		 * \brief Split a tree into the nodes that rank ahead of a key node and the rest (the tree is taken by value since it's often one of the outputs)
+		 */
+		void Split( const uint32_t node, const uint32_t &key, uint32_t &left, uint32_t &right );
+
+		/**
+		 * \brief Remove the first node of a tree
+		 *
+		 * \return Output returns the tree without it
+		 */
+		uint32_t RemoveFirst( const uint32_t &node );
+
+		/**
+		 * \brief Add a node to the tree
+		 */
+		void Insert( const uint32_t &node );
+
+		/**
+		 * \brief Take a node out of the tree
+		 */
+		void Erase( const uint32_t &node );
+
+		/**
+		 * \brief Add the entries of a subtree with a rank in [begin, end)
+		 *
+		 * \param node Subtree
+		 * \param offset Rank of the subtree's first node
+		 */
+		void Collect( const uint32_t &node, const unsigned int &offset, const unsigned int &begin, const unsigned int &end, std::vector<ScoreInfo> &entries ) const;
+
+		/**
+		 * \brief Add the records of a subtree in rank order
+		 */
+		void WriteSnapshot( const uint32_t &node, std::string &snapshot ) const;
+
+		/**
+		 * \brief Append a player's record
+		 */
+		void AppendRecord( const uint32_t &node, std::string &records ) const;
+
+		/**
+		 * \brief Write the records waiting in memory to the end of the file, they wait until a queued compaction has finished
+		 */
+		void WriteRecords( );
+
+		/**
+		 * \brief Get a node's entry
+		 */
+		ScoreInfo GetScoreInfo( const uint32_t &node ) const;
+
+		/**
+		 * \brief Tree nodes, node 0 is an empty node standing in for no child
+		 */
+		std::vector<Entry> _entries;
+
+		/**
+		 * \brief Node by player name
+		 */
+		std::unordered_map<std::string, uint32_t> _players;
+
+		/**
+		 * \brief Root node
+		 */
+		uint32_t _root;
+
+		/**
+		 * \brief Next score's sequence number
+		 */
+		unsigned long long _sequence;
+
+		/**
+		 * \brief Generates node priorities
+		 */
+		std::mt19937 _random;
+
+		/**
+		 * \brief Leaderboard file
+		 */
+		std::string _filepath;
+		std::ofstream _file;
+
+		/**
+		 * \brief Amount of records in the file
+		 */
+		unsigned int _recordCount;
+
+		/**
+		 * \brief Records not written to the file yet
+		 */
+		std::string _unwrittenRecords;
+
+		/**
+		 * \brief Queued compaction (invalid if none)
+		 */
+		std::shared_future<bool> _compaction;
+
+		/**
+		 * \brief Is a file open
+		 */
+		bool _isOpen;
+
+	};
+}
@@ -1,14 +1,42 @@
 #pragma once
 
+#include "Core/MappedFile.hpp"
+
+/**
+* \brief Binary map format
+*/
+#define SONAR_MAP_MAGIC "SMAP"
+#define SONAR_MAP_VERSION 1
+
+/**
+* \brief Width and height of a map chunk in cells
+*/
+#define SONAR_MAP_CHUNK_SIZE 32
+
 namespace Sonar
 {
+	/**
+	* \brief Value of a map cell
+	*/
+	typedef uint16_t MapCell;
+
+	/**
+	* \brief Layered 2D map, each layer is stored as fixed size square chunks in one contiguous array so neighbouring cells share cache lines
+	*
+	* Binary layout: a header (magic, version, size x, size y, layer count, chunk size) followed by the cells exactly as they're stored in memory,
+	* so a loaded map reads its cells straight from the mapped file and only copies them the first time a cell is changed.
+	*/
 	class MapManager
 	{
 	public:
 		/**
 		 * \brief Default class constructor
+		 *
+		 * \param arraySizeX Map width in cells
+		 * \param arraySizeY Map height in cells
+		 * \param layerCount [OPTIONAL] Amount of layers
 		*/
-		MapManager( const int &arraySizeX, const int &arraySizeY );
+		MapManager( const int &arraySizeX, const int &arraySizeY, const unsigned int &layerCount = 1 );
 
 		/**
 		 * \brief Class destructor
@@ -16,11 +44,11 @@ namespace Sonar
 		~MapManager( );
 
 		/**
-		* \brief Set all the map spaces with a specific value (overrides the entire map)
+		* \brief Set all the map spaces with a specific value (overrides the entire map, every layer)
 		*
 		* \param value Value to be inserted in the map
 		*/
-		void InitializeMapWithAValue( const char &value );
+		void InitializeMapWithAValue( const MapCell &value );
 
 		/**
 		* \brief Set a map value at a specific position
@@ -28,32 +56,71 @@ namespace Sonar
 		* \param value Value to be inserted in the map
 		* \param posX X position in the map
 		* \param posY Y position in the map
+		* \param layer [OPTIONAL] Layer to set the value in
 		*/
-		void SetValue( const char &value, const unsigned int &posX, const unsigned int &posY );
+		void SetValue( const MapCell &value, const unsigned int &posX, const unsigned int &posY, const unsigned int &layer = 0 );
 
 		/**
 		* \brief Get a map value at a specific position
 		*
 		* \param posX X position in the map
 		* \param posY Y position in the map
+		* \param layer [OPTIONAL] Layer to get the value from
+		*
+		* \return Output returns a map value (' ' if the position is outside the map)
+		*/
+		MapCell GetValue( const unsigned int &posX, const unsigned int &posY, const unsigned int &layer = 0 ) const;
+
+		/**
+		* \brief Get a chunk's cells, stored row by row (cells past the edge of the map are ' ')
+		*
+		* \param chunkX X position of the chunk in chunks
+		* \param chunkY Y position of the chunk in chunks
+		* \param layer [OPTIONAL] Layer of the chunk
+		*
+		* \return Output returns SONAR_MAP_CHUNK_SIZE * SONAR_MAP_CHUNK_SIZE cells or nullptr if there's no such chunk
+		*/
+		const MapCell *GetChunk( const unsigned int &chunkX, const unsigned int &chunkY, const unsigned int &layer = 0 ) const;
+
+		/**
+		* \brief Get a chunk's version, it changes whenever a cell in the chunk does (used to only rebuild what changed)
+		*
+		* \param chunkX X position of the chunk in chunks
+		* \param chunkY Y position of the chunk in chunks
+		* \param layer [OPTIONAL] Layer of the chunk
+		*
+		* \return Output returns the version (0 if there's no such chunk)
+		*/
+		unsigned long long GetChunkVersion( const unsigned int &chunkX, const unsigned int &chunkY, const unsigned int &layer = 0 ) const;
+
+		/**
+		* \brief Save the map in the binary format on the background I/O thread
+		*
+		* \param filePath File path of the file
 		*
-		* \return Output returns a map value
+		* \return Output returns a future set once the map has been written (true if it was written)
 		*/
-		char GetValue( const unsigned int &posX, const unsigned int &posY ) const;
+		std::shared_future<bool> SaveMap( const std::string &filepath );
 
 		/**
-		* \brief Save the map array
+		* \brief Load a map, binary maps are memory mapped and used as they are and anything else is imported as CSV
 		*
 		* \param filePath File path of the file
+		*
+		* \return Output returns true if the map was loaded
 		*/
-		void SaveMap( const std::string &filepath );
+		bool LoadMap( const std::string &filepath );
 
 		/**
-		* \brief Load the map array
+		* \brief Import a map from CSV, one row per line and one cell per field (slow, meant for authoring)
+		*
+		* A single character field is stored as that character, a longer field is read as a number.
 		*
 		* \param filePath File path of the file
+		*
+		* \return Output returns true if the map was imported
 		*/
-		void LoadMap( const std::string &filepath );
+		bool ImportCSV( const std::string &filepath );
 
 		/**
 		* \brief Get the map size
@@ -76,21 +143,106 @@ namespace Sonar
 		*/
 		unsigned int GetSizeY( ) const;
 
+		/**
+		* \brief Get the amount of layers
+		*
+		* \return Output returns the layer count
+		*/
+		unsigned int GetLayerCount( ) const;
+
+		/**
+		* \brief Get the amount of chunks across and down the map
+		*
+		* \return Output returns the chunk count on each axis
+		*/
+		glm::uvec2 GetChunkCount( ) const;
+
 	private:
 		/**
-		* \brief Delete the map pointer
+		* \brief Binary map header, at the start of the file
 		*/
-		void DeleteMapPointer( );
+		struct Header
+		{
+			char magic[4];
+			uint32_t version;
+			uint32_t sizeX;
+			uint32_t sizeY;
+			uint32_t layerCount;
+			uint32_t chunkSize;
+		};
 
 		/**
-		* \brief 2D map of dynamic size
+		* \brief Size the map and fill it with empty cells (drops any mapped file)
+		*
+		* \param sizeX Map width in cells
+		* \param sizeY Map height in cells
+		* \param layerCount Amount of layers
 		*/
-		char **_map;
+		void Resize( const unsigned int &sizeX, const unsigned int &sizeY, const unsigned int &layerCount );
+
+		/**
+		* \brief Get the amount of cells stored, including the cells of edge chunks past the edge of the map
+		*
+		* \return Output returns the cell count
+		*/
+		std::size_t GetCellCount( ) const;
+
+		/**
+		* \brief Get the index of a cell in the cell array
+		*
+		* \return Output returns the index
+		*/
+		std::size_t GetIndex( const unsigned int &posX, const unsigned int &posY, const unsigned int &layer ) const;
+
+		/**
+		* \brief Copy mapped cells into the map's own storage so they can be changed
+		*/
+		void DetachFromFile( );
+
+		/**
+		* \brief Give every chunk a new version (after the whole map changed)
+		*/
+		void ChangeAllChunks( );
+
+		/**
+		* \brief Cells owned by the map (empty while they're read from a mapped file)
+		*/
+		std::vector<MapCell> _storage;
+
+		/**
+		* \brief Cells being read, either the storage or the mapped file
+		*/
+		const MapCell *_cells;
+
+		/**
+		* \brief Binary map the cells are read from
+		*/
+		MappedFile _mappedFile;
 
 		/**
 		* \brief Size of the 2D map
 		*/
 		glm::uvec2 _arraySize;
 
+		/**
+		* \brief Amount of chunks across and down the map
+		*/
+		glm::uvec2 _chunkCount;
+
+		/**
+		* \brief Amount of layers
+		*/
+		unsigned int _layerCount;
+
+		/**
+		* \brief Version of each chunk, by layer then row of chunks
+		*/
+		std::vector<unsigned long long> _chunkVersions;
+
+		/**
+		* \brief Last version given to a chunk, versions only go up so a chunk never returns to a version it had
+		*/
+		unsigned long long _lastVersion;
+
 	};
 }
@@ -6,9 +6,22 @@
 
 #define _CRT_SECURE_NO_WARNINGS
 
+#include "AI/FlowField.hpp"
+#include "AI/FlowFieldCache.hpp"
+#include "AI/NavigationGrid.hpp"
+#include "AI/Pathfinder.hpp"
+#include "Core/AllocationCounter.hpp"
 #include "Core/Clock.hpp"
 #include "Core/Debug.hpp"
+#include "Core/FrameAllocator.hpp"
+#include "Core/FrameStats.hpp"
 #include "Core/Game.hpp"
+#include "Core/HeadlessRunner.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/LoadingState.hpp"
+#include "Core/MappedFile.hpp"
+#include "Core/Profiler.hpp"
+#include "Core/SnapshotBuffer.hpp"
 #include "Core/State.hpp"
 #include "Core/StateMachine.hpp"
 #include "Core/Time.hpp"
@@ -21,6 +34,7 @@
 #include "Graphics/Button.hpp"
 #include "Graphics/ButtonGroup.hpp"
 #include "Graphics/Checkbox.hpp"
+#include "Graphics/CollisionWorld.hpp"
 #include "Graphics/Color.hpp"
 #include "Graphics/Drawable.hpp"
 #include "Graphics/Font.hpp"
@@ -32,18 +46,23 @@
 #include "Graphics/ProgressBar.hpp"
 #include "Graphics/RadioButton.hpp"
 #include "Graphics/RadioButtonGroup.hpp"
+#include "Graphics/ResourceCache.hpp"
 #include "Graphics/ScrollingBackground.hpp"
 #include "Graphics/Shapes/Circle.hpp"
 #include "Graphics/Shapes/Rectangle.hpp"
 #include "Graphics/Shapes/Triangle.hpp"
 #include "Graphics/Slider.hpp"
 #include "Graphics/Sprite.hpp"
+#include "Graphics/SpriteBatch.hpp"
 #include "Graphics/TextBox.hpp"
 #include "Graphics/Texture.hpp"
+#include "Graphics/TextureAtlas.hpp"
+#include "Graphics/TileMap.hpp"
 #include "Graphics/View.hpp"
 #include "Input/Events.hpp"
 #include "Input/Gesture.hpp"
 #include "Input/Input.hpp"
+#include "Input/InputRecorder.hpp"
 #include "Input/Joystick.hpp"
 #include "Input/Keyboard.hpp"
 #include "Input/Mouse.hpp"
@@ -51,8 +70,13 @@
 #include "Input/RBM.hpp"
 #include "Input/Sensor.hpp"
 #include "Input/Sequence.hpp"
+#include "Managers/AssetHandle.hpp"
 #include "Managers/AssetManager.hpp"
+#include "Managers/AssetPack.hpp"
+#include "Managers/AssetSlots.hpp"
 #include "Managers/FileManager.hpp"
+#include "Managers/FileWriteQueue.hpp"
 #include "Managers/HighScoreManager.hpp"
+#include "Managers/Leaderboard.hpp"
 #include "Managers/MapManager.hpp"
 
@@ -9,18 +9,34 @@
 */
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstring>
 #include <ctime>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <initializer_list>
+#include <iterator>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
+#include <random>
 #include <sstream>
 #include <stack>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 /**
@@ -49,11 +65,19 @@
 #include "Core/ENGINEDEFINITIONS.hpp"
 #include "Core/Time.hpp"
 #include "Core/Clock.hpp"
+#include "Core/MappedFile.hpp"
+#include "Core/AllocationCounter.hpp"
+#include "Core/FrameAllocator.hpp"
+#include "Core/FrameStats.hpp"
+#include "Core/Profiler.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/SnapshotBuffer.hpp"
 #include "External/Collision.hpp"
 #include "External/csv.hpp"
 #include "External/Gamepad.h"
 #include "External/json.hpp"
 #include "Graphics/Color.hpp"
+#include "Graphics/ResourceCache.hpp"
 #include "Graphics/Font.hpp"
 #include "Graphics/ScrollingBackground.hpp"
 #include "Graphics/Parallax.hpp"
@@ -65,7 +89,10 @@
 #include "Input/Mouse.hpp"
 #include "Input/Sequence.hpp"
 #include "Graphics/Drawable.hpp"
+#include "Graphics/CollisionWorld.hpp"
 #include "Graphics/Texture.hpp"
+#include "Graphics/TextureAtlas.hpp"
+#include "Graphics/SpriteBatch.hpp"
 #include "Graphics/Sprite.hpp"
 #include "Graphics/Shapes/Triangle.hpp"
 #include "Graphics/Shapes/Rectangle.hpp"
@@ -75,6 +102,7 @@
 #include "Input/RBM.hpp"
 #include "Input/Sensor.hpp"
 #include "Input/Events.hpp"
+#include "Input/InputRecorder.hpp"
 #include "Core/Window.hpp"
 #include "Graphics/TextBox.hpp"
 #include "Core/State.hpp"
@@ -91,6 +119,15 @@
 #include "Input/Input.hpp"
 #include "Managers/AssetManager.hpp"
 #include "Managers/FileManager.hpp"
+#include "Managers/FileWriteQueue.hpp"
 #include "Managers/HighScoreManager.hpp"
+#include "Managers/Leaderboard.hpp"
 #include "Managers/MapManager.hpp"
-#include "Core/Game.hpp"
\ No newline at end of file
+#include "Graphics/TileMap.hpp"
+#include "AI/NavigationGrid.hpp"
+#include "AI/Pathfinder.hpp"
+#include "AI/FlowField.hpp"
+#include "AI/FlowFieldCache.hpp"
+#include "Core/Game.hpp"
+#include "Core/HeadlessRunner.hpp"
+#include "Core/LoadingState.hpp"
\ No newline at end of file
@@ -9,9 +9,13 @@ namespace Sonar
         
         void HandleInput( float dt );
         void Update( float dt );
-        void Draw( float dt );
+        void Draw( float interpolation );
         
     private:
+		// Snapshot IDs the rectangles' transforms are published under
+		static constexpr unsigned int PLAYER_SNAPSHOT_ID = 0;
+		static constexpr unsigned int OBJECT2_SNAPSHOT_ID = 1;
+
 		Rectangle *_player;
 		Rectangle *object2;
 
@@ -0,0 +1,87 @@
+#include "pch.hpp"
+#include "Benchmark.hpp"
+
+namespace Sonar
+{
+	Benchmark::Benchmark( const unsigned int &samples, const double &minSampleTime )
+	{
+		_samples = std::max( 1u, samples );
+		_minSampleTime = minSampleTime;
+	}
+
+	Benchmark::~Benchmark( ) { }
+
+	void Benchmark::SetFilter( const std::string &filter )
+	{ _filter = filter; }
+
+	const std::vector<Benchmark::Result> &Benchmark::GetResults( ) const
+	{ return _results; }
+
+	bool Benchmark::WriteJSON( const std::string &filepath ) const
+	{
+		nlohmann::json json;
+
+		json["suite"] = "sonar_bench";
+		json["timestamp"] = static_cast<long long>( std::time( nullptr ) );
+		json["hardwareThreads"] = std::thread::hardware_concurrency( );
+
+	#ifdef __VERSION__
+		json["compiler"] = __VERSION__;
+	#endif
+
+	#ifdef NDEBUG
+		json["buildType"] = "release";
+	#else
+		json["buildType"] = "debug";
+	#endif
+
+		json["benchmarks"] = nlohmann::json::array( );
+
+		for ( const auto &result : _results )
+		{
+			json["benchmarks"].push_back( {
+				{ "name", result.name },
+				{ "iterationsPerSample", result.iterationsPerSample },
+				{ "samples", result.samples },
+				{ "unit", "ns" },
+				{ "min", result.minTime },
+				{ "median", result.medianTime },
+				{ "mean", result.meanTime },
+				{ "max", result.maxTime }
+			} );
+		}
+
+		std::ofstream file( filepath, std::ios::out | std::ios::trunc );
+
+		if ( !file.is_open( ) )
+		{ return false; }
+
+		file << json.dump( 4 ) << std::endl;
+
+		return file.good( );
+	}
+
+	void Benchmark::AddResult( const std::string &name, const unsigned long long int &iterations, std::vector<double> &sampleTimes )
+	{
+		for ( auto &time : sampleTimes )
+		{ time = time * 1000000000.0 / iterations; }
+
+		std::sort( sampleTimes.begin( ), sampleTimes.end( ) );
+
+		Result result;
+		result.name = name;
+		result.iterationsPerSample = iterations;
+		result.samples = sampleTimes.size( );
+		result.minTime = sampleTimes.front( );
+		result.maxTime = sampleTimes.back( );
+		result.meanTime = std::accumulate( sampleTimes.begin( ), sampleTimes.end( ), 0.0 ) / sampleTimes.size( );
+
+		const size_t middle = sampleTimes.size( ) / 2;
+		result.medianTime = ( 0 == sampleTimes.size( ) % 2 ) ? ( sampleTimes.at( middle - 1 ) + sampleTimes.at( middle ) ) / 2.0 : sampleTimes.at( middle );
+
+		_results.push_back( result );
+
+		// Goes to stderr so it isn't lost among the output of the logging benchmarks
+		std::cerr << name << ": " << result.medianTime << " ns median (" << result.minTime << " min, " << result.maxTime << " max, " << iterations << " iterations per sample)" << std::endl;
+	}
+}
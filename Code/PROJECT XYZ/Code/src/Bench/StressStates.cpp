@@ -0,0 +1,396 @@
+#include "pch.hpp"
+#include "StressStates.hpp"
+
+namespace
+{
+	/**
+	 * \brief Deterministic start position spread over an area so every run draws the same scene
+	 *
+	 * \param index Object index
+	 * \param area Width and height to spread the objects over
+	 *
+	 * \return Output returns the position
+	 */
+	glm::vec2 ScatterPosition( const unsigned int &index, const glm::vec2 &area )
+	{
+		// Golden ratio steps fill the area evenly without a visible grid
+		const float x = std::fmod( index * 0.618034f, 1.0f );
+		const float y = std::fmod( index * 0.754878f, 1.0f );
+
+		return glm::vec2( x * area.x, y * area.y );
+	}
+
+	/**
+	 * \brief Deterministic velocity in pixels per second
+	 *
+	 * \param index Object index
+	 *
+	 * \return Output returns the velocity
+	 */
+	glm::vec2 ScatterVelocity( const unsigned int &index )
+	{
+		const float angle = index * 2.399963f;
+		const float speed = 50.0f + ( index % 7 ) * 25.0f;
+
+		return glm::vec2( std::cos( angle ) * speed, std::sin( angle ) * speed );
+	}
+
+	/**
+	 * \brief Move an object and bounce it off the window edges
+	 *
+	 * \param object Object to move
+	 * \param velocity Object's velocity, flipped when it hits an edge
+	 * \param dt Delta time
+	 * \param windowSize Window width and height
+	 */
+	template<typename T>
+	void Bounce( T *object, glm::vec2 &velocity, const float &dt, const glm::uvec2 &windowSize )
+	{
+		object->Move( velocity * dt );
+
+		if ( ( object->GetPositionX( ) < 0 && velocity.x < 0 ) || ( object->GetPositionX( ) + object->GetWidth( ) > windowSize.x && velocity.x > 0 ) )
+		{ velocity.x = -velocity.x; }
+
+		if ( ( object->GetPositionY( ) < 0 && velocity.y < 0 ) || ( object->GetPositionY( ) + object->GetHeight( ) > windowSize.y && velocity.y > 0 ) )
+		{ velocity.y = -velocity.y; }
+	}
+
+	/**
+	 * \brief Deterministic colour so neighbouring objects can be told apart
+	 *
+	 * \param index Object index
+	 *
+	 * \return Output returns the colour
+	 */
+	Sonar::Color ScatterColor( const unsigned int &index )
+	{ return Sonar::Color( ( index * 67 ) % 256, ( index * 151 ) % 256, ( index * 223 ) % 256 ); }
+}
+
+namespace Sonar
+{
+	SpriteStressState::SpriteStressState( GameDataRef data, const unsigned int &count ) : _data( data ), _count( count ) { }
+
+	SpriteStressState::~SpriteStressState( )
+	{
+		for ( auto sprite : _sprites )
+		{ delete sprite; }
+	}
+
+	void SpriteStressState::Init( )
+	{
+		const glm::vec2 windowSize( _data->window.GetSize( ) );
+
+		_sprites.reserve( _count );
+		_velocities.reserve( _count );
+
+		for ( unsigned int i = 0; i < _count; i++ )
+		{
+			Sprite *sprite = new Sprite( _data, DEFAULT_STRESS_SPRITE_TEXTURE );
+			sprite->SetScale( 0.25f, 0.25f );
+			sprite->SetPosition( ScatterPosition( i, windowSize - sprite->GetSize( ) * 0.25f ) );
+
+			_sprites.push_back( sprite );
+			_velocities.push_back( ScatterVelocity( i ) );
+		}
+	}
+
+	void SpriteStressState::PollInput( const float &dt, Event &event ) { }
+
+	void SpriteStressState::Update( const float &dt )
+	{
+		const glm::uvec2 windowSize = _data->window.GetSize( );
+
+		for ( unsigned int i = 0; i < _sprites.size( ); i++ )
+		{ Bounce( _sprites.at( i ), _velocities.at( i ), dt, windowSize ); }
+	}
+
+	void SpriteStressState::Draw( const float &dt )
+	{
+		for ( auto sprite : _sprites )
+		{ sprite->Draw( ); }
+	}
+
+	ShapeStressState::ShapeStressState( GameDataRef data, const unsigned int &count ) : _data( data ), _count( count ) { }
+
+	ShapeStressState::~ShapeStressState( )
+	{
+		for ( auto rectangle : _rectangles )
+		{ delete rectangle; }
+
+		for ( auto circle : _circles )
+		{ delete circle; }
+
+		for ( auto triangle : _triangles )
+		{ delete triangle; }
+	}
+
+	void ShapeStressState::Init( )
+	{
+		const glm::vec2 area = glm::vec2( _data->window.GetSize( ) ) - glm::vec2( 24.0f, 24.0f );
+
+		_velocities.reserve( _count );
+
+		for ( unsigned int i = 0; i < _count; i++ )
+		{
+			if ( 0 == i % 3 )
+			{
+				Rectangle *rectangle = new Rectangle( _data, 24.0f, 16.0f );
+				rectangle->SetInsideColor( ScatterColor( i ) );
+				rectangle->SetPosition( ScatterPosition( i, area ) );
+
+				_rectangles.push_back( rectangle );
+			}
+			else if ( 1 == i % 3 )
+			{
+				Circle *circle = new Circle( _data, 8.0f );
+				circle->SetInsideColor( ScatterColor( i ) );
+				circle->SetPosition( ScatterPosition( i, area ) );
+
+				_circles.push_back( circle );
+			}
+			else
+			{
+				Triangle *triangle = new Triangle( _data, glm::vec2( 12.0f, 0.0f ), glm::vec2( 24.0f, 20.0f ), glm::vec2( 0.0f, 20.0f ) );
+				triangle->SetInsideColor( ScatterColor( i ) );
+				triangle->SetPosition( ScatterPosition( i, area ) );
+
+				_triangles.push_back( triangle );
+			}
+
+			_velocities.push_back( ScatterVelocity( i ) );
+		}
+	}
+
+	void ShapeStressState::PollInput( const float &dt, Event &event ) { }
+
+	void ShapeStressState::Update( const float &dt )
+	{
+		const glm::uvec2 windowSize = _data->window.GetSize( );
+
+		// Velocities are stored in creation order, which interleaves the three shape types
+		for ( unsigned int i = 0; i < _rectangles.size( ); i++ )
+		{
+			Bounce( _rectangles.at( i ), _velocities.at( i * 3 ), dt, windowSize );
+			_rectangles.at( i )->Rotate( 90.0f * dt );
+		}
+
+		for ( unsigned int i = 0; i < _circles.size( ); i++ )
+		{ Bounce( _circles.at( i ), _velocities.at( i * 3 + 1 ), dt, windowSize ); }
+
+		for ( unsigned int i = 0; i < _triangles.size( ); i++ )
+		{
+			Bounce( _triangles.at( i ), _velocities.at( i * 3 + 2 ), dt, windowSize );
+			_triangles.at( i )->Rotate( -90.0f * dt );
+		}
+	}
+
+	void ShapeStressState::Draw( const float &dt )
+	{
+		for ( auto rectangle : _rectangles )
+		{ rectangle->Draw( ); }
+
+		for ( auto circle : _circles )
+		{ circle->Draw( ); }
+
+		for ( auto triangle : _triangles )
+		{ triangle->Draw( ); }
+	}
+
+	LabelStressState::LabelStressState( GameDataRef data, const unsigned int &count ) : _data( data ), _count( count ) { }
+
+	LabelStressState::~LabelStressState( )
+	{
+		for ( auto label : _labels )
+		{ delete label; }
+	}
+
+	void LabelStressState::Init( )
+	{
+		const glm::vec2 area = glm::vec2( _data->window.GetSize( ) ) - glm::vec2( 80.0f, 20.0f );
+
+		_labels.reserve( _count );
+		_velocities.reserve( _count );
+
+		for ( unsigned int i = 0; i < _count; i++ )
+		{
+			Label *label = new Label( _data, DEFAULT_STRESS_FONT );
+			label->SetCharacterSize( 14 );
+			label->SetInsideColor( ScatterColor( i ) );
+			label->SetText( "Label " + std::to_string( i ) );
+			label->SetPosition( ScatterPosition( i, area ) );
+
+			_labels.push_back( label );
+			_velocities.push_back( ScatterVelocity( i ) );
+		}
+	}
+
+	void LabelStressState::PollInput( const float &dt, Event &event ) { }
+
+	void LabelStressState::Update( const float &dt )
+	{
+		const glm::uvec2 windowSize = _data->window.GetSize( );
+
+		for ( unsigned int i = 0; i < _labels.size( ); i++ )
+		{ Bounce( _labels.at( i ), _velocities.at( i ), dt, windowSize ); }
+	}
+
+	void LabelStressState::Draw( const float &dt )
+	{
+		for ( auto label : _labels )
+		{ label->Draw( ); }
+	}
+
+	ParallaxStressState::ParallaxStressState( GameDataRef data, const unsigned int &layerCount ) : _data( data ), _layerCount( layerCount )
+	{ _parallax = nullptr; }
+
+	ParallaxStressState::~ParallaxStressState( )
+	{ delete _parallax; }
+
+	void ParallaxStressState::Init( )
+	{
+		_parallax = new Parallax( _data );
+
+		for ( unsigned int i = 0; i < _layerCount; i++ )
+		{
+			_parallax->AddLayer( std::vector<std::string>{ DEFAULT_STRESS_BACKGROUND_TEXTURE, DEFAULT_STRESS_BACKGROUND_TEXTURE } );
+			_parallax->SetSpeed( i, 20.0f + i * 10.0f );
+		}
+	}
+
+	void ParallaxStressState::PollInput( const float &dt, Event &event ) { }
+
+	void ParallaxStressState::Update( const float &dt )
+	{ _parallax->Update( dt ); }
+
+	void ParallaxStressState::Draw( const float &dt )
+	{ _parallax->Draw( ); }
+
+	MinimapStressState::MinimapStressState( GameDataRef data, const unsigned int &count ) : _data( data ), _count( count )
+	{ _minimap = nullptr; }
+
+	MinimapStressState::~MinimapStressState( )
+	{ delete _minimap; }
+
+	void MinimapStressState::Init( )
+	{
+		const glm::vec2 mapSize( DEFAULT_STRESS_MINIMAP_MAP_SIZE, DEFAULT_STRESS_MINIMAP_MAP_SIZE );
+
+		_minimap = new Minimap( _data );
+		_minimap->SetBackgroundSize( 512.0f, 512.0f );
+		_minimap->SetPosition( Minimap::POSITION::CENTER );
+		_minimap->SetMapSize( mapSize );
+
+		_ids.reserve( _count );
+		_positions.reserve( _count );
+		_velocities.reserve( _count );
+
+		for ( unsigned int i = 0; i < _count; i++ )
+		{
+			const glm::vec2 position = ScatterPosition( i, mapSize );
+
+			_ids.push_back( _minimap->AddObject( "Unit", position, 2.0f, ScatterColor( i ) ) );
+			_positions.push_back( position );
+			_velocities.push_back( ScatterVelocity( i ) );
+		}
+	}
+
+	void MinimapStressState::PollInput( const float &dt, Event &event ) { }
+
+	void MinimapStressState::Update( const float &dt )
+	{
+		for ( unsigned int i = 0; i < _ids.size( ); i++ )
+		{
+			glm::vec2 &position = _positions.at( i );
+			glm::vec2 &velocity = _velocities.at( i );
+
+			position += velocity * dt;
+
+			if ( ( position.x < 0 && velocity.x < 0 ) || ( position.x > DEFAULT_STRESS_MINIMAP_MAP_SIZE && velocity.x > 0 ) )
+			{ velocity.x = -velocity.x; }
+
+			if ( ( position.y < 0 && velocity.y < 0 ) || ( position.y > DEFAULT_STRESS_MINIMAP_MAP_SIZE && velocity.y > 0 ) )
+			{ velocity.y = -velocity.y; }
+
+			_minimap->UpdateObjectPositionByID( _ids.at( i ), position );
+		}
+
+		_minimap->Update( dt );
+	}
+
+	void MinimapStressState::Draw( const float &dt )
+	{ _minimap->Draw( ); }
+
+	TileMapStressState::TileMapStressState( GameDataRef data, const unsigned int &size ) : _data( data ), _size( size )
+	{
+		_map = nullptr;
+		_tileMap = nullptr;
+		_changeCount = 0;
+	}
+
+	TileMapStressState::~TileMapStressState( )
+	{
+		_data->window.SetDefaultView( );
+
+		delete _tileMap;
+		delete _map;
+	}
+
+	void TileMapStressState::Init( )
+	{
+		_map = new MapManager( _size, _size );
+
+		for ( unsigned int y = 0; y < _size; y++ )
+		{
+			for ( unsigned int x = 0; x < _size; x++ )
+			{ _map->SetValue( ( x * 7 + y * 13 ) % 5, x, y ); }
+		}
+
+		// The texture is split into 2x2 tiles, value 4 is left empty
+		_tileset.loadFromFile( DEFAULT_STRESS_SPRITE_TEXTURE );
+
+		_tileMap = new TileMap( _data, _map );
+		_tileMap->SetTileFunction( []( const MapCell &value ) { return ( value < 4 ) ? static_cast<int>( value ) : -1; } );
+		_tileMap->SetTileset( &_tileset, glm::max( glm::uvec2( _tileset.getSize( ).x, _tileset.getSize( ).y ) / 2u, glm::uvec2( 1 ) ) );
+		_tileMap->SetCellSize( glm::vec2( DEFAULT_STRESS_TILE_MAP_CELL_SIZE ) );
+
+		const glm::vec2 windowSize( _data->window.GetSize( ) );
+		_view = sf::View( sf::FloatRect( 0.0f, 0.0f, windowSize.x, windowSize.y ) );
+
+		_velocity = glm::normalize( glm::vec2( 1.0f, 0.6f ) ) * DEFAULT_STRESS_TILE_MAP_SCROLL_SPEED;
+	}
+
+	void TileMapStressState::PollInput( const float &dt, Event &event ) { }
+
+	void TileMapStressState::Update( const float &dt )
+	{
+		const float mapSize = _size * DEFAULT_STRESS_TILE_MAP_CELL_SIZE;
+		const glm::vec2 halfSize = glm::vec2( _view.getSize( ).x, _view.getSize( ).y ) * 0.5f;
+
+		_view.move( _velocity.x * dt, _velocity.y * dt );
+
+		const sf::Vector2f center = _view.getCenter( );
+
+		if ( ( center.x - halfSize.x < 0 && _velocity.x < 0 ) || ( center.x + halfSize.x > mapSize && _velocity.x > 0 ) )
+		{ _velocity.x = -_velocity.x; }
+
+		if ( ( center.y - halfSize.y < 0 && _velocity.y < 0 ) || ( center.y + halfSize.y > mapSize && _velocity.y > 0 ) )
+		{ _velocity.y = -_velocity.y; }
+
+		// A handful of changes under the view, only their chunks are rebuilt
+		for ( unsigned int i = 0; i < 8; i++ )
+		{
+			const glm::vec2 position = glm::vec2( center.x, center.y ) - halfSize + ScatterPosition( _changeCount++, halfSize * 2.0f );
+
+			_map->SetValue( _changeCount % 5, position.x / DEFAULT_STRESS_TILE_MAP_CELL_SIZE, position.y / DEFAULT_STRESS_TILE_MAP_CELL_SIZE );
+		}
+	}
+
+	void TileMapStressState::Draw( const float &dt )
+	{
+		_data->window.GetSFMLWindowObject( ).setView( _view );
+
+		_tileMap->Draw( );
+
+		_data->window.SetDefaultView( );
+	}
+}
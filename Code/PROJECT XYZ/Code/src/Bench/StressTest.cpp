@@ -0,0 +1,244 @@
+#include "pch.hpp"
+#include "StressTest.hpp"
+
+#include <SFML/OpenGL.hpp>
+
+namespace Sonar
+{
+	StressTest::StressTest( const unsigned int &width, const unsigned int &height, const unsigned int &frames, const unsigned int &warmupFrames )
+	{
+		_frames = std::max( 1u, frames );
+		_warmupFrames = warmupFrames;
+
+		_data = std::make_shared<GameData>( );
+		_data->debug = Debug::getInstance( );
+
+		Window::Style style;
+		style.resize = false;
+
+		_data->window.Setup( width, height, "sonar_stress", style );
+
+		// Frames should take as long as the scene needs, not as long as the display refresh
+		_data->window.SetVerticalSyncEnabled( false );
+		_data->window.SetFramerateLimit( 0 );
+	}
+
+	StressTest::~StressTest( )
+	{ _data->window.CloseWindow( ); }
+
+	GameDataRef StressTest::GetGameData( ) const
+	{ return _data; }
+
+	void StressTest::SetFilter( const std::string &filter )
+	{ _filter = filter; }
+
+	bool StressTest::IsSelected( const std::string &name ) const
+	{ return _filter.empty( ) || std::string::npos != name.find( _filter ); }
+
+	bool StressTest::Run( const std::string &name, const unsigned int &objectCount, StateRef state )
+	{
+		if ( !IsSelected( name ) )
+		{ return true; }
+
+		_data->machine.AddState( std::move( state ), true );
+		_data->machine.ProcessStateChanges( );
+
+		std::vector<FrameStats::Frame> frames;
+		frames.reserve( _frames );
+
+		for ( unsigned int i = 0; i < _warmupFrames + _frames; i++ )
+		{
+			if ( !_data->window.IsOpen( ) )
+			{ return false; }
+
+			const FrameStats::Frame frame = RunFrame( );
+
+			if ( i >= _warmupFrames )
+			{ frames.push_back( frame ); }
+		}
+
+		AddResult( name, objectCount, frames );
+
+		return true;
+	}
+
+	const std::vector<StressTest::Result> &StressTest::GetResults( ) const
+	{ return _results; }
+
+	bool StressTest::WriteJSON( const std::string &filepath ) const
+	{
+		nlohmann::json json;
+
+		json["suite"] = "sonar_stress";
+		json["timestamp"] = static_cast<long long>( std::time( nullptr ) );
+		json["windowWidth"] = _data->window.GetSize( ).x;
+		json["windowHeight"] = _data->window.GetSize( ).y;
+
+		// Shows whether the run was on a GPU or a software rasteriser such as llvmpipe
+		const GLubyte *vendor = glGetString( GL_VENDOR );
+		const GLubyte *renderer = glGetString( GL_RENDERER );
+
+		json["glVendor"] = nullptr != vendor ? reinterpret_cast<const char *>( vendor ) : "";
+		json["glRenderer"] = nullptr != renderer ? reinterpret_cast<const char *>( renderer ) : "";
+
+	#ifdef __VERSION__
+		json["compiler"] = __VERSION__;
+	#endif
+
+	#ifdef NDEBUG
+		json["buildType"] = "release";
+	#else
+		json["buildType"] = "debug";
+	#endif
+
+		json["scenes"] = nlohmann::json::array( );
+
+		for ( const auto &result : _results )
+		{
+			json["scenes"].push_back( {
+				{ "name", result.name },
+				{ "objectCount", result.objectCount },
+				{ "frames", result.frames },
+				{ "unit", "ms" },
+				{ "frameTime", {
+					{ "min", result.minFrameTime },
+					{ "p50", result.p50FrameTime },
+					{ "p95", result.p95FrameTime },
+					{ "p99", result.p99FrameTime },
+					{ "max", result.maxFrameTime },
+					{ "mean", result.meanFrameTime }
+				} },
+				{ "updateTimeP50", result.p50UpdateTime },
+				{ "drawTimeP50", result.p50DrawTime },
+				{ "drawCalls", {
+					{ "p50", result.p50DrawCalls },
+					{ "p99", result.p99DrawCalls },
+					{ "max", result.maxDrawCalls },
+					{ "mean", result.meanDrawCalls }
+				} },
+				{ "vertexCountMean", result.meanVertexCount }
+			} );
+		}
+
+		std::ofstream file( filepath, std::ios::out | std::ios::trunc );
+
+		if ( !file.is_open( ) )
+		{ return false; }
+
+		file << json.dump( 4 ) << std::endl;
+
+		return file.good( );
+	}
+
+	FrameStats::Frame StressTest::RunFrame( )
+	{
+		SONAR_PROFILE_SCOPE( "Stress Frame" );
+
+		const long long frameStart = _clock.GetElapsedTime( ).AsMicroseconds( );
+
+		_data->frameAllocator.Reset( );
+
+		FrameStats::Frame &stats = _data->frameStats.GetCurrentFrame( );
+
+		_data->machine.ProcessStateChanges( );
+
+		StateRef &state = _data->machine.GetActiveState( );
+
+		long long sectionStart = _clock.GetElapsedTime( ).AsMicroseconds( );
+
+		{
+			Sonar::Event event;
+
+			while ( _data->window.PollEvent( event ) )
+			{
+				if ( Sonar::Event::EventType::Closed == event.type )
+				{ _data->window.CloseWindow( ); }
+
+				state->PollInput( _dt, event );
+			}
+		}
+
+		state->Update( _dt );
+		_data->snapshots.Publish( );
+		stats.fixedSteps = 1;
+
+		stats.updateTime = Time::MicrosecondsToMilliseconds( _clock.GetElapsedTime( ).AsMicroseconds( ) - sectionStart );
+
+		_data->window.Clear( _data->backgroundColor );
+
+		sectionStart = _clock.GetElapsedTime( ).AsMicroseconds( );
+
+		_data->snapshots.Acquire( );
+		state->Draw( 1.0f );
+
+		_data->spriteBatch.Flush( _data->window.GetSFMLWindowObject( ) );
+		_data->spriteBatch.EndFrame( );
+
+		stats.drawCalls += _data->spriteBatch.GetDrawCallCount( );
+		stats.vertexCount += _data->spriteBatch.GetVertexCount( );
+
+		// The software rasteriser does most of its work when the buffers are swapped, so Display counts as drawing
+		_data->window.Display( );
+
+		stats.drawTime = Time::MicrosecondsToMilliseconds( _clock.GetElapsedTime( ).AsMicroseconds( ) - sectionStart );
+		stats.frameTime = Time::MicrosecondsToMilliseconds( _clock.GetElapsedTime( ).AsMicroseconds( ) - frameStart );
+		stats.frameAllocatorBytes = _data->frameAllocator.GetUsedBytes( );
+
+		const FrameStats::Frame frame = stats;
+
+		_data->frameStats.EndFrame( );
+		Profiler::getInstance( )->EndFrame( );
+
+		return frame;
+	}
+
+	void StressTest::AddResult( const std::string &name, const unsigned int &objectCount, const std::vector<FrameStats::Frame> &frames )
+	{
+		std::vector<float> frameTimes, updateTimes, drawTimes;
+		std::vector<unsigned int> drawCalls;
+
+		frameTimes.reserve( frames.size( ) );
+		updateTimes.reserve( frames.size( ) );
+		drawTimes.reserve( frames.size( ) );
+		drawCalls.reserve( frames.size( ) );
+
+		double vertexCountSum = 0.0;
+
+		for ( const auto &frame : frames )
+		{
+			frameTimes.push_back( frame.frameTime );
+			updateTimes.push_back( frame.updateTime );
+			drawTimes.push_back( frame.drawTime );
+			drawCalls.push_back( frame.drawCalls );
+			vertexCountSum += frame.vertexCount;
+		}
+
+		std::sort( frameTimes.begin( ), frameTimes.end( ) );
+		std::sort( updateTimes.begin( ), updateTimes.end( ) );
+		std::sort( drawTimes.begin( ), drawTimes.end( ) );
+		std::sort( drawCalls.begin( ), drawCalls.end( ) );
+
+		Result result;
+		result.name = name;
+		result.objectCount = objectCount;
+		result.frames = frames.size( );
+		result.minFrameTime = frameTimes.front( );
+		result.p50FrameTime = Percentile( frameTimes, 50.0f );
+		result.p95FrameTime = Percentile( frameTimes, 95.0f );
+		result.p99FrameTime = Percentile( frameTimes, 99.0f );
+		result.maxFrameTime = frameTimes.back( );
+		result.meanFrameTime = std::accumulate( frameTimes.begin( ), frameTimes.end( ), 0.0 ) / frameTimes.size( );
+		result.p50UpdateTime = Percentile( updateTimes, 50.0f );
+		result.p50DrawTime = Percentile( drawTimes, 50.0f );
+		result.p50DrawCalls = Percentile( drawCalls, 50.0f );
+		result.p99DrawCalls = Percentile( drawCalls, 99.0f );
+		result.maxDrawCalls = drawCalls.back( );
+		result.meanDrawCalls = std::accumulate( drawCalls.begin( ), drawCalls.end( ), 0.0 ) / drawCalls.size( );
+		result.meanVertexCount = vertexCountSum / frames.size( );
+
+		_results.push_back( result );
+
+		std::cerr << name << " (" << objectCount << " objects): " << result.p50FrameTime << " ms p50, " << result.p95FrameTime << " ms p95, "
+			<< result.p99FrameTime << " ms p99, " << result.p50DrawCalls << " draw calls p50" << std::endl;
+	}
+}
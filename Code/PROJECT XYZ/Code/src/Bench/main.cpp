@@ -0,0 +1,315 @@
+#include "pch.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+	/**
+	 * \brief Write a test map as CSV (the format MapManager::ImportCSV reads)
+	 *
+	 * \param filepath File to write
+	 * \param width Map width
+	 * \param height Map height
+	 */
+	void WriteTestMap( const std::string &filepath, const unsigned int &width, const unsigned int &height )
+	{
+		std::ofstream file( filepath, std::ios::out | std::ios::trunc );
+
+		for ( unsigned int y = 0; y < height; y++ )
+		{
+			for ( unsigned int x = 0; x < width; x++ )
+			{ file << ( ( 0 == ( x + y ) % 7 ) ? '#' : '.' ) << ( ( x + 1 < width ) ? "," : "" ); }
+
+			file << "\n";
+		}
+	}
+
+	/**
+	 * \brief Write a text file with numbered lines
+	 *
+	 * \param filepath File to write
+	 * \param lineCount Amount of lines
+	 */
+	void WriteTestLines( const std::string &filepath, const unsigned int &lineCount )
+	{
+		std::ofstream file( filepath, std::ios::out | std::ios::trunc );
+
+		for ( unsigned int i = 0; i < lineCount; i++ )
+		{ file << "Line " << i << " of the benchmark text file\n"; }
+	}
+}
+
+int main( int argc, char *argv[] )
+{
+	std::string outputFilepath = "sonar_bench.json";
+
+	Sonar::Benchmark benchmark;
+
+	for ( int i = 1; i < argc; i++ )
+	{
+		const std::string argument = argv[i];
+
+		if ( "--output" == argument && i + 1 < argc )
+		{ outputFilepath = argv[++i]; }
+		else if ( "--filter" == argument && i + 1 < argc )
+		{ benchmark.SetFilter( argv[++i] ); }
+		else
+		{
+			std::cerr << "Usage: sonar_bench [--output results.json] [--filter name]" << std::endl;
+
+			return EXIT_FAILURE;
+		}
+	}
+
+	const std::filesystem::path directory = std::filesystem::temp_directory_path( ) / "sonar_bench";
+	std::filesystem::create_directories( directory );
+
+	// Nothing here opens the window, GameData is only needed to construct drawables
+	Sonar::GameDataRef data = std::make_shared<Sonar::GameData>( );
+	data->debug = Sonar::Debug::getInstance( );
+
+	// Collision
+	{
+		Sonar::Rectangle first( data, 64.0f, 64.0f ), second( data, 64.0f, 64.0f );
+		first.SetPosition( 100.0f, 100.0f );
+		second.SetPosition( 132.0f, 132.0f );
+
+		benchmark.Run( "Drawable::BoundingBoxCollision", [&]( ) { Sonar::Benchmark::DoNotOptimize( first.BoundingBoxCollision( second ) ); } );
+
+		Sonar::Circle firstCircle( data, 32.0f ), secondCircle( data, 32.0f );
+		firstCircle.SetPosition( 100.0f, 100.0f );
+		secondCircle.SetPosition( 132.0f, 132.0f );
+
+		benchmark.Run( "Drawable::CircleCollision", [&]( ) { Sonar::Benchmark::DoNotOptimize( firstCircle.CircleCollision( secondCircle ) ); } );
+
+		// 2000 rectangles spread over a 1080p window, every pair tested against the broadphase
+		std::vector<std::unique_ptr<Sonar::Rectangle>> rectangles;
+		Sonar::CollisionWorld world( DEFAULT_COLLISION_WORLD_CELL_SIZE, &data->jobs );
+
+		for ( unsigned int i = 0; i < 2000; i++ )
+		{
+			rectangles.push_back( std::make_unique<Sonar::Rectangle>( data, 24.0f, 24.0f ) );
+			rectangles.back( )->SetPosition( std::fmod( i * 0.618034f, 1.0f ) * 1920.0f, std::fmod( i * 0.754878f, 1.0f ) * 1080.0f );
+			world.Add( rectangles.back( ).get( ) );
+		}
+
+		unsigned long long pairCount = 0;
+
+		benchmark.Run( "Drawable::BoundingBoxCollision (all pairs, 2000 rectangles)", [&]( )
+		{
+			pairCount = 0;
+
+			for ( std::size_t i = 0; i < rectangles.size( ); i++ )
+			{
+				for ( std::size_t j = i + 1; j < rectangles.size( ); j++ )
+				{ pairCount += rectangles[i]->BoundingBoxCollision( *rectangles[j] ); }
+			}
+
+			Sonar::Benchmark::DoNotOptimize( pairCount );
+		} );
+
+		std::vector<Sonar::CollisionWorld::CollisionPair> pairs;
+
+		benchmark.Run( "CollisionWorld::GetPairs (2000 rectangles)", [&]( ) { world.GetPairs( pairs ); } );
+
+		float offset = 1.0f;
+
+		benchmark.Run( "CollisionWorld::GetPairs (2000 rectangles, all moved)", [&]( )
+		{
+			offset = -offset;
+
+			for ( const auto &rectangle : rectangles )
+			{ rectangle->Move( offset, offset ); }
+
+			world.GetPairs( pairs );
+		} );
+
+		std::vector<glm::vec4> queries;
+
+		for ( unsigned int i = 0; i < 256; i++ )
+		{ queries.push_back( glm::vec4( std::fmod( i * 0.381966f, 1.0f ) * 1920.0f, std::fmod( i * 0.569840f, 1.0f ) * 1080.0f, 96.0f, 96.0f ) ); }
+
+		std::vector<std::vector<Sonar::Drawable *>> overlaps;
+
+		benchmark.Run( "CollisionWorld::QueryOverlaps (256 areas, 2000 rectangles)", [&]( ) { world.QueryOverlaps( queries, overlaps ); } );
+	}
+
+	// Sprite setters
+	{
+		Sonar::Sprite sprite( data );
+		float value = 0.0f;
+
+		benchmark.Run( "Sprite::SetPosition", [&]( ) { sprite.SetPosition( value, value ); value += 1.0f; } );
+		benchmark.Run( "Sprite::SetRotation", [&]( ) { sprite.SetRotation( value ); value += 1.0f; } );
+		benchmark.Run( "Sprite::SetScale", [&]( ) { sprite.SetScale( 1.0f, 2.0f ); } );
+		benchmark.Run( "Sprite::SetColor", [&]( ) { sprite.SetColor( Sonar::Color::Red ); } );
+		benchmark.Run( "Sprite::SetPivot", [&]( ) { sprite.SetPivot( Sonar::OBJECT_POINTS::CENTER ); } );
+	}
+
+	// Managers
+	{
+		const std::string mapFilepath = ( directory / "map.csv" ).string( );
+		WriteTestMap( mapFilepath, 64, 64 );
+
+		Sonar::MapManager map( 64, 64 );
+
+		benchmark.Run( "MapManager::ImportCSV (64x64)", [&]( ) { map.ImportCSV( mapFilepath ); } );
+
+		const std::string binaryMapFilepath = ( directory / "map.smap" ).string( );
+		map.SaveMap( binaryMapFilepath ).wait( );
+
+		benchmark.Run( "MapManager::LoadMap (64x64, binary)", [&]( ) { map.LoadMap( binaryMapFilepath ); } );
+
+		const std::string scoresFilepath = ( directory / "scores.txt" ).string( );
+
+		Sonar::HighScoreManager highScores( 10 );
+		highScores.CreateSaveFile( scoresFilepath, 10 );
+
+		// Rising scores always make the table, the file was created by this manager so only the insert and save are timed
+		long long score = 0;
+
+		benchmark.Run( "HighScoreManager::SaveScore (loaded)", [&]( ) { highScores.SaveScore( scoresFilepath, ++score, "Bench" ); } );
+
+		// Setting the maximum drops the scores in memory, so every call loads the file again first
+		benchmark.Run( "HighScoreManager::SaveScore (reload)", [&]( )
+		{
+			highScores.SetMaximumNumberOfHighScores( 10 );
+			highScores.SaveScore( scoresFilepath, ++score, "Bench" );
+		} );
+
+		// Only queueing is timed, repeated saves to one file coalesce on the I/O thread
+		const std::string saveFilepath = ( directory / "save.txt" ).string( );
+
+		Sonar::FileManager saveFile;
+
+		benchmark.Run( "FileManager::WriteToFileAsync", [&]( ) { saveFile.WriteToFileAsync( saveFilepath, "Save data" ); } );
+
+		Sonar::FileWriteQueue::getInstance( )->Flush( );
+
+		// Kept in memory so only the tree is timed
+		Sonar::Leaderboard leaderboard;
+
+		for ( unsigned int i = 0; i < 1000000; i++ )
+		{ leaderboard.Submit( "Player " + std::to_string( i ), ( i * 7919ull ) % 1000003 ); }
+
+		unsigned int player = 0;
+
+		benchmark.Run( "Leaderboard::Submit (1M entries)", [&]( ) { leaderboard.Submit( "Player " + std::to_string( player++ % 1000000 ), ++score * 10 ); } );
+		benchmark.Run( "Leaderboard::GetRankOfScore (1M entries)", [&]( ) { Sonar::Benchmark::DoNotOptimize( leaderboard.GetRankOfScore( 500000 ) ); } );
+		benchmark.Run( "Leaderboard::GetPage (page 50000 of 10)", [&]( ) { Sonar::Benchmark::DoNotOptimize( leaderboard.GetPage( 50000 ) ); } );
+
+		const std::string linesFilepath = ( directory / "lines.txt" ).string( );
+		WriteTestLines( linesFilepath, 1000 );
+
+		benchmark.Run( "FileManager::GetLineFromFile (line 500 of 1000)", [&]( )
+		{
+			Sonar::FileManager fileManager;
+			Sonar::Benchmark::DoNotOptimize( fileManager.GetLineFromFile( linesFilepath, 500 ) );
+		} );
+
+		// Reused so the file stays mapped and indexed between lookups
+		Sonar::FileManager linesFile;
+
+		benchmark.Run( "FileManager::GetLineView (line 500 of 1000, indexed)", [&]( ) { Sonar::Benchmark::DoNotOptimize( linesFile.GetLineView( linesFilepath, 500 ) ); } );
+	}
+
+	// Pathfinding
+	{
+		// Walls with a gap at alternating ends so paths have to snake across the whole map
+		Sonar::MapManager map( 512, 512 );
+		map.InitializeMapWithAValue( '.' );
+
+		for ( unsigned int x = 8; x < 512; x += 16 )
+		{
+			for ( unsigned int y = 0; y < 480; y++ )
+			{ map.SetValue( '#', x, ( 0 == ( x / 16 ) % 2 ) ? y : 511 - y ); }
+		}
+
+		Sonar::Pathfinder pathfinder( &map, &data->jobs );
+		pathfinder.SetPassable( '#', false );
+
+		std::vector<glm::uvec2> path;
+
+		benchmark.Run( "Pathfinder::FindPath (A*, 512x512)", [&]( ) { pathfinder.FindPath( glm::uvec2( 0, 0 ), glm::uvec2( 511, 511 ), path, Sonar::Pathfinder::ALGORITHM::A_STAR ); } );
+		benchmark.Run( "Pathfinder::FindPath (JPS, 512x512)", [&]( ) { pathfinder.FindPath( glm::uvec2( 0, 0 ), glm::uvec2( 511, 511 ), path, Sonar::Pathfinder::ALGORITHM::JUMP_POINT_SEARCH ); } );
+
+		benchmark.Run( "Pathfinder::ProcessRequests (64 JPS requests, 512x512)", [&]( )
+		{
+			for ( unsigned int i = 0; i < 64; i++ )
+			{ pathfinder.RequestPath( glm::uvec2( ( i * 97 ) % 512, 0 ), glm::uvec2( ( i * 389 ) % 512, 511 ), nullptr ); }
+
+			while ( 0 < pathfinder.GetPendingCount( ) )
+			{ pathfinder.ProcessRequests( ); }
+		} );
+
+		Sonar::FlowFieldCache flowFields( &map, &data->jobs, 0, 0 );
+		flowFields.SetPassable( '#', false );
+
+		benchmark.Run( "FlowFieldCache::GetField (build, 512x512)", [&]( )
+		{
+			flowFields.Clear( );
+			Sonar::Benchmark::DoNotOptimize( flowFields.GetField( glm::uvec2( 511, 511 ) ) );
+		} );
+
+		std::vector<glm::uvec2> targets;
+
+		for ( unsigned int i = 0; i < 8; i++ )
+		{ targets.push_back( glm::uvec2( i * 64, 500 ) ); }
+
+		std::vector<Sonar::FlowFieldCache::FlowFieldRef> fields;
+
+		benchmark.Run( "FlowFieldCache::GetFields (build 8 targets, 512x512)", [&]( )
+		{
+			flowFields.Clear( );
+			flowFields.GetFields( targets, fields );
+		} );
+
+		// Opening and closing a gap in a wall repairs every cached field
+		bool isGapOpen = false;
+
+		benchmark.Run( "FlowFieldCache::Update (1 cell changed, 8 fields)", [&]( )
+		{
+			isGapOpen = !isGapOpen;
+			map.SetValue( isGapOpen ? '.' : '#', 200, 300 );
+			flowFields.Update( );
+		} );
+
+		const Sonar::FlowFieldCache::FlowFieldRef field = flowFields.GetField( glm::uvec2( 511, 511 ) );
+		unsigned int sample = 0;
+
+		benchmark.Run( "FlowField::GetDirection", [&]( )
+		{
+			sample = ( sample + 7919 ) % ( 512 * 512 );
+			Sonar::Benchmark::DoNotOptimize( field->GetDirection( sample % 512, sample / 512 ) );
+		} );
+	}
+
+	// Logging and events
+	{
+		data->debug->Enable( );
+		data->debug->AddCategory( "Bench", true );
+		data->debug->AddCategory( "Bench Disabled", false );
+
+		benchmark.Run( "Debug::Log", [&]( ) { data->debug->Log( "Benchmark log message", "Bench" ); } );
+		benchmark.Run( "Debug::Log (disabled category)", [&]( ) { data->debug->Log( "Benchmark log message", "Bench Disabled" ); } );
+
+		sf::Event sfEvent = sf::Event( );
+		sfEvent.type = sf::Event::MouseMoved;
+		sfEvent.mouseMove.x = 640;
+		sfEvent.mouseMove.y = 360;
+
+		Sonar::Event event( sfEvent );
+
+		benchmark.Run( "Event::Update", [&]( ) { event.Update( ); Sonar::Benchmark::DoNotOptimize( event.mouseMove.x ); } );
+	}
+
+	if ( !benchmark.WriteJSON( outputFilepath ) )
+	{
+		std::cerr << "Failed to write " << outputFilepath << std::endl;
+
+		return EXIT_FAILURE;
+	}
+
+	std::cerr << "Results written to " << outputFilepath << std::endl;
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,114 @@
+#include "pch.hpp"
+#include "StressTest.hpp"
+#include "StressStates.hpp"
+
+int main( int argc, char *argv[] )
+{
+	std::string outputFilepath = "sonar_stress.json";
+	std::string filter;
+	std::string traceFilepath;
+
+	unsigned int frames = DEFAULT_STRESS_TEST_FRAMES;
+	unsigned int scale = 1;
+
+	for ( int i = 1; i < argc; i++ )
+	{
+		const std::string argument = argv[i];
+
+		if ( "--output" == argument && i + 1 < argc )
+		{ outputFilepath = argv[++i]; }
+		else if ( "--filter" == argument && i + 1 < argc )
+		{ filter = argv[++i]; }
+		else if ( "--frames" == argument && i + 1 < argc )
+		{ frames = std::stoul( argv[++i] ); }
+		else if ( "--scale" == argument && i + 1 < argc )
+		{ scale = std::max( 1u, static_cast<unsigned int>( std::stoul( argv[++i] ) ) ); }
+		else if ( "--trace" == argument && i + 1 < argc )
+		{ traceFilepath = argv[++i]; }
+		else
+		{
+			std::cerr << "Usage: sonar_stress [--output results.json] [--filter name] [--frames count] [--scale multiplier] [--trace trace.json]" << std::endl;
+
+			return EXIT_FAILURE;
+		}
+	}
+
+	Sonar::StressTest stressTest( DEFAULT_STRESS_TEST_WINDOW_WIDTH, DEFAULT_STRESS_TEST_WINDOW_HEIGHT, frames );
+	stressTest.SetFilter( filter );
+
+	Sonar::GameDataRef data = stressTest.GetGameData( );
+
+	// Every selected scene is captured into one trace, use --filter to keep it small
+	if ( !traceFilepath.empty( ) )
+	{ Sonar::Profiler::getInstance( )->BeginCapture( ); }
+
+	// Object counts per scene, --scale multiplies them all
+	for ( const unsigned int &spriteCount : { 1000u, 10000u } )
+	{
+		const unsigned int count = spriteCount * scale;
+
+		if ( stressTest.IsSelected( "Sprites" ) && !stressTest.Run( "Sprites", count, Sonar::StateRef( new Sonar::SpriteStressState( data, count ) ) ) )
+		{ return EXIT_FAILURE; }
+	}
+
+	{
+		const unsigned int count = 3000 * scale;
+
+		if ( stressTest.IsSelected( "Shapes" ) && !stressTest.Run( "Shapes", count, Sonar::StateRef( new Sonar::ShapeStressState( data, count ) ) ) )
+		{ return EXIT_FAILURE; }
+	}
+
+	{
+		const unsigned int count = 2000 * scale;
+
+		if ( stressTest.IsSelected( "Labels" ) && !stressTest.Run( "Labels", count, Sonar::StateRef( new Sonar::LabelStressState( data, count ) ) ) )
+		{ return EXIT_FAILURE; }
+	}
+
+	{
+		const unsigned int count = 32 * scale;
+
+		if ( stressTest.IsSelected( "Parallax" ) && !stressTest.Run( "Parallax", count, Sonar::StateRef( new Sonar::ParallaxStressState( data, count ) ) ) )
+		{ return EXIT_FAILURE; }
+	}
+
+	{
+		const unsigned int count = 5000 * scale;
+
+		if ( stressTest.IsSelected( "Minimap" ) && !stressTest.Run( "Minimap", count, Sonar::StateRef( new Sonar::MinimapStressState( data, count ) ) ) )
+		{ return EXIT_FAILURE; }
+	}
+
+	{
+		// Map width and height in cells
+		const unsigned int count = 1024 * scale;
+
+		if ( stressTest.IsSelected( "TileMap" ) && !stressTest.Run( "TileMap", count, Sonar::StateRef( new Sonar::TileMapStressState( data, count ) ) ) )
+		{ return EXIT_FAILURE; }
+	}
+
+	if ( !traceFilepath.empty( ) )
+	{
+		Sonar::Profiler::getInstance( )->EndCapture( );
+
+		if ( !Sonar::Profiler::getInstance( )->WriteChromeTrace( traceFilepath ) )
+		{
+			std::cerr << "Failed to write " << traceFilepath << std::endl;
+
+			return EXIT_FAILURE;
+		}
+
+		std::cerr << "Trace written to " << traceFilepath << std::endl;
+	}
+
+	if ( !stressTest.WriteJSON( outputFilepath ) )
+	{
+		std::cerr << "Failed to write " << outputFilepath << std::endl;
+
+		return EXIT_FAILURE;
+	}
+
+	std::cerr << "Results written to " << outputFilepath << std::endl;
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,244 @@
+#include "pch.hpp"
+
+namespace
+{
+	/**
+	 * \brief Cost of a diagonal step
+	 */
+	const float DIAGONAL_COST = 1.41421356f;
+
+	/**
+	 * \brief The 8 neighbour directions, straight ones first
+	 */
+	const int NEIGHBOUR_DIRECTIONS[8][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } };
+
+	/**
+	 * \brief Index of the direction opposite each neighbour direction
+	 */
+	const uint8_t OPPOSITE_DIRECTIONS[8] = { 1, 0, 3, 2, 7, 6, 5, 4 };
+
+	/**
+	 * \brief Direction index of cells without a direction (the target and cells that can't reach it)
+	 */
+	const uint8_t NO_DIRECTION = 8;
+
+	/**
+	 * \brief Unit vector of each direction index
+	 */
+	const glm::vec2 DIRECTION_VECTORS[9] =
+	{
+		glm::vec2( 1.0f, 0.0f ), glm::vec2( -1.0f, 0.0f ), glm::vec2( 0.0f, 1.0f ), glm::vec2( 0.0f, -1.0f ),
+		glm::vec2( 0.70710678f, 0.70710678f ), glm::vec2( 0.70710678f, -0.70710678f ), glm::vec2( -0.70710678f, 0.70710678f ), glm::vec2( -0.70710678f, -0.70710678f ),
+		glm::vec2( 0.0f, 0.0f )
+	};
+
+	/**
+	 * \brief Orders the open list so the cheapest cell is at the top of the heap
+	 */
+	template<typename OpenCell>
+	bool IsHigherCost( const OpenCell &first, const OpenCell &second )
+	{ return first.cost > second.cost; }
+
+	/**
+	 * \brief Check if a step from a cell is allowed, diagonal steps can't squeeze past a blocked corner
+	 */
+	bool CanStep( const Sonar::NavigationGrid &grid, const int &x, const int &y, const uint8_t &direction )
+	{
+		const int directionX = NEIGHBOUR_DIRECTIONS[direction][0], directionY = NEIGHBOUR_DIRECTIONS[direction][1];
+
+		return grid.IsWalkable( x + directionX, y + directionY ) && ( 0 == directionX || 0 == directionY || ( grid.IsWalkable( x + directionX, y ) && grid.IsWalkable( x, y + directionY ) ) );
+	}
+}
+
+namespace Sonar
+{
+	FlowField::FlowField( const glm::uvec2 &target ) : _target( target )
+	{
+		_width = 0;
+		_height = 0;
+	}
+
+	FlowField::~FlowField( ) { }
+
+	glm::vec2 FlowField::GetDirection( const unsigned int &x, const unsigned int &y ) const
+	{
+		if ( x >= static_cast<unsigned int>( _width ) || y >= static_cast<unsigned int>( _height ) )
+		{ return DIRECTION_VECTORS[NO_DIRECTION]; }
+
+		return DIRECTION_VECTORS[_directions[static_cast<std::size_t>( y ) * _width + x]];
+	}
+
+	glm::uvec2 FlowField::GetNextCell( const unsigned int &x, const unsigned int &y ) const
+	{
+		if ( x >= static_cast<unsigned int>( _width ) || y >= static_cast<unsigned int>( _height ) )
+		{ return glm::uvec2( x, y ); }
+
+		const uint8_t direction = _directions[static_cast<std::size_t>( y ) * _width + x];
+
+		if ( NO_DIRECTION == direction )
+		{ return glm::uvec2( x, y ); }
+
+		return glm::uvec2( x + NEIGHBOUR_DIRECTIONS[direction][0], y + NEIGHBOUR_DIRECTIONS[direction][1] );
+	}
+
+	float FlowField::GetCost( const unsigned int &x, const unsigned int &y ) const
+	{
+		if ( x >= static_cast<unsigned int>( _width ) || y >= static_cast<unsigned int>( _height ) )
+		{ return std::numeric_limits<float>::infinity( ); }
+
+		return _costs[static_cast<std::size_t>( y ) * _width + x];
+	}
+
+	bool FlowField::IsReachable( const unsigned int &x, const unsigned int &y ) const
+	{ return std::numeric_limits<float>::infinity( ) != GetCost( x, y ); }
+
+	const glm::uvec2 &FlowField::GetTarget( ) const
+	{ return _target; }
+
+	glm::uvec2 FlowField::GetSize( ) const
+	{ return glm::uvec2( _width, _height ); }
+
+	void FlowField::Build( const NavigationGrid &grid, IntegrationContext &context )
+	{
+		_width = grid.GetWidth( );
+		_height = grid.GetHeight( );
+
+		const std::size_t cellCount = static_cast<std::size_t>( _width ) * _height;
+
+		_costs.assign( cellCount, std::numeric_limits<float>::infinity( ) );
+		_directions.assign( cellCount, NO_DIRECTION );
+
+		context.open.clear( );
+
+		if ( grid.IsWalkable( _target.x, _target.y ) )
+		{
+			const uint32_t target = _target.y * _width + _target.x;
+
+			_costs[target] = 0.0f;
+			Open( context, target );
+		}
+
+		Integrate( grid, context );
+	}
+
+	void FlowField::Repair( const NavigationGrid &grid, const std::vector<uint32_t> &changedCells, IntegrationContext &context )
+	{
+		context.open.clear( );
+		context.invalidated.clear( );
+
+		// A changed cell only affects the steps of the cells around it (a step's corners are next to both ends of it)
+		const auto forEachNeighbourhoodCell = [this]( const uint32_t &cell, const auto &function )
+		{
+			const int cellX = cell % _width, cellY = cell / _width;
+
+			for ( int y = std::max( cellY - 1, 0 ); y <= std::min( cellY + 1, _height - 1 ); y++ )
+			{
+				for ( int x = std::max( cellX - 1, 0 ); x <= std::min( cellX + 1, _width - 1 ); x++ )
+				{ function( x, y, static_cast<uint32_t>( y * _width + x ) ); }
+			}
+		};
+
+		for ( const uint32_t &changedCell : changedCells )
+		{
+			forEachNeighbourhoodCell( changedCell, [&]( const int &x, const int &y, const uint32_t &cell )
+			{
+				const bool isBlocked = !grid.IsWalkable( x, y ) && std::numeric_limits<float>::infinity( ) != _costs[cell];
+
+				if ( isBlocked || ( NO_DIRECTION != _directions[cell] && !CanStep( grid, x, y, _directions[cell] ) ) )
+				{ Invalidate( context, cell ); }
+			} );
+		}
+
+		// Every cell whose path stepped into a cleared cell is cleared too
+		for ( std::size_t i = 0; i < context.invalidated.size( ); i++ )
+		{
+			const uint32_t invalidCell = context.invalidated[i];
+			const int invalidX = invalidCell % _width, invalidY = invalidCell / _width;
+
+			for ( uint8_t direction = 0; direction < 8; direction++ )
+			{
+				const int x = invalidX + NEIGHBOUR_DIRECTIONS[direction][0], y = invalidY + NEIGHBOUR_DIRECTIONS[direction][1];
+
+				if ( x < 0 || y < 0 || x >= _width || y >= _height )
+				{ continue; }
+
+				const uint32_t cell = y * _width + x;
+
+				if ( OPPOSITE_DIRECTIONS[direction] == _directions[cell] )
+				{ Invalidate( context, cell ); }
+			}
+		}
+
+		if ( grid.IsWalkable( _target.x, _target.y ) )
+		{
+			const uint32_t target = _target.y * _width + _target.x;
+
+			if ( 0.0f != _costs[target] )
+			{
+				_costs[target] = 0.0f;
+				_directions[target] = NO_DIRECTION;
+				Open( context, target );
+			}
+		}
+
+		// Integrating from the cells that still have a cost around the changes fills the cleared cells back in and lowers any cell a newly opened cell gives a cheaper path to
+		const auto openReachable = [&]( const int &, const int &, const uint32_t &cell )
+		{
+			if ( std::numeric_limits<float>::infinity( ) != _costs[cell] )
+			{ Open( context, cell ); }
+		};
+
+		for ( const uint32_t &changedCell : changedCells )
+		{ forEachNeighbourhoodCell( changedCell, openReachable ); }
+
+		for ( const uint32_t &invalidCell : context.invalidated )
+		{ forEachNeighbourhoodCell( invalidCell, openReachable ); }
+
+		Integrate( grid, context );
+	}
+
+	void FlowField::Integrate( const NavigationGrid &grid, IntegrationContext &context )
+	{
+		while ( !context.open.empty( ) )
+		{
+			std::pop_heap( context.open.begin( ), context.open.end( ), IsHigherCost<OpenCell> );
+			const OpenCell open = context.open.back( );
+			context.open.pop_back( );
+
+			// A cell is pushed again whenever a cheaper path to it is found, only its cheapest entry is expanded
+			if ( open.cost > _costs[open.cell] )
+			{ continue; }
+
+			const int x = open.cell % _width, y = open.cell / _width;
+
+			for ( uint8_t direction = 0; direction < 8; direction++ )
+			{
+				if ( !CanStep( grid, x, y, direction ) )
+				{ continue; }
+
+				const uint32_t cell = ( y + NEIGHBOUR_DIRECTIONS[direction][1] ) * _width + x + NEIGHBOUR_DIRECTIONS[direction][0];
+				const float cost = open.cost + ( direction < 4 ? 1.0f : DIAGONAL_COST );
+
+				if ( cost < _costs[cell] )
+				{
+					_costs[cell] = cost;
+					_directions[cell] = OPPOSITE_DIRECTIONS[direction];
+					Open( context, cell );
+				}
+			}
+		}
+	}
+
+	void FlowField::Open( IntegrationContext &context, const uint32_t &cell ) const
+	{
+		context.open.push_back( OpenCell{ _costs[cell], cell } );
+		std::push_heap( context.open.begin( ), context.open.end( ), IsHigherCost<OpenCell> );
+	}
+
+	void FlowField::Invalidate( IntegrationContext &context, const uint32_t &cell )
+	{
+		_costs[cell] = std::numeric_limits<float>::infinity( );
+		_directions[cell] = NO_DIRECTION;
+		context.invalidated.push_back( cell );
+	}
+}
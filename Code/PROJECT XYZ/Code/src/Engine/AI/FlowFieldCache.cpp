@@ -0,0 +1,151 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+	FlowFieldCache::FlowFieldCache( MapManager *map, JobSystem *jobs, const unsigned int &layer, const unsigned int &capacity ) : _jobs( jobs ), _grid( map, layer )
+	{
+		_capacity = capacity;
+		_useCount = 0;
+	}
+
+	FlowFieldCache::~FlowFieldCache( ) { }
+
+	void FlowFieldCache::SetPassable( const MapCell &value, const bool &isPassable )
+	{ _grid.SetPassable( value, isPassable ); }
+
+	bool FlowFieldCache::IsPassable( const MapCell &value ) const
+	{ return _grid.IsPassable( value ); }
+
+	FlowFieldCache::FlowFieldRef FlowFieldCache::GetField( const glm::uvec2 &target )
+	{
+		std::vector<FlowFieldRef> fields;
+		GetFields( std::vector<glm::uvec2>{ target }, fields );
+
+		return fields.front( );
+	}
+
+	void FlowFieldCache::GetFields( const std::vector<glm::uvec2> &targets, std::vector<FlowFieldRef> &fields )
+	{
+		Update( );
+
+		SONAR_PROFILE_SCOPE( "Flow fields" );
+
+		const unsigned long long firstUse = _useCount + 1;
+
+		fields.clear( );
+		_integrating.clear( );
+
+		for ( const glm::uvec2 &target : targets )
+		{
+			auto cached = _fields.find( GetKey( target ) );
+
+			if ( _fields.end( ) == cached )
+			{
+				cached = _fields.emplace( GetKey( target ), CachedField{ std::make_shared<FlowField>( target ), 0 } ).first;
+				_integrating.push_back( cached->second.field.get( ) );
+			}
+
+			cached->second.lastUsed = ++_useCount;
+			fields.push_back( cached->second.field );
+		}
+
+		Integrate( _integrating, false );
+		Evict( firstUse );
+	}
+
+	unsigned int FlowFieldCache::Update( )
+	{
+		SONAR_PROFILE_SCOPE( "Flow fields" );
+
+		const bool isResized = _grid.Refresh( &_changedCells );
+
+		if ( !isResized && _changedCells.empty( ) )
+		{ return 0; }
+
+		_integrating.clear( );
+
+		for ( auto &cached : _fields )
+		{ _integrating.push_back( cached.second.field.get( ) ); }
+
+		// A resized map doesn't list its changed cells, every field is built again
+		Integrate( _integrating, !isResized );
+
+		return _integrating.size( );
+	}
+
+	bool FlowFieldCache::RemoveField( const glm::uvec2 &target )
+	{ return 0 < _fields.erase( GetKey( target ) ); }
+
+	void FlowFieldCache::Clear( )
+	{ _fields.clear( ); }
+
+	unsigned int FlowFieldCache::GetFieldCount( ) const
+	{ return _fields.size( ); }
+
+	void FlowFieldCache::SetCapacity( const unsigned int &capacity )
+	{
+		_capacity = capacity;
+		Evict( _useCount + 1 );
+	}
+
+	unsigned int FlowFieldCache::GetCapacity( ) const
+	{ return _capacity; }
+
+	void FlowFieldCache::Integrate( const std::vector<FlowField *> &fields, const bool &isRepair )
+	{
+		if ( fields.empty( ) )
+		{ return; }
+
+		const unsigned int threadCount = std::min<unsigned int>( ( nullptr == _jobs ) ? 1 : _jobs->GetThreadCount( ) + 1, fields.size( ) );
+
+		if ( _contexts.size( ) < threadCount )
+		{ _contexts.resize( threadCount ); }
+
+		std::atomic<unsigned int> nextField( 0 );
+
+		// Each thread claims the next field until they've all been integrated
+		const auto integrateFields = [&]( const unsigned int &contextIndex )
+		{
+			FlowField::IntegrationContext &context = _contexts[contextIndex];
+
+			for ( unsigned int index = nextField++; index < fields.size( ); index = nextField++ )
+			{
+				if ( isRepair )
+				{ fields[index]->Repair( _grid, _changedCells, context ); }
+				else
+				{ fields[index]->Build( _grid, context ); }
+			}
+		};
+
+		if ( 1 == threadCount )
+		{ integrateFields( 0 ); }
+		else
+		{
+			_jobs->ParallelFor( threadCount, [&]( const unsigned int &begin, const unsigned int &end )
+			{
+				for ( unsigned int i = begin; i < end; i++ )
+				{ integrateFields( i ); }
+			}, 1 );
+		}
+	}
+
+	void FlowFieldCache::Evict( const unsigned long long &keepSince )
+	{
+		while ( 0 != _capacity && _fields.size( ) > _capacity )
+		{
+			auto leastRecent = _fields.end( );
+
+			for ( auto cached = _fields.begin( ); cached != _fields.end( ); ++cached )
+			{
+				if ( cached->second.lastUsed < keepSince && ( _fields.end( ) == leastRecent || cached->second.lastUsed < leastRecent->second.lastUsed ) )
+				{ leastRecent = cached; }
+			}
+
+			// Everything left was just asked for
+			if ( _fields.end( ) == leastRecent )
+			{ return; }
+
+			_fields.erase( leastRecent );
+		}
+	}
+}
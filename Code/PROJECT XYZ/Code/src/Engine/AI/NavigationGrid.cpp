@@ -0,0 +1,90 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+	NavigationGrid::NavigationGrid( MapManager *map, const unsigned int &layer ) : _map( map ), _layer( layer )
+	{
+		_passable.assign( std::numeric_limits<MapCell>::max( ) + 1, 1 );
+		_width = 0;
+		_height = 0;
+		_isGridChanged = true;
+	}
+
+	NavigationGrid::~NavigationGrid( ) { }
+
+	void NavigationGrid::SetPassable( const MapCell &value, const bool &isPassable )
+	{
+		if ( isPassable != IsPassable( value ) )
+		{
+			_passable[value] = isPassable;
+			_isGridChanged = true;
+		}
+	}
+
+	bool NavigationGrid::IsPassable( const MapCell &value ) const
+	{ return 0 != _passable[value]; }
+
+	bool NavigationGrid::Refresh( std::vector<uint32_t> *changedCells )
+	{
+		const glm::uvec2 size = _map->GetSize( );
+		const glm::uvec2 chunkCount = _map->GetChunkCount( );
+
+		bool isResized = false;
+
+		if ( static_cast<int>( size.x ) != _width || static_cast<int>( size.y ) != _height || _chunkVersions.size( ) != static_cast<std::size_t>( chunkCount.x ) * chunkCount.y )
+		{
+			_width = size.x;
+			_height = size.y;
+			_grid.assign( static_cast<std::size_t>( _width ) * _height, 0 );
+			_chunkVersions.assign( static_cast<std::size_t>( chunkCount.x ) * chunkCount.y, 0 );
+			_isGridChanged = true;
+			isResized = true;
+		}
+
+		if ( nullptr != changedCells )
+		{ changedCells->clear( ); }
+
+		// Resizing changes every cell, so there's nothing worth listing
+		const bool isListingChanges = nullptr != changedCells && !isResized;
+
+		for ( unsigned int chunkY = 0; chunkY < chunkCount.y; chunkY++ )
+		{
+			for ( unsigned int chunkX = 0; chunkX < chunkCount.x; chunkX++ )
+			{
+				unsigned long long &version = _chunkVersions[static_cast<std::size_t>( chunkY ) * chunkCount.x + chunkX];
+				const unsigned long long mapVersion = _map->GetChunkVersion( chunkX, chunkY, _layer );
+
+				if ( !_isGridChanged && mapVersion == version )
+				{ continue; }
+
+				version = mapVersion;
+
+				const MapCell *cells = _map->GetChunk( chunkX, chunkY, _layer );
+
+				// Edge chunks stop at the edge of the map
+				const unsigned int width = std::min<unsigned int>( SONAR_MAP_CHUNK_SIZE, _width - chunkX * SONAR_MAP_CHUNK_SIZE );
+				const unsigned int height = std::min<unsigned int>( SONAR_MAP_CHUNK_SIZE, _height - chunkY * SONAR_MAP_CHUNK_SIZE );
+
+				for ( unsigned int y = 0; y < height; y++ )
+				{
+					const std::size_t rowStart = static_cast<std::size_t>( chunkY * SONAR_MAP_CHUNK_SIZE + y ) * _width + chunkX * SONAR_MAP_CHUNK_SIZE;
+					uint8_t *row = &_grid[rowStart];
+
+					for ( unsigned int x = 0; x < width; x++ )
+					{
+						const uint8_t isPassable = ( nullptr != cells ) ? _passable[cells[y * SONAR_MAP_CHUNK_SIZE + x]] : 0;
+
+						if ( isListingChanges && isPassable != row[x] )
+						{ changedCells->push_back( static_cast<uint32_t>( rowStart + x ) ); }
+
+						row[x] = isPassable;
+					}
+				}
+			}
+		}
+
+		_isGridChanged = false;
+
+		return isResized;
+	}
+}
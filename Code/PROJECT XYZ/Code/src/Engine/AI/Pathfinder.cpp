@@ -0,0 +1,454 @@
+#include "pch.hpp"
+
+namespace
+{
+	/**
+	 * \brief Cost of a diagonal step
+	 */
+	const float DIAGONAL_COST = 1.41421356f;
+
+	/**
+	 * \brief The 8 neighbour directions, straight ones first
+	 */
+	const int NEIGHBOUR_DIRECTIONS[8][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } };
+
+	/**
+	 * \brief Orders the open list so the cell with the lowest estimate is at the top of the heap
+	 */
+	template<typename OpenCell>
+	bool IsLowerPriority( const OpenCell &first, const OpenCell &second )
+	{ return first.estimate > second.estimate || ( first.estimate == second.estimate && first.cost < second.cost ); }
+
+	/**
+	 * \brief Sign of a number (-1, 0 or 1)
+	 */
+	int Sign( const int &value )
+	{ return ( value > 0 ) - ( value < 0 ); }
+}
+
+namespace Sonar
+{
+	Pathfinder::Pathfinder( MapManager *map, JobSystem *jobs, const unsigned int &layer ) : _jobs( jobs ), _grid( map, layer )
+	{
+		_nextID = 0;
+		_expandedCount = 0;
+	}
+
+	Pathfinder::~Pathfinder( ) { }
+
+	void Pathfinder::SetPassable( const MapCell &value, const bool &isPassable )
+	{ _grid.SetPassable( value, isPassable ); }
+
+	bool Pathfinder::IsPassable( const MapCell &value ) const
+	{ return _grid.IsPassable( value ); }
+
+	bool Pathfinder::FindPath( const glm::uvec2 &start, const glm::uvec2 &goal, std::vector<glm::uvec2> &path, const ALGORITHM &algorithm )
+	{
+		_grid.Refresh( );
+
+		if ( _contexts.empty( ) )
+		{ _contexts.resize( 1 ); }
+
+		SearchContext &context = _contexts.front( );
+		context.expandedCount = 0;
+
+		const bool isFound = Search( context, start, goal, algorithm, path );
+
+		_expandedCount = context.expandedCount;
+
+		return isFound;
+	}
+
+	unsigned int Pathfinder::RequestPath( const glm::uvec2 &start, const glm::uvec2 &goal, const Callback &callback, const ALGORITHM &algorithm )
+	{
+		Request request;
+
+		if ( !_freeRequests.empty( ) )
+		{
+			request = std::move( _freeRequests.back( ) );
+			_freeRequests.pop_back( );
+		}
+
+		request.id = _nextID++;
+		request.start = start;
+		request.goal = goal;
+		request.algorithm = algorithm;
+		request.callback = callback;
+		request.path.clear( );
+		request.isSearched = false;
+
+		_requests.push_back( std::move( request ) );
+
+		return _requests.back( ).id;
+	}
+
+	bool Pathfinder::CancelRequest( const unsigned int &id )
+	{
+		const auto request = std::find_if( _requests.begin( ), _requests.end( ), [&id]( const Request &queued ) { return id == queued.id; } );
+
+		if ( _requests.end( ) == request )
+		{ return false; }
+
+		_freeRequests.push_back( std::move( *request ) );
+		_requests.erase( request );
+
+		return true;
+	}
+
+	unsigned int Pathfinder::ProcessRequests( const float &timeBudget )
+	{
+		SONAR_PROFILE_SCOPE( "Pathfinding" );
+
+		_expandedCount = 0;
+
+		if ( _requests.empty( ) )
+		{ return 0; }
+
+		_grid.Refresh( );
+
+		const unsigned int threadCount = ( nullptr == _jobs ) ? 1 : _jobs->GetThreadCount( ) + 1;
+
+		if ( _contexts.size( ) < threadCount )
+		{ _contexts.resize( threadCount ); }
+
+		const unsigned int requestCount = _requests.size( );
+		std::atomic<unsigned int> nextRequest( 0 );
+
+		Clock clock;
+
+		// Each thread claims the next request in order, so the searched requests are always the oldest ones
+		const auto searchRequests = [&]( const unsigned int &contextIndex )
+		{
+			SearchContext &context = _contexts[contextIndex];
+			context.expandedCount = 0;
+
+			bool isFirst = true;
+
+			while ( isFirst || Time::MicrosecondsToMilliseconds( clock.GetElapsedTime( ).AsMicroseconds( ) ) < timeBudget )
+			{
+				const unsigned int index = nextRequest++;
+
+				if ( index >= requestCount )
+				{ return; }
+
+				Request &request = _requests[index];
+				Search( context, request.start, request.goal, request.algorithm, request.path );
+				request.isSearched = true;
+
+				isFirst = false;
+			}
+		};
+
+		if ( 1 == threadCount )
+		{ searchRequests( 0 ); }
+		else
+		{
+			_jobs->ParallelFor( threadCount, [&]( const unsigned int &begin, const unsigned int &end )
+			{
+				for ( unsigned int i = begin; i < end; i++ )
+				{ searchRequests( i ); }
+			}, 1 );
+		}
+
+		for ( unsigned int i = 0; i < threadCount; i++ )
+		{ _expandedCount += _contexts[i].expandedCount; }
+
+		unsigned int searchedCount = 0;
+
+		// Taken off the queue before the callback runs so the callback can request or cancel paths
+		while ( !_requests.empty( ) && _requests.front( ).isSearched )
+		{
+			Request request = std::move( _requests.front( ) );
+			_requests.pop_front( );
+
+			if ( request.callback )
+			{ request.callback( request.id, request.path ); }
+
+			_freeRequests.push_back( std::move( request ) );
+			searchedCount++;
+		}
+
+		return searchedCount;
+	}
+
+	unsigned int Pathfinder::GetPendingCount( ) const
+	{ return _requests.size( ); }
+
+	unsigned long long Pathfinder::GetExpandedCount( ) const
+	{ return _expandedCount; }
+
+	bool Pathfinder::Search( SearchContext &context, const glm::uvec2 &start, const glm::uvec2 &goal, const ALGORITHM &algorithm, std::vector<glm::uvec2> &path ) const
+	{
+		path.clear( );
+
+		if ( !IsWalkable( start.x, start.y ) || !IsWalkable( goal.x, goal.y ) )
+		{ return false; }
+
+		const std::size_t cellCount = static_cast<std::size_t>( _grid.GetWidth( ) ) * _grid.GetHeight( );
+
+		// Only grows when the map size changes, every search after that reuses the same storage
+		if ( context.costs.size( ) != cellCount )
+		{
+			context.costs.assign( cellCount, 0.0f );
+			context.parents.assign( cellCount, 0 );
+			context.openGenerations.assign( cellCount, 0 );
+			context.closedGenerations.assign( cellCount, 0 );
+			context.generation = 0;
+		}
+
+		if ( 0 == ++context.generation )
+		{
+			std::fill( context.openGenerations.begin( ), context.openGenerations.end( ), 0 );
+			std::fill( context.closedGenerations.begin( ), context.closedGenerations.end( ), 0 );
+			context.generation = 1;
+		}
+
+		const uint32_t startCell = start.y * _grid.GetWidth( ) + start.x;
+		const uint32_t goalCell = goal.y * _grid.GetWidth( ) + goal.x;
+
+		context.open.clear( );
+		Open( context, startCell, startCell, 0.0f, goalCell );
+
+		while ( !context.open.empty( ) )
+		{
+			std::pop_heap( context.open.begin( ), context.open.end( ), IsLowerPriority<OpenCell> );
+			const uint32_t cell = context.open.back( ).cell;
+			context.open.pop_back( );
+
+			// A cell is pushed again whenever a cheaper way to it is found, only its cheapest entry is expanded
+			if ( context.generation == context.closedGenerations[cell] )
+			{ continue; }
+
+			context.closedGenerations[cell] = context.generation;
+			context.expandedCount++;
+
+			if ( goalCell == cell )
+			{
+				context.jumpPoints.clear( );
+
+				for ( uint32_t jumpPoint = goalCell; startCell != jumpPoint; jumpPoint = context.parents[jumpPoint] )
+				{ context.jumpPoints.push_back( jumpPoint ); }
+
+				// Jump points are joined by straight or diagonal lines, the path fills in every cell along them
+				glm::ivec2 position( start );
+				path.push_back( start );
+
+				for ( auto jumpPoint = context.jumpPoints.rbegin( ); jumpPoint != context.jumpPoints.rend( ); ++jumpPoint )
+				{
+					const glm::ivec2 target( *jumpPoint % _grid.GetWidth( ), *jumpPoint / _grid.GetWidth( ) );
+
+					while ( target != position )
+					{
+						position += glm::ivec2( Sign( target.x - position.x ), Sign( target.y - position.y ) );
+						path.push_back( glm::uvec2( position ) );
+					}
+				}
+
+				return true;
+			}
+
+			if ( ALGORITHM::A_STAR == algorithm )
+			{ ExpandNeighbours( context, cell, goalCell ); }
+			else
+			{ ExpandJumpPoints( context, cell, goalCell ); }
+		}
+
+		return false;
+	}
+
+	void Pathfinder::ExpandNeighbours( SearchContext &context, const uint32_t &cell, const uint32_t &goal ) const
+	{
+		const int x = cell % _grid.GetWidth( ), y = cell / _grid.GetWidth( );
+		const float cost = context.costs[cell];
+
+		for ( const auto &direction : NEIGHBOUR_DIRECTIONS )
+		{
+			const int directionX = direction[0], directionY = direction[1];
+
+			if ( !IsWalkable( x + directionX, y + directionY ) )
+			{ continue; }
+
+			const bool isDiagonal = 0 != directionX && 0 != directionY;
+
+			// Diagonal steps can't squeeze past a blocked corner
+			if ( isDiagonal && ( !IsWalkable( x + directionX, y ) || !IsWalkable( x, y + directionY ) ) )
+			{ continue; }
+
+			Open( context, cell + directionY * _grid.GetWidth( ) + directionX, cell, cost + ( isDiagonal ? DIAGONAL_COST : 1.0f ), goal );
+		}
+	}
+
+	void Pathfinder::ExpandJumpPoints( SearchContext &context, const uint32_t &cell, const uint32_t &goal ) const
+	{
+		const int x = cell % _grid.GetWidth( ), y = cell / _grid.GetWidth( );
+		const int goalX = goal % _grid.GetWidth( ), goalY = goal / _grid.GetWidth( );
+		const uint32_t parent = context.parents[cell];
+		const float cost = context.costs[cell];
+
+		int directions[8][2];
+		unsigned int directionCount = 0;
+
+		const auto addDirection = [&]( const int &directionX, const int &directionY )
+		{
+			directions[directionCount][0] = directionX;
+			directions[directionCount][1] = directionY;
+			directionCount++;
+		};
+
+		if ( parent == cell )
+		{
+			// The start cell has no direction to prune with
+			for ( const auto &direction : NEIGHBOUR_DIRECTIONS )
+			{
+				if ( IsWalkable( x + direction[0], y ) && IsWalkable( x, y + direction[1] ) )
+				{ addDirection( direction[0], direction[1] ); }
+			}
+		}
+		else
+		{
+			// Only the neighbours that can't be reached more cheaply without going through this cell are kept
+			const int directionX = Sign( x - static_cast<int>( parent % _grid.GetWidth( ) ) );
+			const int directionY = Sign( y - static_cast<int>( parent / _grid.GetWidth( ) ) );
+
+			if ( 0 != directionX && 0 != directionY )
+			{
+				const bool isNextXWalkable = IsWalkable( x + directionX, y );
+				const bool isNextYWalkable = IsWalkable( x, y + directionY );
+
+				if ( isNextYWalkable )
+				{ addDirection( 0, directionY ); }
+
+				if ( isNextXWalkable )
+				{ addDirection( directionX, 0 ); }
+
+				if ( isNextXWalkable && isNextYWalkable )
+				{ addDirection( directionX, directionY ); }
+			}
+			else if ( 0 != directionX )
+			{
+				const bool isNextWalkable = IsWalkable( x + directionX, y );
+				const bool isBelowWalkable = IsWalkable( x, y + 1 );
+				const bool isAboveWalkable = IsWalkable( x, y - 1 );
+
+				if ( isNextWalkable )
+				{
+					addDirection( directionX, 0 );
+
+					if ( isBelowWalkable )
+					{ addDirection( directionX, 1 ); }
+
+					if ( isAboveWalkable )
+					{ addDirection( directionX, -1 ); }
+				}
+
+				if ( isBelowWalkable )
+				{ addDirection( 0, 1 ); }
+
+				if ( isAboveWalkable )
+				{ addDirection( 0, -1 ); }
+			}
+			else
+			{
+				const bool isNextWalkable = IsWalkable( x, y + directionY );
+				const bool isRightWalkable = IsWalkable( x + 1, y );
+				const bool isLeftWalkable = IsWalkable( x - 1, y );
+
+				if ( isNextWalkable )
+				{
+					addDirection( 0, directionY );
+
+					if ( isRightWalkable )
+					{ addDirection( 1, directionY ); }
+
+					if ( isLeftWalkable )
+					{ addDirection( -1, directionY ); }
+				}
+
+				if ( isRightWalkable )
+				{ addDirection( 1, 0 ); }
+
+				if ( isLeftWalkable )
+				{ addDirection( -1, 0 ); }
+			}
+		}
+
+		for ( unsigned int i = 0; i < directionCount; i++ )
+		{
+			uint32_t jumpPoint;
+
+			if ( Jump( x + directions[i][0], y + directions[i][1], directions[i][0], directions[i][1], goalX, goalY, jumpPoint ) )
+			{ Open( context, jumpPoint, cell, cost + Heuristic( cell, jumpPoint ), goal ); }
+		}
+	}
+
+	bool Pathfinder::Jump( int x, int y, const int &directionX, const int &directionY, const int &goalX, const int &goalY, uint32_t &jumpPoint ) const
+	{
+		if ( 0 == directionX || 0 == directionY )
+		{ return JumpStraight( x, y, directionX, directionY, goalX, goalY, jumpPoint ); }
+
+		uint32_t straightJumpPoint;
+
+		while ( IsWalkable( x, y ) )
+		{
+			// A diagonal run stops wherever one of its straight runs finds something
+			if ( ( goalX == x && goalY == y ) || JumpStraight( x + directionX, y, directionX, 0, goalX, goalY, straightJumpPoint ) || JumpStraight( x, y + directionY, 0, directionY, goalX, goalY, straightJumpPoint ) )
+			{
+				jumpPoint = y * _grid.GetWidth( ) + x;
+
+				return true;
+			}
+
+			if ( !IsWalkable( x + directionX, y ) || !IsWalkable( x, y + directionY ) )
+			{ return false; }
+
+			x += directionX;
+			y += directionY;
+		}
+
+		return false;
+	}
+
+	bool Pathfinder::JumpStraight( int x, int y, const int &directionX, const int &directionY, const int &goalX, const int &goalY, uint32_t &jumpPoint ) const
+	{
+		while ( IsWalkable( x, y ) )
+		{
+			// A cell with a forced neighbour (an opening beside a wall that's just been passed) is a jump point
+			const bool isJumpPoint = ( goalX == x && goalY == y ) || ( 0 != directionX ?
+				( IsWalkable( x, y - 1 ) && !IsWalkable( x - directionX, y - 1 ) ) || ( IsWalkable( x, y + 1 ) && !IsWalkable( x - directionX, y + 1 ) ) :
+				( IsWalkable( x - 1, y ) && !IsWalkable( x - 1, y - directionY ) ) || ( IsWalkable( x + 1, y ) && !IsWalkable( x + 1, y - directionY ) ) );
+
+			if ( isJumpPoint )
+			{
+				jumpPoint = y * _grid.GetWidth( ) + x;
+
+				return true;
+			}
+
+			x += directionX;
+			y += directionY;
+		}
+
+		return false;
+	}
+
+	void Pathfinder::Open( SearchContext &context, const uint32_t &cell, const uint32_t &parent, const float &cost, const uint32_t &goal ) const
+	{
+		if ( context.generation == context.closedGenerations[cell] || ( context.generation == context.openGenerations[cell] && cost >= context.costs[cell] ) )
+		{ return; }
+
+		context.openGenerations[cell] = context.generation;
+		context.costs[cell] = cost;
+		context.parents[cell] = parent;
+
+		context.open.push_back( OpenCell{ cost + Heuristic( cell, goal ), cost, cell } );
+		std::push_heap( context.open.begin( ), context.open.end( ), IsLowerPriority<OpenCell> );
+	}
+
+	float Pathfinder::Heuristic( const uint32_t &cell, const uint32_t &goal ) const
+	{
+		const int differenceX = std::abs( static_cast<int>( cell % _grid.GetWidth( ) ) - static_cast<int>( goal % _grid.GetWidth( ) ) );
+		const int differenceY = std::abs( static_cast<int>( cell / _grid.GetWidth( ) ) - static_cast<int>( goal / _grid.GetWidth( ) ) );
+
+		return std::max( differenceX, differenceY ) + ( DIAGONAL_COST - 1.0f ) * std::min( differenceX, differenceY );
+	}
+}
@@ -0,0 +1,66 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+	namespace
+	{
+		/**
+		 * \brief Global counters, updated by the replacement operator new and delete
+		 */
+		std::atomic<unsigned long long int> allocationCount( 0 );
+		std::atomic<unsigned long long int> deallocationCount( 0 );
+		std::atomic<unsigned long long int> allocatedBytes( 0 );
+	}
+
+	bool AllocationCounter::IsEnabled( )
+	{
+#ifdef SONAR_COUNT_ALLOCATIONS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	unsigned long long int AllocationCounter::GetAllocationCount( )
+	{ return allocationCount; }
+
+	unsigned long long int AllocationCounter::GetDeallocationCount( )
+	{ return deallocationCount; }
+
+	unsigned long long int AllocationCounter::GetAllocatedBytes( )
+	{ return allocatedBytes; }
+}
+
+#ifdef SONAR_COUNT_ALLOCATIONS
+void *operator new( std::size_t size )
+{
+	Sonar::allocationCount.fetch_add( 1, std::memory_order_relaxed );
+	Sonar::allocatedBytes.fetch_add( size, std::memory_order_relaxed );
+
+	if ( void *pointer = std::malloc( size ? size : 1 ) )
+	{ return pointer; }
+
+	throw std::bad_alloc( );
+}
+
+void *operator new[ ]( std::size_t size )
+{ return operator new( size ); }
+
+void operator delete( void *pointer ) noexcept
+{
+	if ( nullptr != pointer )
+	{
+		Sonar::deallocationCount.fetch_add( 1, std::memory_order_relaxed );
+		std::free( pointer );
+	}
+}
+
+void operator delete[ ]( void *pointer ) noexcept
+{ operator delete( pointer ); }
+
+void operator delete( void *pointer, std::size_t size ) noexcept
+{ operator delete( pointer ); }
+
+void operator delete[ ]( void *pointer, std::size_t size ) noexcept
+{ operator delete( pointer ); }
+#endif
@@ -55,7 +55,7 @@ namespace Sonar
 			if ( IsCategoryEnabled( category ) )
 			{
 				if ( newLine )
-				{ spdlog::info( message + "\n" ); }
+				{ spdlog::info( "{}\n", message ); }
 				else
 				{ spdlog::info( message ); }
 			}
@@ -67,7 +67,7 @@ namespace Sonar
 	void Debug::LogStatic( const std::string &message, const bool &newLine )
 	{
 		if ( newLine )
-		{ spdlog::info( message + "\n" ); }
+		{ spdlog::info( "{}\n", message ); }
 		else
 		{ spdlog::info( message ); }
 	}
@@ -81,11 +81,18 @@ namespace Sonar
 		return string;
 	}
 
+	bool Debug::IsEqualIgnoringCase( const std::string &first, const std::string &second )
+	{
+		return first.size( ) == second.size( ) && std::equal( first.begin( ), first.end( ), second.begin( ),
+			[]( unsigned char a, unsigned char b ) { return std::tolower( a ) == std::tolower( b ); }
+		);
+	}
+
 	void Debug::AddCategory( const std::string &category, const bool &isEnabled )
     {
         for ( const auto &element : _categories )
         {
-            if ( ToLower( element.first ) == ToLower( category ) )
+            if ( IsEqualIgnoringCase( element.first, category ) )
             { return; }
         }
 
@@ -96,7 +103,7 @@ namespace Sonar
 	{
 		for ( unsigned int i = 0; i < _categories.size( ); i++ )
 		{
-			if ( ToLower( _categories.at( i ).first ) == ToLower( category ) )
+			if ( IsEqualIgnoringCase( _categories.at( i ).first, category ) )
 			{ _categories.erase( _categories.begin( ) + i ); }
 		}
 	}
@@ -105,7 +112,7 @@ namespace Sonar
 	{
 		for ( unsigned int i = 0; i < _categories.size( ); i++ )
 		{
-			if ( ToLower( _categories.at( i ).first ) == ToLower( category ) )
+			if ( IsEqualIgnoringCase( _categories.at( i ).first, category ) )
 			{ _categories.at( i ).second = isEnabled; }
 		}
 	}
@@ -114,7 +121,7 @@ namespace Sonar
 	{
 		for ( unsigned int i = 0; i < _categories.size( ); i++ )
 		{
-			if ( ToLower( _categories.at( i ).first ) == ToLower( category ) )
+			if ( IsEqualIgnoringCase( _categories.at( i ).first, category ) )
 			{ return _categories.at( i ).second; }
 		}
 
@@ -0,0 +1,67 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+	FrameAllocator::FrameAllocator( const std::size_t &capacity ) : _capacity( capacity )
+	{
+		_buffer.reset( new std::byte[_capacity] );
+
+		_offset = 0;
+		_peakBytes = 0;
+		_allocationCount = _overflowCount = 0;
+	}
+
+	FrameAllocator::~FrameAllocator( ) { }
+
+	void FrameAllocator::Reset( )
+	{
+		_offset = 0;
+		_allocationCount = _overflowCount = 0;
+	}
+
+	std::size_t FrameAllocator::GetCapacity( ) const
+	{ return _capacity; }
+
+	std::size_t FrameAllocator::GetUsedBytes( ) const
+	{ return _offset; }
+
+	std::size_t FrameAllocator::GetPeakBytes( ) const
+	{ return _peakBytes; }
+
+	unsigned int FrameAllocator::GetAllocationCount( ) const
+	{ return _allocationCount; }
+
+	unsigned int FrameAllocator::GetOverflowCount( ) const
+	{ return _overflowCount; }
+
+	void *FrameAllocator::do_allocate( std::size_t bytes, std::size_t alignment )
+	{
+		_allocationCount++;
+
+		const std::uintptr_t start = reinterpret_cast<std::uintptr_t>( _buffer.get( ) );
+		const std::uintptr_t aligned = ( start + _offset + alignment - 1 ) & ~( static_cast<std::uintptr_t>( alignment ) - 1 );
+
+		if ( aligned + bytes > start + _capacity )
+		{
+			_overflowCount++;
+
+			return std::pmr::new_delete_resource( )->allocate( bytes, alignment );
+		}
+
+		_offset = aligned + bytes - start;
+		_peakBytes = std::max( _peakBytes, _offset );
+
+		return reinterpret_cast<void *>( aligned );
+	}
+
+	void FrameAllocator::do_deallocate( void *pointer, std::size_t bytes, std::size_t alignment )
+	{
+		const std::byte *memory = static_cast<const std::byte *>( pointer );
+
+		if ( memory < _buffer.get( ) || memory >= _buffer.get( ) + _capacity )
+		{ std::pmr::new_delete_resource( )->deallocate( pointer, bytes, alignment ); }
+	}
+
+	bool FrameAllocator::do_is_equal( const std::pmr::memory_resource &other ) const noexcept
+	{ return this == &other; }
+}
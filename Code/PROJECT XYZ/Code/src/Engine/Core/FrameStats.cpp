@@ -0,0 +1,161 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+	FrameStats::FrameStats( )
+	{
+		_frames.fill( Frame{ } );
+		_currentFrame = Frame{ };
+
+		_nextIndex = 0;
+		_frameCount = 0;
+		_totalFrameCount = 0;
+		_frameTimeSum = 0;
+
+		_isOverlayVisible = DEFAULT_FRAME_STATS_OVERLAY_VISIBLE;
+		_overlayCorner = DEFAULT_FRAME_STATS_OVERLAY_CORNER;
+	}
+
+	FrameStats::~FrameStats( ) { }
+
+	FrameStats::Frame &FrameStats::GetCurrentFrame( )
+	{ return _currentFrame; }
+
+	void FrameStats::AddDrawCall( const unsigned int &vertexCount )
+	{
+		_currentFrame.drawCalls++;
+		_currentFrame.vertexCount += vertexCount;
+	}
+
+	void FrameStats::EndFrame( )
+	{
+		// The overwritten frame leaves the history so it no longer counts towards the average
+		if ( _frames.size( ) == _frameCount )
+		{ _frameTimeSum -= _frames.at( _nextIndex ).frameTime; }
+		else
+		{ _frameCount++; }
+
+		_frames.at( _nextIndex ) = _currentFrame;
+		_frameTimeSum += _currentFrame.frameTime;
+
+		_nextIndex = ( _nextIndex + 1 ) % _frames.size( );
+		_totalFrameCount++;
+
+		_currentFrame = Frame{ };
+	}
+
+	const FrameStats::Frame &FrameStats::GetFrame( const unsigned int &framesAgo ) const
+	{
+		const unsigned int offset = ( framesAgo < _frameCount ) ? framesAgo : ( _frameCount > 0 ? _frameCount - 1 : 0 );
+
+		return _frames.at( ( _nextIndex + _frames.size( ) - 1 - offset ) % _frames.size( ) );
+	}
+
+	unsigned int FrameStats::GetFrameCount( ) const
+	{ return _frameCount; }
+
+	unsigned long long int FrameStats::GetTotalFrameCount( ) const
+	{ return _totalFrameCount; }
+
+	float FrameStats::GetAverageFrameTime( ) const
+	{
+		if ( 0 == _frameCount )
+		{ return 0; }
+		else
+		{ return static_cast<float>( _frameTimeSum / _frameCount ); }
+	}
+
+	float FrameStats::GetFPS( ) const
+	{
+		const float averageFrameTime = GetAverageFrameTime( );
+
+		if ( 0 >= averageFrameTime )
+		{ return 0; }
+		else
+		{ return 1000.0f / averageFrameTime; }
+	}
+
+	void FrameStats::ShowOverlay( )
+	{ _isOverlayVisible = true; }
+
+	void FrameStats::HideOverlay( )
+	{ _isOverlayVisible = false; }
+
+	bool FrameStats::IsOverlayVisible( ) const
+	{ return _isOverlayVisible; }
+
+	void FrameStats::SetOverlayCorner( const CORNER &corner )
+	{ _overlayCorner = corner; }
+
+	FrameStats::CORNER FrameStats::GetOverlayCorner( ) const
+	{ return _overlayCorner; }
+
+	void FrameStats::DrawOverlay( ) const
+	{
+		if ( !_isOverlayVisible || 0 == _frameCount )
+		{ return; }
+
+		const bool isRight = ( CORNER::TOP_RIGHT == _overlayCorner || CORNER::BOTTOM_RIGHT == _overlayCorner );
+		const bool isBottom = ( CORNER::BOTTOM_LEFT == _overlayCorner || CORNER::BOTTOM_RIGHT == _overlayCorner );
+		const ImVec2 displaySize = ImGui::GetIO( ).DisplaySize;
+		const float margin = DEFAULT_FRAME_STATS_OVERLAY_MARGIN;
+
+		ImGui::SetNextWindowPos( ImVec2( isRight ? displaySize.x - margin : margin, isBottom ? displaySize.y - margin : margin ), ImGuiCond_Always, ImVec2( isRight ? 1.0f : 0.0f, isBottom ? 1.0f : 0.0f ) );
+		ImGui::SetNextWindowBgAlpha( DEFAULT_FRAME_STATS_OVERLAY_BACKGROUND_ALPHA );
+
+		const ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove;
+
+		if ( ImGui::Begin( "Frame Stats", nullptr, flags ) )
+		{
+			const Frame &frame = GetFrame( );
+			const float targetFrameTime = DEFAULT_FRAME_STATS_TARGET_FRAME_TIME;
+			const float averageFrameTime = GetAverageFrameTime( );
+
+			// Doom style counter, green while the target is met, yellow when slipping and red when it's badly missed
+			ImVec4 color( 0.0f, 1.0f, 0.0f, 1.0f );
+
+			if ( averageFrameTime > targetFrameTime * 2.0f )
+			{ color = ImVec4( 1.0f, 0.0f, 0.0f, 1.0f ); }
+			else if ( averageFrameTime > targetFrameTime * 1.05f )
+			{ color = ImVec4( 1.0f, 1.0f, 0.0f, 1.0f ); }
+
+			ImGui::TextColored( color, "%.0f FPS", GetFPS( ) );
+			ImGui::SameLine( );
+			ImGui::TextColored( color, "%.2f ms", averageFrameTime );
+
+			ImGui::Separator( );
+
+			ImGui::Text( "Update: %.2f ms (%u steps)", frame.updateTime, frame.fixedSteps );
+			ImGui::Text( "Draw:   %.2f ms", frame.drawTime );
+			ImGui::Text( "ImGui:  %.2f ms", frame.imGuiTime );
+			ImGui::Text( "Draw calls: %u", frame.drawCalls );
+			ImGui::Text( "Vertices:   %u", frame.vertexCount );
+			ImGui::Text( "Frame allocator: %.1f KB", frame.frameAllocatorBytes / 1024.0f );
+
+			if ( AllocationCounter::IsEnabled( ) )
+			{ ImGui::Text( "Heap allocations: %u", frame.allocations ); }
+
+			ImGui::Separator( );
+
+			// The graphs read straight from the ring buffer, the offset starts them at the oldest frame
+			const int offset = ( _frames.size( ) == _frameCount ) ? _nextIndex : 0;
+			const ImVec2 graphSize( DEFAULT_FRAME_STATS_OVERLAY_GRAPH_WIDTH, DEFAULT_FRAME_STATS_OVERLAY_GRAPH_HEIGHT );
+
+			ImGui::PlotLines( "Frame", &_frames.at( 0 ).frameTime, _frameCount, offset, nullptr, 0.0f, targetFrameTime * 2.0f, graphSize, sizeof( Frame ) );
+			ImGui::PlotLines( "Update", &_frames.at( 0 ).updateTime, _frameCount, offset, nullptr, 0.0f, targetFrameTime, graphSize, sizeof( Frame ) );
+			ImGui::PlotLines( "Draw", &_frames.at( 0 ).drawTime, _frameCount, offset, nullptr, 0.0f, targetFrameTime, graphSize, sizeof( Frame ) );
+			ImGui::PlotLines( "ImGui", &_frames.at( 0 ).imGuiTime, _frameCount, offset, nullptr, 0.0f, targetFrameTime, graphSize, sizeof( Frame ) );
+
+			ImGui::Separator( );
+
+			Profiler *profiler = Profiler::getInstance( );
+
+			if ( profiler->IsCapturing( ) )
+			{ ImGui::Text( "Capturing trace (%u frames left)", profiler->GetFramesLeft( ) ); }
+			else if ( ImGui::Button( "Capture Trace" ) )
+			{ profiler->CaptureFrames( DEFAULT_PROFILER_CAPTURE_FRAMES, DEFAULT_PROFILER_TRACE_FILEPATH ); }
+		}
+
+		ImGui::End( );
+	}
+}
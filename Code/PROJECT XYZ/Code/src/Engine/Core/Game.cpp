@@ -3,16 +3,39 @@
 
 namespace Sonar
 {
-	Game::Game( const int &width, const int &height, const std::string &title )
+	Game::Game( const int &width, const int &height, const std::string &title, const bool &isMultithreaded, const std::string &recordFilepath, const std::string &replayFilepath ) : _isMultithreaded( isMultithreaded )
 	{
         _data->debug = Debug::getInstance( );
+
+		// Packed resources replace the loose files in Resources once the pack has been built
+		if ( std::filesystem::exists( DEFAULT_ASSET_PACK_FILEPATH ) )
+		{ _data->assets.MountPack( DEFAULT_ASSET_PACK_FILEPATH ); }
         
 		Window::Style style;
 
 		_data->window.Setup( width, height, title, style );
+		ImGui::SFML::Init( _data->window.GetSFMLWindowObject( ) );
+
 		_data->machine.AddState( StateRef( new SplashState( _data ) ) );
 
-		Run( );
+		if ( !replayFilepath.empty( ) )
+		{
+			if ( !_data->inputRecorder.StartReplay( replayFilepath ) )
+			{ Debug::LogStatic( "Couldn't load the input log " + replayFilepath ); }
+			else if ( std::abs( _data->inputRecorder.GetReplayDt( ) - dt ) > 0.000001f )
+			{ Debug::LogStatic( "Input replay " + replayFilepath + " was recorded at a different dt, the session will not match the recording" ); }
+		}
+		else if ( !recordFilepath.empty( ) && !_data->inputRecorder.StartRecording( recordFilepath, dt ) )
+		{ Debug::LogStatic( "Couldn't open the input log " + recordFilepath ); }
+
+		if ( _isMultithreaded )
+		{ RunMultithreaded( ); }
+		else
+		{ Run( ); }
+
+		// The log is only complete once the session length is written
+		if ( _data->inputRecorder.IsRecording( ) )
+		{ _data->inputRecorder.StopRecording( ); }
 	}
 
 	void Game::Run( )
@@ -22,57 +45,354 @@ namespace Sonar
 		float currentTime = _clock.GetElapsedTime( ).AsSeconds( );
 		float accumulator = 0.0f;
 
+		Profiler::getInstance( )->SetThreadName( "Main" );
+
 		while ( _data->window.IsOpen( ) )
 		{
-			frames++;
+			SONAR_PROFILE_SCOPE( "Frame" );
+
+			_data->frameAllocator.Reset( );
+
+			FrameStats::Frame &stats = _data->frameStats.GetCurrentFrame( );
+			const unsigned long long int frameAllocationCount = AllocationCounter::GetAllocationCount( );
+
+			{
+				SONAR_PROFILE_SCOPE( "Process State Changes" );
+				_data->machine.ProcessStateChanges( );
+			}
 
-			_data->machine.ProcessStateChanges( );
+			_data->assets.ProcessUploads( );
 
 			newTime = _clock.GetElapsedTime( ).AsSeconds( );
 			frameTime = newTime - currentTime;
 
+			stats.frameTime = Time::SecondsToMilliseconds( frameTime );
+
 			if ( frameTime > 0.25f )
 			{ frameTime = 0.25f; }
 
 			currentTime = newTime;
 			accumulator += frameTime;
 
+			long long sectionStart = _clock.GetElapsedTime( ).AsMicroseconds( );
+
 			while ( accumulator >= dt )
 			{
-				Sonar::Event event;
-                
-                while ( _data->window.PollEvent( event ) )
-                {
-                    if ( Sonar::Event::EventType::Closed == event.type )
-                    { _data->window.CloseWindow( ); }
-                                        
-                    _data->machine.GetActiveState( )->PollInput( dt, event );
-                }
-                
-				_data->machine.GetActiveState( )->Update( dt );
+				SONAR_PROFILE_SCOPE( "Fixed Step" );
+
+				{
+					SONAR_PROFILE_SCOPE( "Poll Events" );
+
+					Sonar::Event event;
+
+					while ( _data->window.PollEvent( event ) )
+					{
+						if ( Sonar::Event::EventType::Closed == event.type )
+						{ _data->window.CloseWindow( ); }
+
+						if ( Sonar::Event::EventType::KeyPressed == event.type && DEFAULT_PROFILER_CAPTURE_KEY == event.key.code )
+						{ Profiler::getInstance( )->CaptureFrames( DEFAULT_PROFILER_CAPTURE_FRAMES, DEFAULT_PROFILER_TRACE_FILEPATH ); }
+
+						// Live input is ignored during a replay so the session plays out exactly as recorded
+						if ( _data->inputRecorder.IsReplaying( ) )
+						{ continue; }
+
+						_data->inputRecorder.Record( event );
+						_data->machine.GetActiveState( )->PollInput( dt, event );
+					}
+
+					while ( _data->inputRecorder.GetReplayEvent( event ) )
+					{ _data->machine.GetActiveState( )->PollInput( dt, event ); }
+				}
+
+				{
+					SONAR_PROFILE_SCOPE( "Update" );
+
+					_data->machine.GetActiveState( )->Update( dt );
+					_data->snapshots.Publish( );
+				}
+
+				_data->inputRecorder.EndStep( );
 
 				accumulator -= dt;
+				stats.fixedSteps++;
 			}
 
 			interpolation = accumulator / dt;
 
+			stats.updateTime = Time::MicrosecondsToMilliseconds( _clock.GetElapsedTime( ).AsMicroseconds( ) - sectionStart );
+            
+			_data->window.Clear( _data->backgroundColor );
 
+			sectionStart = _clock.GetElapsedTime( ).AsMicroseconds( );
 
-			spdlog::info( "FPS: {}", 1.0f / frameTime );
-			spdlog::info( "Frame Time: {}ms", frameTime * 1000 );
-			spdlog::info( "Total Number Of Frames: {}", frames );
+			{
+				SONAR_PROFILE_SCOPE( "ImGui Update" );
+				ImGui::SFML::Update( _data->window.GetSFMLWindowObject( ), _imGUIClock.SFMLRestart( ) );
+			}
 
+			stats.imGuiTime = Time::MicrosecondsToMilliseconds( _clock.GetElapsedTime( ).AsMicroseconds( ) - sectionStart );
+
+			sectionStart = _clock.GetElapsedTime( ).AsMicroseconds( );
+
+			{
+				SONAR_PROFILE_SCOPE( "Draw" );
+
+				_data->snapshots.Acquire( );
+				_data->machine.GetActiveState( )->Draw( interpolation );
+			}
+
+			{
+				SONAR_PROFILE_SCOPE( "Sprite Batch Flush" );
+
+				_data->spriteBatch.Flush( _data->window.GetSFMLWindowObject( ) );
+				_data->spriteBatch.EndFrame( );
+			}
+
+			stats.drawTime = Time::MicrosecondsToMilliseconds( _clock.GetElapsedTime( ).AsMicroseconds( ) - sectionStart );
+			stats.drawCalls += _data->spriteBatch.GetDrawCallCount( );
+			stats.vertexCount += _data->spriteBatch.GetVertexCount( );
+
+			sectionStart = _clock.GetElapsedTime( ).AsMicroseconds( );
+
+			{
+				SONAR_PROFILE_SCOPE( "ImGui Render" );
+
+				_data->frameStats.DrawOverlay( );
+				_data->assets.DrawResidencyWindow( );
+				ImGui::SFML::Render( _data->window.GetSFMLWindowObject( ) );
+			}
+
+			stats.imGuiTime += Time::MicrosecondsToMilliseconds( _clock.GetElapsedTime( ).AsMicroseconds( ) - sectionStart );
+
+			{
+				SONAR_PROFILE_SCOPE( "Display" );
+				_data->window.Display( );
+			}
+
+			stats.allocations = AllocationCounter::GetAllocationCount( ) - frameAllocationCount;
+			stats.frameAllocatorBytes = _data->frameAllocator.GetUsedBytes( );
+			_data->assets.EndFrame( );
+			_data->frameStats.EndFrame( );
+			Profiler::getInstance( )->EndFrame( );
+		}
+	}
+
+	void Game::RunMultithreaded( )
+	{
+		// The window has to be polled and drawn to on the thread that created it, so this thread renders
+		_data->machine.ProcessStateChanges( );
+
+		_pendingFixedSteps = 0;
+		_pendingUpdateTime = 0;
+		_isSimulationRunning = true;
+		_simulationThread = std::thread( &Game::RunSimulation, this );
+
+		float newTime, frameTime, interpolation;
+
+		float currentTime = _clock.GetElapsedTime( ).AsSeconds( );
+
+		Profiler::getInstance( )->SetThreadName( "Render" );
+
+		while ( _data->window.IsOpen( ) )
+		{
+			SONAR_PROFILE_SCOPE( "Frame" );
+
+			_data->frameAllocator.Reset( );
+
+			FrameStats::Frame &stats = _data->frameStats.GetCurrentFrame( );
+			const unsigned long long int frameAllocationCount = AllocationCounter::GetAllocationCount( );
+
+			newTime = _clock.GetElapsedTime( ).AsSeconds( );
+			frameTime = newTime - currentTime;
+			currentTime = newTime;
+
+			stats.frameTime = Time::SecondsToMilliseconds( frameTime );
+
+			{
+				SONAR_PROFILE_SCOPE( "Poll Events" );
+
+				Sonar::Event event;
+
+				while ( _data->window.PollEvent( event ) )
+				{
+					if ( Sonar::Event::EventType::Closed == event.type )
+					{ _data->window.CloseWindow( ); }
+
+					if ( Sonar::Event::EventType::KeyPressed == event.type && DEFAULT_PROFILER_CAPTURE_KEY == event.key.code )
+					{ Profiler::getInstance( )->CaptureFrames( DEFAULT_PROFILER_CAPTURE_FRAMES, DEFAULT_PROFILER_TRACE_FILEPATH ); }
+
+					std::lock_guard<std::mutex> lock( _eventMutex );
+					_eventQueue.push_back( event );
+				}
+			}
+
+			// Uploads need the render thread's context, the simulation thread only requests loads
+			{
+				// States use the asset manager during their steps, so it's only touched here with the state lock held
+				std::lock_guard<std::mutex> lock( _stateMutex );
+				_data->assets.ProcessUploads( );
+			}
+
+			stats.fixedSteps = _pendingFixedSteps.exchange( 0 );
+			stats.updateTime = Time::MicrosecondsToMilliseconds( _pendingUpdateTime.exchange( 0 ) );
+
+			// Draw one step behind the simulation, blending towards the latest snapshot as time passes
+			interpolation = std::min( 1.0f, _data->snapshots.GetTimeSinceLatest( ) / dt );
 
-            
 			_data->window.Clear( _data->backgroundColor );
 
-			ImGui::SFML::Update( _data->window.GetSFMLWindowObject( ), _imGUIClock.SFMLRestart( ) );
+			long long sectionStart = _clock.GetElapsedTime( ).AsMicroseconds( );
 
-			_data->machine.GetActiveState( )->Draw( interpolation );
+			{
+				SONAR_PROFILE_SCOPE( "ImGui Update" );
+				ImGui::SFML::Update( _data->window.GetSFMLWindowObject( ), _imGUIClock.SFMLRestart( ) );
+			}
 
-			ImGui::SFML::Render( _data->window.GetSFMLWindowObject( ) );
-            
-            _data->window.Display( );
+			stats.imGuiTime = Time::MicrosecondsToMilliseconds( _clock.GetElapsedTime( ).AsMicroseconds( ) - sectionStart );
+
+			sectionStart = _clock.GetElapsedTime( ).AsMicroseconds( );
+
+			{
+				SONAR_PROFILE_SCOPE( "Draw" );
+
+				_data->snapshots.Acquire( );
+
+				std::lock_guard<std::mutex> lock( _stateMutex );
+
+				if ( !_data->machine.IsEmpty( ) )
+				{ _data->machine.GetActiveState( )->Draw( interpolation ); }
+			}
+
+			{
+				SONAR_PROFILE_SCOPE( "Sprite Batch Flush" );
+
+				_data->spriteBatch.Flush( _data->window.GetSFMLWindowObject( ) );
+				_data->spriteBatch.EndFrame( );
+			}
+
+			stats.drawTime = Time::MicrosecondsToMilliseconds( _clock.GetElapsedTime( ).AsMicroseconds( ) - sectionStart );
+			stats.drawCalls += _data->spriteBatch.GetDrawCallCount( );
+			stats.vertexCount += _data->spriteBatch.GetVertexCount( );
+
+			sectionStart = _clock.GetElapsedTime( ).AsMicroseconds( );
+
+			{
+				SONAR_PROFILE_SCOPE( "ImGui Render" );
+
+				_data->frameStats.DrawOverlay( );
+
+				{
+					std::lock_guard<std::mutex> lock( _stateMutex );
+					_data->assets.DrawResidencyWindow( );
+				}
+
+				ImGui::SFML::Render( _data->window.GetSFMLWindowObject( ) );
+			}
+
+			stats.imGuiTime += Time::MicrosecondsToMilliseconds( _clock.GetElapsedTime( ).AsMicroseconds( ) - sectionStart );
+
+			{
+				SONAR_PROFILE_SCOPE( "Display" );
+				_data->window.Display( );
+			}
+
+			// Includes the simulation thread's allocations made during the frame
+			stats.allocations = AllocationCounter::GetAllocationCount( ) - frameAllocationCount;
+			stats.frameAllocatorBytes = _data->frameAllocator.GetUsedBytes( );
+
+			{
+				std::lock_guard<std::mutex> lock( _stateMutex );
+				_data->assets.EndFrame( );
+			}
+
+			_data->frameStats.EndFrame( );
+			Profiler::getInstance( )->EndFrame( );
+		}
+
+		_isSimulationRunning = false;
+		_simulationThread.join( );
+	}
+
+	void Game::RunSimulation( )
+	{
+		std::vector<Event> events;
+
+		float newTime, frameTime;
+
+		float currentTime = _clock.GetElapsedTime( ).AsSeconds( );
+		float accumulator = 0.0f;
+
+		Profiler::getInstance( )->SetThreadName( "Simulation" );
+
+		while ( _isSimulationRunning )
+		{
+			newTime = _clock.GetElapsedTime( ).AsSeconds( );
+			frameTime = newTime - currentTime;
+
+			if ( frameTime > 0.25f )
+			{ frameTime = 0.25f; }
+
+			currentTime = newTime;
+			accumulator += frameTime;
+
+			const long long sectionStart = _clock.GetElapsedTime( ).AsMicroseconds( );
+
+			while ( accumulator >= dt )
+			{
+				SONAR_PROFILE_SCOPE( "Fixed Step" );
+
+				// The whole step holds the state lock, Draw reads the same drawables and the asset manager isn't thread safe
+				std::lock_guard<std::mutex> stateLock( _stateMutex );
+
+				_data->machine.ProcessStateChanges( );
+
+				// Swapping keeps both vectors' capacity so the queue doesn't reallocate every step
+				{
+					std::lock_guard<std::mutex> lock( _eventMutex );
+					events.swap( _eventQueue );
+				}
+
+				if ( !_data->machine.IsEmpty( ) )
+				{
+					{
+						SONAR_PROFILE_SCOPE( "Poll Events" );
+
+						if ( !_data->inputRecorder.IsReplaying( ) )
+						{
+							for ( auto &event : events )
+							{
+								_data->inputRecorder.Record( event );
+								_data->machine.GetActiveState( )->PollInput( dt, event );
+							}
+						}
+
+						Sonar::Event event;
+
+						while ( _data->inputRecorder.GetReplayEvent( event ) )
+						{ _data->machine.GetActiveState( )->PollInput( dt, event ); }
+					}
+
+					SONAR_PROFILE_SCOPE( "Update" );
+
+					_data->machine.GetActiveState( )->Update( dt );
+					_data->snapshots.Publish( );
+				}
+
+				_data->inputRecorder.EndStep( );
+				events.clear( );
+
+				accumulator -= dt;
+				_pendingFixedSteps++;
+			}
+
+			_pendingUpdateTime += _clock.GetElapsedTime( ).AsMicroseconds( ) - sectionStart;
+
+			// Sleep until the next step is due instead of spinning a core
+			const float timeUntilNextStep = dt - accumulator;
+
+			if ( timeUntilNextStep > 0.001f )
+			{ std::this_thread::sleep_for( std::chrono::microseconds( Time::SecondsToMicroseconds( timeUntilNextStep ) - 500 ) ); }
 		}
 	}
-}
+}
\ No newline at end of file
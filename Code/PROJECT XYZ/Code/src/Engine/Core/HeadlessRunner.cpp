@@ -0,0 +1,160 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+	HeadlessRunner::HeadlessRunner( const float &dt ) : _dt( dt )
+	{
+		_data = std::make_shared<GameData>( );
+		_data->debug = Debug::getInstance( );
+
+		_eventGenerator = nullptr;
+		_currentStep = 0;
+		_isRunning = false;
+	}
+
+	HeadlessRunner::~HeadlessRunner( ) { }
+
+	GameDataRef HeadlessRunner::GetGameData( ) const
+	{ return _data; }
+
+	void HeadlessRunner::AddState( StateRef newState, const bool &isReplacing )
+	{ _data->machine.AddState( std::move( newState ), isReplacing ); }
+
+	void HeadlessRunner::QueueEvent( const unsigned long long int &step, const Event &event )
+	{
+		// Keep the queue ordered by step, events for the same step stay in the order they were queued
+		auto position = std::upper_bound( _events.begin( ), _events.end( ), step,
+			[]( const unsigned long long int &value, const std::pair<unsigned long long int, Event> &queued ) { return value < queued.first; }
+		);
+
+		_events.insert( position, std::make_pair( step, event ) );
+	}
+
+	void HeadlessRunner::SetEventGenerator( const EventGenerator &generator )
+	{ _eventGenerator = generator; }
+
+	HeadlessRunner::Report HeadlessRunner::Run( const unsigned long long int &steps )
+	{
+		Report report{ };
+
+		_isRunning = true;
+		_clock.Reset( );
+
+		while ( _isRunning && report.steps < steps )
+		{
+			SONAR_PROFILE_SCOPE( "Headless Step" );
+
+			_data->frameAllocator.Reset( );
+			_data->machine.ProcessStateChanges( );
+			_data->assets.ProcessUploads( );
+
+			if ( _data->machine.IsEmpty( ) )
+			{ break; }
+
+			StateRef &state = _data->machine.GetActiveState( );
+
+			// Queued events left behind by earlier steps are dropped rather than delivered late
+			while ( !_events.empty( ) && _events.front( ).first <= _currentStep )
+			{
+				if ( _events.front( ).first == _currentStep )
+				{
+					Event &event = _events.front( ).second;
+
+					if ( Sonar::Event::EventType::Closed == event.type )
+					{ Stop( ); }
+
+					_data->inputRecorder.Record( event );
+					state->PollInput( _dt, event );
+					report.events++;
+				}
+
+				_events.pop_front( );
+			}
+
+			if ( _eventGenerator )
+			{
+				Event event;
+
+				while ( _eventGenerator( _currentStep, event ) )
+				{
+					if ( Sonar::Event::EventType::Closed == event.type )
+					{ Stop( ); }
+
+					_data->inputRecorder.Record( event );
+					state->PollInput( _dt, event );
+					report.events++;
+
+					event = Event( );
+				}
+			}
+
+			{
+				Event event;
+
+				while ( _data->inputRecorder.GetReplayEvent( event ) )
+				{
+					if ( Sonar::Event::EventType::Closed == event.type )
+					{ Stop( ); }
+
+					state->PollInput( _dt, event );
+					report.events++;
+				}
+			}
+
+			{
+				SONAR_PROFILE_SCOPE( "Update" );
+
+				state->Update( _dt );
+				_data->snapshots.Publish( );
+			}
+
+			_data->inputRecorder.EndStep( );
+			_data->assets.EndFrame( );
+			Profiler::getInstance( )->EndFrame( );
+
+			_currentStep++;
+			report.steps++;
+		}
+
+		_isRunning = false;
+
+		report.realTime = _clock.GetElapsedTime( ).AsSeconds( );
+		report.simulatedTime = report.steps * _dt;
+
+		if ( 0 < report.realTime )
+		{ report.stepsPerSecond = report.steps / report.realTime; }
+
+		return report;
+	}
+
+	HeadlessRunner::Report HeadlessRunner::RunReplay( const std::string &filepath )
+	{
+		InputRecorder &recorder = _data->inputRecorder;
+
+		if ( !recorder.StartReplay( filepath ) )
+		{ return Report{ }; }
+
+		// Replays only reproduce the session when stepped at the rate they were recorded at
+		if ( std::abs( recorder.GetReplayDt( ) - _dt ) > 0.000001f )
+		{ Debug::LogStatic( "Input replay " + filepath + " was recorded at a different dt, the run will not match the recording" ); }
+
+		return Run( recorder.GetReplayLength( ) );
+	}
+
+	void HeadlessRunner::Stop( )
+	{ _isRunning = false; }
+
+	unsigned long long int HeadlessRunner::GetCurrentStep( ) const
+	{ return _currentStep; }
+
+	void HeadlessRunner::LogReport( const Report &report ) const
+	{
+		std::stringstream ss;
+
+		ss << "Headless run: " << report.steps << " steps (" << report.simulatedTime << "s simulated) in " << report.realTime << "s, "
+			<< report.stepsPerSecond << " steps/s (" << report.simulatedTime / std::max( report.realTime, 0.000001f ) << "x real time), "
+			<< report.events << " events";
+
+		Debug::LogStatic( ss.str( ) );
+	}
+}
@@ -0,0 +1,241 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+	namespace
+	{
+		/**
+		 * \brief Job system and queue owned by the current worker thread
+		 */
+		thread_local const JobSystem *workerJobSystem = nullptr;
+		thread_local unsigned int workerQueueIndex = 0;
+	}
+
+	JobSystem::JobSystem( const unsigned int &threadCount )
+	{
+		unsigned int workerCount = threadCount;
+
+		if ( 0 == workerCount )
+		{
+			const unsigned int coreCount = std::thread::hardware_concurrency( );
+
+			workerCount = ( coreCount > 1 ) ? coreCount - 1 : 0;
+		}
+
+		_queuedJobCount = 0;
+		_isRunning = true;
+
+		for ( unsigned int i = 0; i < workerCount + 1; i++ )
+		{ _queues.push_back( std::unique_ptr<WorkQueue>( new WorkQueue( ) ) ); }
+
+		for ( unsigned int i = 0; i < workerCount; i++ )
+		{ _threads.push_back( std::thread( &JobSystem::RunWorker, this, i ) ); }
+	}
+
+	JobSystem::~JobSystem( )
+	{
+		{
+			std::lock_guard<std::mutex> lock( _wakeMutex );
+			_isRunning = false;
+		}
+
+		_wakeCondition.notify_all( );
+
+		for ( auto &thread : _threads )
+		{ thread.join( ); }
+	}
+
+	JobSystem::JobRef JobSystem::CreateJob( const std::function<void( )> &function )
+	{
+		JobRef job = std::make_shared<Job>( );
+
+		job->_function = function;
+		job->_pendingDependencies = 1;
+		job->_isFinished = false;
+
+		return job;
+	}
+
+	void JobSystem::AddDependency( const JobRef &job, const JobRef &dependency )
+	{
+		std::lock_guard<std::mutex> lock( dependency->_mutex );
+
+		// A dependency that has already finished has nothing to wait for
+		if ( !dependency->_isFinished )
+		{
+			job->_pendingDependencies++;
+			dependency->_dependents.push_back( job );
+		}
+	}
+
+	void JobSystem::Submit( const JobRef &job )
+	{
+		if ( 0 == --job->_pendingDependencies )
+		{ Enqueue( job ); }
+	}
+
+	JobSystem::JobRef JobSystem::Schedule( const std::function<void( )> &function )
+	{
+		JobRef job = CreateJob( function );
+		Submit( job );
+
+		return job;
+	}
+
+	void JobSystem::Wait( const JobRef &job )
+	{
+		while ( !job->_isFinished )
+		{
+			if ( !RunQueuedJob( ) )
+			{ std::this_thread::yield( ); }
+		}
+	}
+
+	void JobSystem::Wait( const std::vector<JobRef> &jobs )
+	{
+		for ( const auto &job : jobs )
+		{ Wait( job ); }
+	}
+
+	void JobSystem::ParallelFor( const unsigned int &count, const std::function<void( const unsigned int &begin, const unsigned int &end )> &function, const unsigned int &grainSize )
+	{
+		const unsigned int rangeSize = std::max( 1u, grainSize );
+
+		if ( count <= rangeSize || _threads.empty( ) )
+		{
+			if ( 0 < count )
+			{ function( 0, count ); }
+
+			return;
+		}
+
+		// No point making more ranges than there are threads to run them
+		const unsigned int threadCount = _threads.size( ) + 1;
+		const unsigned int rangeCount = std::min( ( count + rangeSize - 1 ) / rangeSize, threadCount );
+		const unsigned int iterationsPerRange = ( count + rangeCount - 1 ) / rangeCount;
+
+		std::vector<JobRef> jobs;
+		jobs.reserve( rangeCount - 1 );
+
+		for ( unsigned int begin = iterationsPerRange; begin < count; begin += iterationsPerRange )
+		{
+			const unsigned int end = std::min( count, begin + iterationsPerRange );
+
+			jobs.push_back( Schedule( [&function, begin, end]( ) { function( begin, end ); } ) );
+		}
+
+		// The calling thread takes the first range itself and then helps with the rest
+		function( 0, std::min( count, iterationsPerRange ) );
+
+		Wait( jobs );
+	}
+
+	unsigned int JobSystem::GetThreadCount( ) const
+	{ return _threads.size( ); }
+
+	void JobSystem::RunWorker( const unsigned int &index )
+	{
+		workerJobSystem = this;
+		workerQueueIndex = index;
+
+		Profiler::getInstance( )->SetThreadName( "Job Worker " + std::to_string( index ) );
+
+		while ( _isRunning )
+		{
+			if ( RunQueuedJob( ) )
+			{ continue; }
+
+			std::unique_lock<std::mutex> lock( _wakeMutex );
+			_wakeCondition.wait( lock, [this]( ) { return 0 < _queuedJobCount || !_isRunning; } );
+		}
+	}
+
+	bool JobSystem::RunQueuedJob( )
+	{
+		const unsigned int ownIndex = GetQueueIndex( );
+
+		JobRef job;
+
+		{
+			WorkQueue &queue = *_queues.at( ownIndex );
+			std::lock_guard<std::mutex> lock( queue.mutex );
+
+			if ( !queue.jobs.empty( ) )
+			{
+				job = queue.jobs.back( );
+				queue.jobs.pop_back( );
+			}
+		}
+
+		// Steal the oldest job from another queue, starting with the next one along so thieves spread out
+		for ( unsigned int i = 1; !job && i < _queues.size( ); i++ )
+		{
+			WorkQueue &queue = *_queues.at( ( ownIndex + i ) % _queues.size( ) );
+			std::lock_guard<std::mutex> lock( queue.mutex );
+
+			if ( !queue.jobs.empty( ) )
+			{
+				job = queue.jobs.front( );
+				queue.jobs.pop_front( );
+			}
+		}
+
+		if ( !job )
+		{ return false; }
+
+		_queuedJobCount--;
+
+		{
+			SONAR_PROFILE_SCOPE( "Job" );
+			job->_function( );
+		}
+
+		Finish( job );
+
+		return true;
+	}
+
+	void JobSystem::Enqueue( const JobRef &job )
+	{
+		{
+			WorkQueue &queue = *_queues.at( GetQueueIndex( ) );
+			std::lock_guard<std::mutex> lock( queue.mutex );
+
+			queue.jobs.push_back( job );
+		}
+
+		{
+			// Taking the lock stops a worker missing the wake up between checking the count and sleeping
+			std::lock_guard<std::mutex> lock( _wakeMutex );
+			_queuedJobCount++;
+		}
+
+		_wakeCondition.notify_one( );
+	}
+
+	void JobSystem::Finish( const JobRef &job )
+	{
+		std::vector<JobRef> dependents;
+
+		{
+			std::lock_guard<std::mutex> lock( job->_mutex );
+
+			job->_isFinished = true;
+			dependents.swap( job->_dependents );
+		}
+
+		for ( const auto &dependent : dependents )
+		{
+			if ( 0 == --dependent->_pendingDependencies )
+			{ Enqueue( dependent ); }
+		}
+	}
+
+	unsigned int JobSystem::GetQueueIndex( ) const
+	{
+		if ( this == workerJobSystem )
+		{ return workerQueueIndex; }
+		else
+		{ return _queues.size( ) - 1; }
+	}
+}
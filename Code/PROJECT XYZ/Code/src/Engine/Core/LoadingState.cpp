@@ -0,0 +1,46 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+	LoadingState::LoadingState( GameDataRef data ) : _data( data )
+	{
+		_spinner = nullptr;
+		_progressBar = nullptr;
+	}
+
+	LoadingState::~LoadingState( )
+	{
+		delete _spinner;
+		delete _progressBar;
+	}
+
+	void LoadingState::Init( )
+	{
+		_spinner = new Rectangle( _data, DEFAULT_LOADING_STATE_SPINNER_SIZE, DEFAULT_LOADING_STATE_SPINNER_SIZE );
+		_spinner->SetInsideColor( DEFAULT_LOADING_STATE_SPINNER_COLOR );
+		_spinner->SetPivot( OBJECT_POINTS::CENTER );
+		_spinner->SetPosition( _data->window.GetSize( ).x * 0.5f, _data->window.GetSize( ).y * 0.5f );
+
+		_progressBar = new Rectangle( _data, 0.0f, DEFAULT_LOADING_STATE_PROGRESS_BAR_HEIGHT );
+		_progressBar->SetInsideColor( DEFAULT_LOADING_STATE_SPINNER_COLOR );
+		_progressBar->SetPosition( ( _data->window.GetSize( ).x - DEFAULT_LOADING_STATE_PROGRESS_BAR_WIDTH ) * 0.5f, _data->window.GetSize( ).y * 0.5f + DEFAULT_LOADING_STATE_SPINNER_SIZE );
+	}
+
+	void LoadingState::PollInput( const float &dt, Event &event ) { }
+
+	void LoadingState::Update( const float &dt )
+	{ _spinner->Rotate( DEFAULT_LOADING_STATE_SPINNER_SPEED * dt ); }
+
+	void LoadingState::Draw( const float &dt )
+	{
+		_spinner->Draw( );
+
+		const AssetManager::LoadProgress progress = _data->assets.GetLoadProgress( );
+
+		if ( progress.IsFinished( ) )
+		{ return; }
+
+		_progressBar->SetWidth( DEFAULT_LOADING_STATE_PROGRESS_BAR_WIDTH * progress.GetFraction( ) );
+		_progressBar->Draw( );
+	}
+}
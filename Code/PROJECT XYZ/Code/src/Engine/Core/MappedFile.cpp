@@ -0,0 +1,126 @@
+#include "pch.hpp"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Sonar
+{
+	MappedFile::MappedFile( ) : _data( nullptr ), _size( 0 ), _isOpen( false ) { }
+
+	MappedFile::~MappedFile( )
+	{ Close( ); }
+
+	bool MappedFile::Open( const std::string &filepath )
+	{
+		Close( );
+
+#ifdef _WIN32
+		HANDLE file = CreateFileA( filepath.c_str( ), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+
+		if ( INVALID_HANDLE_VALUE == file )
+		{ return false; }
+
+		LARGE_INTEGER fileSize;
+
+		if ( !GetFileSizeEx( file, &fileSize ) )
+		{
+			CloseHandle( file );
+
+			return false;
+		}
+
+		// Empty files can't be mapped, they open with no data
+		if ( 0 == fileSize.QuadPart )
+		{
+			CloseHandle( file );
+			_isOpen = true;
+
+			return true;
+		}
+
+		HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+		CloseHandle( file );
+
+		if ( nullptr == mapping )
+		{ return false; }
+
+		// The view keeps the mapping alive once the handles are closed
+		_data = static_cast<const char *>( MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) );
+		CloseHandle( mapping );
+
+		if ( nullptr == _data )
+		{ return false; }
+
+		_size = static_cast<std::size_t>( fileSize.QuadPart );
+#else
+		const int file = open( filepath.c_str( ), O_RDONLY );
+
+		if ( -1 == file )
+		{ return false; }
+
+		struct stat fileStats;
+
+		if ( -1 == fstat( file, &fileStats ) || !S_ISREG( fileStats.st_mode ) )
+		{
+			close( file );
+
+			return false;
+		}
+
+		// Empty files can't be mapped, they open with no data
+		if ( 0 == fileStats.st_size )
+		{
+			close( file );
+			_isOpen = true;
+
+			return true;
+		}
+
+		void *mapping = mmap( nullptr, fileStats.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+
+		// The mapping stays valid once the file is closed
+		close( file );
+
+		if ( MAP_FAILED == mapping )
+		{ return false; }
+
+		_data = static_cast<const char *>( mapping );
+		_size = static_cast<std::size_t>( fileStats.st_size );
+#endif
+
+		_isOpen = true;
+
+		return true;
+	}
+
+	void MappedFile::Close( )
+	{
+		if ( nullptr != _data )
+		{
+#ifdef _WIN32
+			UnmapViewOfFile( _data );
+#else
+			munmap( const_cast<char *>( _data ), _size );
+#endif
+		}
+
+		_data = nullptr;
+		_size = 0;
+		_isOpen = false;
+	}
+
+	bool MappedFile::IsOpen( ) const
+	{ return _isOpen; }
+
+	const char *MappedFile::GetData( ) const
+	{ return _data; }
+
+	std::size_t MappedFile::GetSize( ) const
+	{ return _size; }
+}
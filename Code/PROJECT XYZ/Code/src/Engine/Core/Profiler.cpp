@@ -0,0 +1,207 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+	namespace
+	{
+		/**
+		 * \brief Buffer of the calling thread (set on its first recorded scope)
+		 */
+		thread_local void *threadBuffer = nullptr;
+	}
+
+	Profiler *Profiler::getInstance( )
+	{
+		static Profiler instance;
+
+		return &instance;
+	}
+
+	Profiler::Profiler( )
+	{
+		_isCapturing = false;
+		_framesLeft = 0;
+	}
+
+	void Profiler::BeginCapture( )
+	{
+		{
+			std::lock_guard<std::mutex> lock( _threadBuffersMutex );
+
+			for ( auto &buffer : _threadBuffers )
+			{
+				std::lock_guard<std::mutex> bufferLock( buffer->mutex );
+				buffer->events.clear( );
+			}
+		}
+
+		_framesLeft = 0;
+		_traceFilepath.clear( );
+		_isCapturing = true;
+	}
+
+	void Profiler::CaptureFrames( const unsigned int &frameCount, const std::string &filepath )
+	{
+		BeginCapture( );
+
+		_framesLeft = frameCount;
+		_traceFilepath = filepath;
+	}
+
+	unsigned int Profiler::GetFramesLeft( ) const
+	{ return _framesLeft; }
+
+	void Profiler::EndCapture( )
+	{
+		_isCapturing = false;
+		_framesLeft = 0;
+	}
+
+	bool Profiler::IsCapturing( ) const
+	{ return _isCapturing.load( std::memory_order_relaxed ); }
+
+	void Profiler::EndFrame( )
+	{
+		if ( _isCapturing && 0 < _framesLeft )
+		{
+			_framesLeft--;
+
+			if ( 0 == _framesLeft )
+			{
+				EndCapture( );
+
+				if ( !_traceFilepath.empty( ) )
+				{
+					if ( WriteChromeTrace( _traceFilepath ) )
+					{ Debug::LogStatic( "Profiler trace written to " + _traceFilepath ); }
+					else
+					{ Debug::LogStatic( "Failed to write the profiler trace to " + _traceFilepath ); }
+
+					_traceFilepath.clear( );
+				}
+			}
+		}
+	}
+
+	void Profiler::SetThreadName( const std::string &name )
+	{
+		ThreadBuffer &buffer = GetThreadBuffer( );
+
+		std::lock_guard<std::mutex> lock( buffer.mutex );
+		buffer.name = name;
+	}
+
+	void Profiler::AddEvent( const char *name, const long long &start, const long long &end )
+	{
+		ThreadBuffer &buffer = GetThreadBuffer( );
+
+		std::lock_guard<std::mutex> lock( buffer.mutex );
+		buffer.events.push_back( Event{ name, start, end - start } );
+	}
+
+	long long Profiler::GetTime( ) const
+	{ return _clock.GetElapsedTime( ).AsMicroseconds( ); }
+
+	unsigned int Profiler::GetEventCount( )
+	{
+		std::lock_guard<std::mutex> lock( _threadBuffersMutex );
+
+		unsigned int count = 0;
+
+		for ( auto &buffer : _threadBuffers )
+		{
+			std::lock_guard<std::mutex> bufferLock( buffer->mutex );
+			count += buffer->events.size( );
+		}
+
+		return count;
+	}
+
+	bool Profiler::WriteChromeTrace( const std::string &filepath )
+	{
+		std::ofstream file( filepath, std::ios::out | std::ios::trunc );
+
+		if ( !file.is_open( ) )
+		{ return false; }
+
+		// Names are code literals, but escape them anyway so the JSON is always valid
+		auto escape = []( const std::string &string )
+		{
+			std::string escaped;
+
+			for ( const auto &character : string )
+			{
+				if ( '"' == character || '\\' == character )
+				{ escaped += '\\'; }
+
+				escaped += character;
+			}
+
+			return escaped;
+		};
+
+		std::lock_guard<std::mutex> lock( _threadBuffersMutex );
+
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+		bool isFirst = true;
+
+		for ( auto &buffer : _threadBuffers )
+		{
+			std::lock_guard<std::mutex> bufferLock( buffer->mutex );
+
+			if ( !buffer->name.empty( ) )
+			{
+				file << ( isFirst ? "" : "," ) << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->id << ",\"args\":{\"name\":\"" << escape( buffer->name ) << "\"}}";
+				isFirst = false;
+			}
+
+			// Complete events nest by time on each thread, which gives the viewer the scope hierarchy
+			for ( const auto &event : buffer->events )
+			{
+				file << ( isFirst ? "" : "," ) << "\n{\"name\":\"" << escape( event.name ) << "\",\"cat\":\"sonar\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->id << ",\"ts\":" << event.start << ",\"dur\":" << event.duration << "}";
+				isFirst = false;
+			}
+		}
+
+		file << "\n]}\n";
+
+		return file.good( );
+	}
+
+	Profiler::ThreadBuffer &Profiler::GetThreadBuffer( )
+	{
+		if ( nullptr == threadBuffer )
+		{
+			std::lock_guard<std::mutex> lock( _threadBuffersMutex );
+
+			_threadBuffers.push_back( std::unique_ptr<ThreadBuffer>( new ThreadBuffer( ) ) );
+			_threadBuffers.back( )->id = _threadBuffers.size( ) - 1;
+			_threadBuffers.back( )->events.reserve( DEFAULT_PROFILER_EVENT_RESERVE );
+
+			threadBuffer = _threadBuffers.back( ).get( );
+		}
+
+		return *static_cast<ThreadBuffer *>( threadBuffer );
+	}
+
+	ProfileScope::ProfileScope( const char *name ) : _name( name )
+	{
+		Profiler *profiler = Profiler::getInstance( );
+
+		if ( profiler->IsCapturing( ) )
+		{ _start = profiler->GetTime( ); }
+		else
+		{ _start = -1; }
+	}
+
+	ProfileScope::~ProfileScope( )
+	{
+		// Scopes that started before a capture ended are still recorded so the trace has no half open frames
+		if ( -1 != _start )
+		{
+			Profiler *profiler = Profiler::getInstance( );
+			profiler->AddEvent( _name, _start, profiler->GetTime( ) );
+		}
+	}
+}
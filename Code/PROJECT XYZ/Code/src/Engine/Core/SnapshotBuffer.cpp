@@ -0,0 +1,87 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+	SnapshotBuffer::SnapshotBuffer( )
+	{ _latestTime = 0; }
+
+	SnapshotBuffer::~SnapshotBuffer( ) { }
+
+	void SnapshotBuffer::SetTransform( const unsigned int &id, const Transform &transform )
+	{
+		// Only grows when a new highest ID is used, the buffers keep their capacity afterwards
+		if ( id >= _write.size( ) )
+		{ _write.resize( id + 1, Entry{ Transform( ), false } ); }
+
+		_write.at( id ).transform = transform;
+		_write.at( id ).isSet = true;
+	}
+
+	void SnapshotBuffer::SetTransform( const unsigned int &id, const glm::vec2 &position, const float &rotation, const glm::vec2 &scale )
+	{ SetTransform( id, Transform{ position, scale, rotation } ); }
+
+	void SnapshotBuffer::RemoveTransform( const unsigned int &id )
+	{
+		if ( id < _write.size( ) )
+		{ _write.at( id ).isSet = false; }
+	}
+
+	void SnapshotBuffer::Publish( )
+	{
+		{
+			std::lock_guard<std::mutex> lock( _mutex );
+
+			_previous.swap( _latest );
+			_latest.swap( _write );
+		}
+
+		_latestTime = _clock.GetElapsedTime( ).AsMicroseconds( );
+
+		// Objects that aren't written next step keep their transform, only the publishing thread writes _latest so it's safe to read unlocked
+		_write = _latest;
+	}
+
+	void SnapshotBuffer::Acquire( )
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+
+		_drawLatest = _latest;
+		_drawPrevious = _previous;
+	}
+
+	bool SnapshotBuffer::HasTransform( const unsigned int &id ) const
+	{ return id < _drawLatest.size( ) && _drawLatest.at( id ).isSet; }
+
+	SnapshotBuffer::Transform SnapshotBuffer::GetTransform( const unsigned int &id, const float &interpolation ) const
+	{
+		if ( !HasTransform( id ) )
+		{ return Transform( ); }
+
+		const Transform &latest = _drawLatest.at( id ).transform;
+
+		// Objects that only appeared in the latest snapshot have nothing to blend from
+		if ( id >= _drawPrevious.size( ) || !_drawPrevious.at( id ).isSet )
+		{ return latest; }
+
+		const Transform &previous = _drawPrevious.at( id ).transform;
+		const float alpha = std::max( 0.0f, std::min( 1.0f, interpolation ) );
+
+		// Rotate the short way round so 350 to 10 degrees doesn't spin backwards
+		float rotationDifference = std::fmod( latest.rotation - previous.rotation, 360.0f );
+
+		if ( rotationDifference > 180.0f )
+		{ rotationDifference -= 360.0f; }
+		else if ( rotationDifference < -180.0f )
+		{ rotationDifference += 360.0f; }
+
+		Transform transform;
+		transform.position = previous.position + ( latest.position - previous.position ) * alpha;
+		transform.scale = previous.scale + ( latest.scale - previous.scale ) * alpha;
+		transform.rotation = previous.rotation + rotationDifference * alpha;
+
+		return transform;
+	}
+
+	float SnapshotBuffer::GetTimeSinceLatest( ) const
+	{ return Time::MicrosecondsToSeconds( _clock.GetElapsedTime( ).AsMicroseconds( ) - _latestTime ); }
+}
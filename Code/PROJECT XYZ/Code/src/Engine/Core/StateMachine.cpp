@@ -7,6 +7,9 @@ namespace Sonar
 		_isAdding = false;
 		_isRemoving = false;
 		_isReplacing = false;
+
+		_isLoadingStateActive = false;
+		_isLoadingReplacing = false;
 	}
 
 	StateMachine::~StateMachine( ) { }
@@ -19,6 +22,20 @@ namespace Sonar
 		_newState = std::move( newState );
 	}
 
+	void StateMachine::AddStateAsync( const std::function<StateRef( )> &factory, StateRef loadingState, const bool &isReplacing )
+	{
+		_isLoadingReplacing = isReplacing;
+		_loadingState = std::move( loadingState );
+
+		_loadingFuture = std::async( std::launch::async, [factory]( )
+		{
+			StateRef state = factory( );
+			state->Preload( );
+
+			return state;
+		} );
+	}
+
 	void StateMachine::RemoveState( )
 	{ _isRemoving = true; }
 
@@ -48,8 +65,48 @@ namespace Sonar
 			_states.top( )->Init( );
 			_isAdding = false;
 		}
+
+		// The current state is paused (not replaced) so it's still there if the preloaded state is only being added
+		if ( _loadingState )
+		{
+			if ( !_states.empty( ) && !_isLoadingStateActive )
+			{ _states.top( )->Pause( ); }
+			else if ( _isLoadingStateActive )
+			{ _states.pop( ); }
+
+			_states.push( std::move( _loadingState ) );
+			_states.top( )->Init( );
+			_isLoadingStateActive = true;
+		}
+
+		if ( IsLoading( ) && std::future_status::ready == _loadingFuture.wait_for( std::chrono::seconds( 0 ) ) )
+		{
+			StateRef newState = _loadingFuture.get( );
+
+			if ( _isLoadingStateActive )
+			{ _states.pop( ); }
+
+			if ( !_states.empty( ) )
+			{
+				if ( _isLoadingReplacing )
+				{ _states.pop( ); }
+				else if ( !_isLoadingStateActive )
+				{ _states.top( )->Pause( ); }
+			}
+
+			_isLoadingStateActive = false;
+
+			_states.push( std::move( newState ) );
+			_states.top( )->Init( );
+		}
 	}
 
 	StateRef &StateMachine::GetActiveState( )
 	{ return _states.top( ); }
+
+	bool StateMachine::IsEmpty( ) const
+	{ return _states.empty( ); }
+
+	bool StateMachine::IsLoading( ) const
+	{ return _loadingFuture.valid( ); }
 }
@@ -37,7 +37,7 @@ namespace Sonar
 	{
 		sf::ContextSettings sfmlContextSettings = _window.getSettings( );
 
-		_contextSettings = ContextSettings::ContextSettings( sfmlContextSettings.depthBits, sfmlContextSettings.stencilBits, sfmlContextSettings.antialiasingLevel, sfmlContextSettings.majorVersion, sfmlContextSettings.minorVersion, sfmlContextSettings.attributeFlags, sfmlContextSettings.sRgbCapable );
+		_contextSettings = ContextSettings( sfmlContextSettings.depthBits, sfmlContextSettings.stencilBits, sfmlContextSettings.antialiasingLevel, sfmlContextSettings.majorVersion, sfmlContextSettings.minorVersion, sfmlContextSettings.attributeFlags, sfmlContextSettings.sRgbCapable );
 
 		return _contextSettings;
 	}
@@ -13,6 +13,9 @@
 
 #include "pch.hpp"
 
+// XInput is Windows only, see Gamepad.h for the other platforms
+#ifdef _WIN32
+
 // Link the 'XInput' library
 // Note: For Visual Studio 2012 and above, XInput9_1_0 is the library
 //       required to make XInput work.
@@ -263,4 +266,6 @@ XINPUT_STATE Gamepad::GetState()
 	XInputGetState(pad_id, &new_state);
 
 	return new_state;
-}
\ No newline at end of file
+}
+
+#endif
@@ -0,0 +1,384 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+    CollisionWorld::CollisionWorld( const float &cellSize, JobSystem *jobs ) : _jobs( jobs )
+    {
+        _cellSize = std::max( cellSize, 1.0f );
+        _count = 0;
+        _addCount = 0;
+    }
+
+    CollisionWorld::~CollisionWorld( )
+    {
+        for ( Proxy &proxy : _proxies )
+        {
+            if ( nullptr != proxy.drawable )
+            { proxy.drawable->_collisionWorld = nullptr; }
+        }
+    }
+
+    bool CollisionWorld::Add( Drawable *drawable, const unsigned int &layer, const unsigned int &mask )
+    {
+        if ( nullptr != drawable->_collisionWorld )
+        { return false; }
+
+        unsigned int index;
+
+        if ( _freeProxies.empty( ) )
+        {
+            index = _proxies.size( );
+            _proxies.emplace_back( );
+        }
+        else
+        {
+            index = _freeProxies.back( );
+            _freeProxies.pop_back( );
+        }
+
+        Proxy &proxy = _proxies[index];
+        proxy.drawable = drawable;
+        GetBounds( drawable, proxy.box, proxy.bounds );
+        proxy.cells = GetCells( proxy.bounds );
+        proxy.layer = layer;
+        proxy.mask = mask;
+        proxy.order = _addCount++;
+        proxy.isMarked = false;
+
+        drawable->_collisionWorld = this;
+        drawable->_collisionProxy = index;
+
+        InsertIntoCells( index );
+        _count++;
+
+        return true;
+    }
+
+    bool CollisionWorld::Remove( Drawable *drawable )
+    {
+        if ( !Contains( drawable ) )
+        { return false; }
+
+        const unsigned int index = drawable->_collisionProxy;
+
+        RemoveFromCells( index );
+
+        // A marked proxy stays in the marked list, the update skips it once it's free
+        _proxies[index].drawable = nullptr;
+        _freeProxies.push_back( index );
+
+        drawable->_collisionWorld = nullptr;
+        _count--;
+
+        return true;
+    }
+
+    void CollisionWorld::SetFilter( Drawable *drawable, const unsigned int &layer, const unsigned int &mask )
+    {
+        if ( Contains( drawable ) )
+        {
+            _proxies[drawable->_collisionProxy].layer = layer;
+            _proxies[drawable->_collisionProxy].mask = mask;
+        }
+    }
+
+    bool CollisionWorld::Contains( const Drawable *drawable ) const
+    { return this == drawable->_collisionWorld; }
+
+    unsigned int CollisionWorld::Update( )
+    {
+        unsigned int movedCount = 0;
+
+        for ( const unsigned int &index : _markedProxies )
+        {
+            Proxy &proxy = _proxies[index];
+
+            if ( nullptr == proxy.drawable || !proxy.isMarked )
+            { continue; }
+
+            proxy.isMarked = false;
+            GetBounds( proxy.drawable, proxy.box, proxy.bounds );
+
+            const glm::ivec4 cells = GetCells( proxy.bounds );
+
+            // Most moves stay within the same cells, so nothing has to be rehashed
+            if ( cells != proxy.cells )
+            {
+                RemoveFromCells( index );
+                proxy.cells = cells;
+                InsertIntoCells( index );
+
+                movedCount++;
+            }
+        }
+
+        _markedProxies.clear( );
+
+        return movedCount;
+    }
+
+    void CollisionWorld::QueryOverlaps( const glm::vec4 &bounds, std::vector<Drawable *> &overlaps, const unsigned int &mask )
+    {
+        Update( );
+
+        FindOverlaps( glm::vec4( bounds.x, bounds.y, bounds.x + bounds.z, bounds.y + bounds.w ), overlaps, mask );
+    }
+
+    void CollisionWorld::QueryOverlaps( const std::vector<glm::vec4> &bounds, std::vector<std::vector<Drawable *>> &overlaps, const unsigned int &mask )
+    {
+        SONAR_PROFILE_SCOPE( "Collision queries" );
+
+        Update( );
+
+        overlaps.resize( bounds.size( ) );
+
+        const auto queryRange = [&]( const unsigned int &begin, const unsigned int &end )
+        {
+            for ( unsigned int i = begin; i < end; i++ )
+            { FindOverlaps( glm::vec4( bounds[i].x, bounds[i].y, bounds[i].x + bounds[i].z, bounds[i].y + bounds[i].w ), overlaps[i], mask ); }
+        };
+
+        if ( nullptr == _jobs )
+        { queryRange( 0, bounds.size( ) ); }
+        else
+        { _jobs->ParallelFor( bounds.size( ), queryRange, DEFAULT_COLLISION_WORLD_QUERY_GRAIN_SIZE ); }
+    }
+
+    void CollisionWorld::QueryCollisions( const Drawable *drawable, std::vector<Drawable *> &collisions, const COLLISION_TEST &test )
+    {
+        collisions.clear( );
+
+        if ( !Contains( drawable ) )
+        { return; }
+
+        Update( );
+
+        const Proxy &proxy = _proxies[drawable->_collisionProxy];
+
+        for ( int y = proxy.cells.y; y <= proxy.cells.w; y++ )
+        {
+            for ( int x = proxy.cells.x; x <= proxy.cells.z; x++ )
+            {
+                const auto cell = _cells.find( GetKey( x, y ) );
+
+                if ( _cells.end( ) == cell )
+                { continue; }
+
+                for ( const unsigned int &index : cell->second )
+                {
+                    const Proxy &other = _proxies[index];
+
+                    if ( &other == &proxy || !IsOverlapping( proxy.bounds, other.bounds ) )
+                    { continue; }
+
+                    // Drawables sharing several cells are only found in the cell where their overlap starts
+                    const glm::ivec4 start = GetCells( glm::vec4( std::max( proxy.bounds.x, other.bounds.x ), std::max( proxy.bounds.y, other.bounds.y ), 0.0f, 0.0f ) );
+
+                    if ( start.x == x && start.y == y && IsColliding( proxy, other, test ) )
+                    { collisions.push_back( other.drawable ); }
+                }
+            }
+        }
+    }
+
+    void CollisionWorld::GetPairs( std::vector<CollisionPair> &pairs, const COLLISION_TEST &test )
+    {
+        SONAR_PROFILE_SCOPE( "Collision pairs" );
+
+        Update( );
+
+        pairs.clear( );
+        _pairCells.clear( );
+
+        for ( const auto &cell : _cells )
+        {
+            if ( 1 < cell.second.size( ) )
+            { _pairCells.emplace_back( glm::ivec2( static_cast<int32_t>( cell.first >> 32 ), static_cast<int32_t>( cell.first & 0xFFFFFFFF ) ), &cell.second ); }
+        }
+
+        if ( _pairCells.empty( ) )
+        { return; }
+
+        const unsigned int threadCount = std::min<unsigned int>( ( nullptr == _jobs ) ? 1 : _jobs->GetThreadCount( ) + 1, _pairCells.size( ) );
+
+        if ( _threadPairs.size( ) < threadCount )
+        { _threadPairs.resize( threadCount ); }
+
+        // Each thread takes a contiguous slice of the cells and keeps its own pairs, so joining them keeps the same order every run
+        const auto findPairs = [&]( const unsigned int &thread )
+        {
+            std::vector<CollisionPair> &threadPairs = _threadPairs[thread];
+            threadPairs.clear( );
+
+            const std::size_t begin = _pairCells.size( ) * thread / threadCount;
+            const std::size_t end = _pairCells.size( ) * ( thread + 1 ) / threadCount;
+
+            for ( std::size_t i = begin; i < end; i++ )
+            {
+                const glm::ivec2 &position = _pairCells[i].first;
+                const std::vector<unsigned int> &cell = *_pairCells[i].second;
+
+                for ( std::size_t first = 0; first < cell.size( ); first++ )
+                {
+                    const Proxy &firstProxy = _proxies[cell[first]];
+
+                    for ( std::size_t second = first + 1; second < cell.size( ); second++ )
+                    {
+                        const Proxy &secondProxy = _proxies[cell[second]];
+
+                        if ( !IsOverlapping( firstProxy.bounds, secondProxy.bounds ) )
+                        { continue; }
+
+                        // Pairs sharing several cells are only reported by the cell where their overlap starts
+                        const glm::ivec4 start = GetCells( glm::vec4( std::max( firstProxy.bounds.x, secondProxy.bounds.x ), std::max( firstProxy.bounds.y, secondProxy.bounds.y ), 0.0f, 0.0f ) );
+
+                        if ( start.x != position.x || start.y != position.y || !IsColliding( firstProxy, secondProxy, test ) )
+                        { continue; }
+
+                        if ( firstProxy.order < secondProxy.order )
+                        { threadPairs.emplace_back( firstProxy.drawable, secondProxy.drawable ); }
+                        else
+                        { threadPairs.emplace_back( secondProxy.drawable, firstProxy.drawable ); }
+                    }
+                }
+            }
+        };
+
+        if ( 1 == threadCount )
+        { findPairs( 0 ); }
+        else
+        {
+            _jobs->ParallelFor( threadCount, [&]( const unsigned int &begin, const unsigned int &end )
+            {
+                for ( unsigned int i = begin; i < end; i++ )
+                { findPairs( i ); }
+            }, 1 );
+        }
+
+        for ( unsigned int i = 0; i < threadCount; i++ )
+        { pairs.insert( pairs.end( ), _threadPairs[i].begin( ), _threadPairs[i].end( ) ); }
+    }
+
+    unsigned int CollisionWorld::GetCount( ) const
+    { return _count; }
+
+    float CollisionWorld::GetCellSize( ) const
+    { return _cellSize; }
+
+    void CollisionWorld::MarkChanged( const unsigned int &proxy )
+    {
+        // Drawables can be moved from the job system's threads (Parallax::Update), so marking is locked
+        std::lock_guard<std::mutex> lock( _markMutex );
+
+        if ( _proxies[proxy].isMarked )
+        { return; }
+
+        _proxies[proxy].isMarked = true;
+        _markedProxies.push_back( proxy );
+    }
+
+    void CollisionWorld::GetBounds( const Drawable *drawable, glm::vec4 &box, glm::vec4 &bounds ) const
+    {
+        // BoundingBoxCollision tests the position and size, CircleCollision tests a circle as wide as the global bounds from the position
+        const glm::vec2 position = drawable->GetPosition( );
+        const glm::vec2 size = drawable->GetSize( );
+        const glm::vec4 globalBounds = drawable->GetGlobalBounds( );
+
+        const glm::vec2 centre = position + glm::vec2( globalBounds.z, globalBounds.w ) * 0.5f;
+        const float radius = std::abs( globalBounds.z ) * 0.5f;
+
+        box = glm::vec4( std::min( position.x, position.x + size.x ), std::min( position.y, position.y + size.y ), std::max( position.x, position.x + size.x ), std::max( position.y, position.y + size.y ) );
+        bounds = glm::vec4( std::min( box.x, centre.x - radius ), std::min( box.y, centre.y - radius ), std::max( box.z, centre.x + radius ), std::max( box.w, centre.y + radius ) );
+    }
+
+    glm::ivec4 CollisionWorld::GetCells( const glm::vec4 &bounds ) const
+    {
+        return glm::ivec4(
+            static_cast<int>( std::floor( bounds.x / _cellSize ) ),
+            static_cast<int>( std::floor( bounds.y / _cellSize ) ),
+            static_cast<int>( std::floor( bounds.z / _cellSize ) ),
+            static_cast<int>( std::floor( bounds.w / _cellSize ) ) );
+    }
+
+    void CollisionWorld::InsertIntoCells( const unsigned int &proxy )
+    {
+        const glm::ivec4 &cells = _proxies[proxy].cells;
+
+        for ( int y = cells.y; y <= cells.w; y++ )
+        {
+            for ( int x = cells.x; x <= cells.z; x++ )
+            { _cells[GetKey( x, y )].push_back( proxy ); }
+        }
+    }
+
+    void CollisionWorld::RemoveFromCells( const unsigned int &proxy )
+    {
+        const glm::ivec4 &cells = _proxies[proxy].cells;
+
+        for ( int y = cells.y; y <= cells.w; y++ )
+        {
+            for ( int x = cells.x; x <= cells.z; x++ )
+            {
+                std::vector<unsigned int> &cell = _cells[GetKey( x, y )];
+                const auto index = std::find( cell.begin( ), cell.end( ), proxy );
+
+                if ( cell.end( ) != index )
+                {
+                    *index = cell.back( );
+                    cell.pop_back( );
+                }
+            }
+        }
+    }
+
+    void CollisionWorld::FindOverlaps( const glm::vec4 &bounds, std::vector<Drawable *> &overlaps, const unsigned int &mask ) const
+    {
+        overlaps.clear( );
+
+        const glm::ivec4 cells = GetCells( bounds );
+
+        for ( int y = cells.y; y <= cells.w; y++ )
+        {
+            for ( int x = cells.x; x <= cells.z; x++ )
+            {
+                const auto cell = _cells.find( GetKey( x, y ) );
+
+                if ( _cells.end( ) == cell )
+                { continue; }
+
+                for ( const unsigned int &index : cell->second )
+                {
+                    const Proxy &proxy = _proxies[index];
+
+                    if ( 0 == ( proxy.layer & mask ) || !IsOverlapping( bounds, proxy.box ) )
+                    { continue; }
+
+                    // Drawables covering several of the queried cells are only found in the cell where their overlap starts
+                    const glm::ivec4 start = GetCells( glm::vec4( std::max( bounds.x, proxy.bounds.x ), std::max( bounds.y, proxy.bounds.y ), 0.0f, 0.0f ) );
+
+                    if ( start.x == x && start.y == y )
+                    { overlaps.push_back( proxy.drawable ); }
+                }
+            }
+        }
+    }
+
+    bool CollisionWorld::IsColliding( const Proxy &first, const Proxy &second, const COLLISION_TEST &test ) const
+    {
+        if ( 0 == ( first.layer & second.mask ) || 0 == ( second.layer & first.mask ) || !IsOverlapping( first.bounds, second.bounds ) )
+        { return false; }
+
+        switch ( test )
+        {
+            case COLLISION_TEST::BOUNDING_BOX:
+                return first.drawable->BoundingBoxCollision( *second.drawable );
+
+            case COLLISION_TEST::CIRCLE:
+                return first.drawable->CircleCollision( *second.drawable );
+
+            case COLLISION_TEST::BOUNDS:
+            default:
+                return true;
+        }
+    }
+}
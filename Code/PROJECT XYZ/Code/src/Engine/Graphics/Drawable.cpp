@@ -17,42 +17,147 @@ namespace Sonar
         _timeBetweenPulses = Seconds( 0 );
         _pulseAmount = 0;
         _pulseCounter = 0;
+
+		_collisionWorld = nullptr;
+		_collisionProxy = 0;
     }
 
-    Drawable::~Drawable( ) { }
+    Drawable::Drawable( const Drawable &drawable ) : _object( drawable._object ), _globalBounds( drawable._globalBounds ), _data( drawable._data ), _position( drawable._position ), _size( drawable._size ), _color( drawable._color ), _borderColor( drawable._borderColor ), _borderThickness( drawable._borderThickness ), _rotation( drawable._rotation ), _scale( drawable._scale ), _pivot( drawable._pivot ), _initialPulseScale( drawable._initialPulseScale ), _endPulseScale( drawable._endPulseScale ), _pulseAmount( drawable._pulseAmount ), _pulseCounter( drawable._pulseCounter ), _timeBetweenPulses( drawable._timeBetweenPulses ), _clock( drawable._clock )
+	{
+		// The original's proxy belongs to the original, the copy has to be added itself
+		_collisionWorld = nullptr;
+		_collisionProxy = 0;
+	}
+
+    Drawable::~Drawable( )
+	{
+		if ( nullptr != _collisionWorld )
+		{ _collisionWorld->Remove( this ); }
+	}
+
+	Drawable &Drawable::operator=( const Drawable &drawable )
+	{
+		if ( this == &drawable )
+		{ return *this; }
+
+		_object = drawable._object;
+		_globalBounds = drawable._globalBounds;
+		_data = drawable._data;
+		_position = drawable._position;
+		_size = drawable._size;
+		_color = drawable._color;
+		_borderColor = drawable._borderColor;
+		_borderThickness = drawable._borderThickness;
+		_rotation = drawable._rotation;
+		_scale = drawable._scale;
+		_pivot = drawable._pivot;
+		_initialPulseScale = drawable._initialPulseScale;
+		_endPulseScale = drawable._endPulseScale;
+		_pulseAmount = drawable._pulseAmount;
+		_pulseCounter = drawable._pulseCounter;
+		_timeBetweenPulses = drawable._timeBetweenPulses;
+		_clock = drawable._clock;
+
+		// The collision world and proxy are left alone, the new bounds are picked up on the world's next update
+		MarkBoundsChanged( );
+
+		return *this;
+	}
 
     void Drawable::Draw( )
     {
-		// Check if the object is within the visible window
-		// If not cull it
-		if ( _position.x + ( _size.x * _scale[0] ) < 0 // Check if it's beyond the left boundary
-			|| _position.x > _data->window.GetSize( ).x // Check if it's beyond the right boundary
-			|| _position.y + ( _size.y * _scale[1] ) < 0 // Check if it's beyond the top boundary
-			|| _position.y > _data->window.GetSize( ).y // Check if it's beyond the bottom boundary
-			)
+		// If the object isn't within the visible window cull it
+		if ( !IsInsideWindow( ) )
+		{ return; }
+
+		// Sprites queued before this object have to be drawn first to keep the draw order
+		if ( _data->spriteBatch.IsEnabled( ) && SpriteBatch::SORT_MODE::DEFERRED == _data->spriteBatch.GetSortMode( ) )
+		{ _data->spriteBatch.Flush( _data->window.GetSFMLWindowObject( ) ); }
+
+		_data->window.GetSFMLWindowObject( ).draw( *_object );
+
+		// Shapes are drawn as a triangle fan (centre, points and the closing point), other drawables only count the call
+		const sf::Shape *shape = dynamic_cast<const sf::Shape *>( _object );
+		_data->frameStats.AddDrawCall( nullptr != shape ? shape->getPointCount( ) + 2 : 0 );
+	}
+
+	void Drawable::Draw( const SnapshotBuffer::Transform &transform )
+	{
+		const sf::Transformable *transformable = dynamic_cast<const sf::Transformable *>( _object );
+
+		if ( nullptr == transformable )
 		{
-			//std::cout << _position.x << ":" << _position.y << "   -   " << _size.x << ":" << _size.y << "CULLING" << std::endl;
+			Draw( );
 			return;
 		}
-		sf::Window w;
 
-		_data->window.GetSFMLWindowObject( ).draw( *_object );
+		const glm::uvec2 windowSize = _data->window.GetSize( );
+
+		// Cull at the snapshot position, the same as IsInsideWindow
+		if ( transform.position.x + ( _size.x * transform.scale.x ) < 0 || transform.position.x > windowSize.x
+			|| transform.position.y + ( _size.y * transform.scale.y ) < 0 || transform.position.y > windowSize.y )
+		{ return; }
+
+		if ( _data->spriteBatch.IsEnabled( ) && SpriteBatch::SORT_MODE::DEFERRED == _data->spriteBatch.GetSortMode( ) )
+		{ _data->spriteBatch.Flush( _data->window.GetSFMLWindowObject( ) ); }
+
+		// Undo the object's own transform and apply the snapshot's, keeping its origin
+		sf::Transformable snapshot( *transformable );
+		snapshot.setPosition( transform.position.x, transform.position.y );
+		snapshot.setRotation( transform.rotation );
+		snapshot.setScale( transform.scale.x, transform.scale.y );
+
+		sf::RenderStates states;
+		states.transform = snapshot.getTransform( ) * transformable->getInverseTransform( );
+
+		_data->window.GetSFMLWindowObject( ).draw( *_object, states );
+
+		const sf::Shape *shape = dynamic_cast<const sf::Shape *>( _object );
+		_data->frameStats.AddDrawCall( nullptr != shape ? shape->getPointCount( ) + 2 : 0 );
+	}
+
+	bool Drawable::IsInsideWindow( ) const
+	{
+		const glm::uvec2 windowSize = _data->window.GetSize( );
+
+		if ( _position.x + ( _size.x * _scale[0] ) < 0 // Check if it's beyond the left boundary
+			|| _position.x > windowSize.x // Check if it's beyond the right boundary
+			|| _position.y + ( _size.y * _scale[1] ) < 0 // Check if it's beyond the top boundary
+			|| _position.y > windowSize.y // Check if it's beyond the bottom boundary
+			)
+		{ return false; }
+		else
+		{ return true; }
 	}
 
 	void Drawable::SetPosition( const glm::vec2 &position )
-	{ _position = position; }
+	{
+		_position = position;
+
+		MarkBoundsChanged( );
+	}
 
     void Drawable::SetPosition( const float &x, const float &y )
     {
         _position.x = x;
         _position.y = y;
+
+        MarkBoundsChanged( );
     }
 
 	void Drawable::SetPositionX( const float &x )
-    { _position.x = x; }
+    {
+        _position.x = x;
+
+        MarkBoundsChanged( );
+    }
 
     void Drawable::SetPositionY( const float &y )
-    { _position.y = y; }
+    {
+        _position.y = y;
+
+        MarkBoundsChanged( );
+    }
 
     float Drawable::GetPositionX( const OBJECT_POINTS &point ) const
     { return GetPosition( point ).x; }
@@ -88,19 +193,33 @@ namespace Sonar
 	}
 
 	void Drawable::SetSize( const glm::vec2 &size )
-	{ _size = size; }
+	{
+		_size = size;
+
+		MarkBoundsChanged( );
+	}
 
     void Drawable::SetSize( const float &width, const float &height )
     {
         _size.x = width;
         _size.y = height;
+
+        MarkBoundsChanged( );
     }
 
 	void Drawable::SetWidth( const float &width )
-    { _size.x = width; }
+    {
+        _size.x = width;
+
+        MarkBoundsChanged( );
+    }
 
     void Drawable::SetHeight( const float &height )
-    { _size.y = height; }
+    {
+        _size.y = height;
+
+        MarkBoundsChanged( );
+    }
     
     float Drawable::GetWidth( ) const
     { return _size.x; }
@@ -130,25 +249,47 @@ namespace Sonar
     { return _borderThickness; }
 
 	void Drawable::Move( const glm::vec2 &offset )
-	{ _position += offset; }
+	{
+		_position += offset;
+
+		MarkBoundsChanged( );
+	}
 
 	void Drawable::Move( const float &x, const float &y )
     {
         _position.x += x;
         _position.y += y;
+
+        MarkBoundsChanged( );
     }
 
 	void Drawable::MoveX( const float &x )
-    { _position.x += x; }
+    {
+        _position.x += x;
+
+        MarkBoundsChanged( );
+    }
 
     void Drawable::MoveY( const float &y )
-    { _position.y += y; }
+    {
+        _position.y += y;
+
+        MarkBoundsChanged( );
+    }
 
 	void Drawable::SetRotation( const float &angle )
-	{ _rotation = angle; }
+	{
+		_rotation = angle;
+
+		MarkBoundsChanged( );
+	}
 
 	void Drawable::Rotate( const float &angle )
-	{ _rotation += angle; }
+	{
+		_rotation += angle;
+
+		MarkBoundsChanged( );
+	}
 
 	float Drawable::GetRotation( ) const
     { return _rotation; }
@@ -157,31 +298,59 @@ namespace Sonar
 	{
         _scale.x = xScale;
         _scale.y = yScale;
+
+        MarkBoundsChanged( );
 	}
 
 	void Drawable::SetScale( const glm::vec2 &scale )
-	{ _scale = scale; }
+	{
+		_scale = scale;
+
+		MarkBoundsChanged( );
+	}
 
 	void Drawable::SetScaleX( const float &xScale )
-	{ _scale.x = xScale; }
+	{
+		_scale.x = xScale;
+
+		MarkBoundsChanged( );
+	}
 
 	void Drawable::SetScaleY( const float &yScale )
-	{ _scale.y = yScale; }
+	{
+		_scale.y = yScale;
+
+		MarkBoundsChanged( );
+	}
 
 	void Drawable::Scale( const glm::vec2 &scale )
-	{ _scale *= scale; }
+	{
+		_scale *= scale;
+
+		MarkBoundsChanged( );
+	}
 
 	void Drawable::Scale( const float &xScale, const float &yScale )
 	{
 		_scale.x *= xScale;
 		_scale.y *= yScale;
+
+		MarkBoundsChanged( );
 	}
 
 	void Drawable::ScaleX( const float &xScale )
-	{ _scale.x *= xScale; }
+	{
+		_scale.x *= xScale;
+
+		MarkBoundsChanged( );
+	}
 
 	void Drawable::ScaleY( const float &yScale )
-	{ _scale.y *= yScale; }
+	{
+		_scale.y *= yScale;
+
+		MarkBoundsChanged( );
+	}
 
 	glm::vec2 Drawable::GetScale( ) const
 	{ return _scale; }
@@ -373,5 +542,11 @@ namespace Sonar
 	sf::Drawable *Drawable::GetSFMLDrawable( ) const
 	{ return _object; }
 
+	void Drawable::MarkBoundsChanged( )
+	{
+		if ( nullptr != _collisionWorld )
+		{ _collisionWorld->MarkChanged( _collisionProxy ); }
+	}
+
 }
 
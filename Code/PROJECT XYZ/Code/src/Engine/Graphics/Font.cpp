@@ -1,8 +1,24 @@
 #include "pch.hpp"
 
+namespace
+{
+	/**
+	 * \brief Font used until a file is set, shared so unset fonts don't allocate
+	 *
+	 * \return Output returns the empty font
+	 */
+	const std::shared_ptr<sf::Font> &GetEmptyFont( )
+	{
+		static const std::shared_ptr<sf::Font> font = std::make_shared<sf::Font>( );
+
+		return font;
+	}
+}
+
 namespace Sonar
 {
-	Font::Font( ) { }
+	Font::Font( )
+	{ _font = GetEmptyFont( ); }
 
 	Font::Font( const std::string &filepath )
 	{ SetFontFile( filepath ); }
@@ -13,22 +29,22 @@ namespace Sonar
 	{
 		_filePath = filepath;
 
-		_font.loadFromFile( _filePath );
+		_font = ResourceCache::getInstance( )->GetFont( _filePath );
 	}
 
 	std::string Font::GetFontFilePath( ) const
 	{ return _filePath; }
 
 	float Font::GetLineSpacing( const unsigned int &characterSize ) const
-	{ return _font.getLineSpacing( characterSize ); }
+	{ return _font->getLineSpacing( characterSize ); }
 
 	float Font::GetUnderlinePosition( const unsigned int &characterSize ) const
-	{ return _font.getUnderlinePosition( characterSize ); }
+	{ return _font->getUnderlinePosition( characterSize ); }
 
 	float Font::GetUnderlineThickness( const unsigned int &characterSize ) const
-	{ return _font.getUnderlineThickness( characterSize ); }
+	{ return _font->getUnderlineThickness( characterSize ); }
 
 	const sf::Font &Font::GetSFMLFont( ) const
-	{ return _font; }
+	{ return *_font; }
 }
 
@@ -34,18 +34,7 @@ namespace Sonar
 	}
 
 	void Menu::RemoveComponent( MenuComponent *component )
-	{
-		std::vector<MenuComponent *> newMenuComponentsVector( _menuComponents.size( ) );
-
-		std::remove_copy( _menuComponents.begin( ), _menuComponents.end( ), newMenuComponentsVector.begin( ), component );
-
-		if ( newMenuComponentsVector.at( newMenuComponentsVector.size( ) - 1 ) == NULL )
-		{
-			newMenuComponentsVector.pop_back( );
-
-			_menuComponents = newMenuComponentsVector;
-		}
-	}
+	{ _menuComponents.erase( std::remove( _menuComponents.begin( ), _menuComponents.end( ), component ), _menuComponents.end( ) ); }
 
 	void Menu::RemoveComponent( const unsigned int &index )
 	{
@@ -9,11 +9,15 @@ namespace Sonar
 
 	void Parallax::Update( const float &dt )
 	{
-		for ( unsigned int i = 0; i < _layers.size( ); i++ )
+		// Layers only move their own backgrounds, so large parallaxes are spread across the job system
+		_data->jobs.ParallelFor( _layers.size( ), [this, &dt]( const unsigned int &begin, const unsigned int &end )
 		{
-			if ( _layerStatus.at( i ).first )
-			{ _layers.at( i ).Update( dt ); }
-		}
+			for ( unsigned int i = begin; i < end; i++ )
+			{
+				if ( _layerStatus.at( i ).first )
+				{ _layers.at( i ).Update( dt ); }
+			}
+		}, DEFAULT_PARALLAX_UPDATE_GRAIN_SIZE );
 	}
 
 	void Parallax::Draw( )
@@ -0,0 +1,159 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+	ResourceCache *ResourceCache::getInstance( )
+	{
+		static ResourceCache instance;
+
+		return &instance;
+	}
+
+	ResourceCache::ResourceCache( ) { }
+
+	ResourceCache::~ResourceCache( ) { }
+
+	bool ResourceCache::MountPack( const std::string &filepath )
+	{
+		std::unique_ptr<AssetPack> pack = std::make_unique<AssetPack>( );
+
+		if ( !pack->Open( filepath ) )
+		{ return false; }
+
+		std::lock_guard<std::mutex> lock( _packMutex );
+		_packs.push_back( std::move( pack ) );
+
+		return true;
+	}
+
+	AssetPack *ResourceCache::FindPack( const std::string &filepath )
+	{
+		std::lock_guard<std::mutex> lock( _packMutex );
+
+		for ( auto pack = _packs.rbegin( ); pack != _packs.rend( ); ++pack )
+		{
+			if ( ( *pack )->Contains( filepath ) )
+			{ return pack->get( ); }
+		}
+
+		return nullptr;
+	}
+
+	std::shared_ptr<sf::Texture> ResourceCache::GetTexture( const std::string &filepath )
+	{ return Acquire( _textures, _loadingTextures, filepath ); }
+
+	std::shared_ptr<sf::Font> ResourceCache::GetFont( const std::string &filepath )
+	{ return Acquire( _fonts, _loadingFonts, filepath ); }
+
+	unsigned int ResourceCache::GetTextureCount( )
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+
+		return std::count_if( _textures.begin( ), _textures.end( ), []( const auto &texture ) { return !texture.second.expired( ); } );
+	}
+
+	unsigned int ResourceCache::GetFontCount( )
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+
+		return std::count_if( _fonts.begin( ), _fonts.end( ), []( const auto &font ) { return !font.second.expired( ); } );
+	}
+
+	std::string ResourceCache::GetKey( const std::string &filepath )
+	{
+		std::error_code error;
+		const std::filesystem::path canonicalPath = std::filesystem::weakly_canonical( filepath, error );
+
+		return error ? filepath : canonicalPath.string( );
+	}
+
+	template<typename T>
+	std::shared_ptr<T> ResourceCache::Acquire( std::unordered_map<std::string, std::weak_ptr<T>> &resources, std::unordered_map<std::string, std::shared_future<std::shared_ptr<T>>> &loading, const std::string &filepath )
+	{
+		const std::string key = GetKey( filepath );
+
+		std::unique_lock<std::mutex> lock( _mutex );
+
+		if ( std::shared_ptr<T> resource = resources[key].lock( ) )
+		{ return resource; }
+
+		const auto inFlight = loading.find( key );
+
+		// Another thread is already loading the file, its result is shared instead of loading it again
+		if ( loading.end( ) != inFlight )
+		{
+			const std::shared_future<std::shared_ptr<T>> loaded = inFlight->second;
+			lock.unlock( );
+
+			return loaded.get( );
+		}
+
+		std::promise<std::shared_ptr<T>> promise;
+		loading.emplace( key, promise.get_future( ).share( ) );
+
+		// Decoding is the slow part, other files are looked up and loaded while it runs
+		lock.unlock( );
+
+		std::shared_ptr<T> resource = std::make_shared<T>( );
+		const bool isLoaded = Load( resource, filepath );
+
+		lock.lock( );
+
+		loading.erase( key );
+
+		// Failed loads aren't cached so the file is tried again next time
+		if ( isLoaded )
+		{ resources[key] = resource; }
+		else
+		{ resources.erase( key ); }
+
+		// Drop the entries of resources that have been freed while the lock is held anyway
+		for ( auto it = resources.begin( ); it != resources.end( ); )
+		{
+			if ( it->second.expired( ) )
+			{ it = resources.erase( it ); }
+			else
+			{ ++it; }
+		}
+
+		lock.unlock( );
+
+		promise.set_value( resource );
+
+		return resource;
+	}
+
+	bool ResourceCache::Load( std::shared_ptr<sf::Texture> &texture, const std::string &filepath )
+	{
+		// Textures copy the pixels they decode, so a decompressed entry is freed once the view goes
+		if ( AssetPack *pack = FindPack( filepath ) )
+		{
+			const AssetPack::View packed = pack->Read( filepath );
+
+			return texture->loadFromMemory( packed.data, packed.size );
+		}
+
+		return texture->loadFromFile( filepath );
+	}
+
+	bool ResourceCache::Load( std::shared_ptr<sf::Font> &font, const std::string &filepath )
+	{
+		AssetPack *pack = FindPack( filepath );
+
+		if ( nullptr == pack )
+		{ return font->loadFromFile( filepath ); }
+
+		// Fonts read glyphs from their memory as they're rendered, so the font shares ownership with the view of its bytes
+		struct PackedFont
+		{
+			AssetPack::View packed;
+			sf::Font font;
+		};
+
+		std::shared_ptr<PackedFont> packedFont = std::make_shared<PackedFont>( );
+		packedFont->packed = pack->Read( filepath );
+		font = std::shared_ptr<sf::Font>( packedFont, &packedFont->font );
+
+		return font->loadFromMemory( packedFont->packed.data, packedFont->packed.size );
+	}
+}
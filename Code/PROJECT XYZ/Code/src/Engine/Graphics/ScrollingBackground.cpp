@@ -31,6 +31,14 @@ namespace Sonar
 		SetBackgroundPositions( );
 	}
 
+	void ScrollingBackground::SetBackgrounds( const TextureAtlas &atlas, const std::vector<std::string> &backgrounds )
+	{
+		for ( auto filepath : backgrounds )
+		{ _backgrounds.push_back( new Sprite( _data, atlas, filepath ) ); }
+
+		SetBackgroundPositions( );
+	}
+
 	void ScrollingBackground::Update( const float &dt )
 	{
 		for ( unsigned int i = 0; i < _backgrounds.size( ); i++ )
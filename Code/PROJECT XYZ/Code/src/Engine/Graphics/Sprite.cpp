@@ -28,9 +28,32 @@ namespace Sonar
 		_globalBounds = _sprite.getGlobalBounds( );
 	}
 
+	Sprite::Sprite( GameDataRef data, const TextureAtlas &atlas, const std::string &filepath ) : Drawable( data )
+	{
+		_object = &_sprite;
+		_texture = new Texture( );
+
+		SetTexture( atlas, filepath );
+		_globalBounds = _sprite.getGlobalBounds( );
+	}
+
 	Sprite::~Sprite( )
 	{ delete _texture; }
 
+	void Sprite::Draw( )
+	{
+		if ( !IsInsideWindow( ) )
+		{ return; }
+
+		if ( _data->spriteBatch.IsEnabled( ) )
+		{ _data->spriteBatch.Add( _sprite, _blendMode ); }
+		else
+		{
+			_data->window.GetSFMLWindowObject( ).draw( _sprite, _blendMode );
+			_data->frameStats.AddDrawCall( 4 );
+		}
+	}
+
 	void Sprite::SetPosition( const glm::vec2 &position )
 	{
 		Drawable::SetPosition( position );
@@ -182,13 +205,26 @@ namespace Sonar
 
 	void Sprite::SetTexture( Texture *texture, const bool &resetRect )
 	{
-		_texture = texture;
+		// Share the texture rather than take the pointer, the sprite deletes its own texture object and the caller keeps theirs
+		_texture->SetTexture( *texture );
 		_sprite.setTexture( *_texture->GetTexture( ), resetRect );
 
 		SetPosition( _sprite.getPosition( ).x, _sprite.getPosition( ).y );
 		SetSize( _sprite.getLocalBounds( ).width, _sprite.getLocalBounds( ).height );
 	}
 
+	void Sprite::SetTexture( const TextureAtlas &atlas, const std::string &filepath )
+	{
+		const TextureAtlas::Region &region = atlas.GetRegion( filepath );
+
+		// The page is owned by the atlas, sprites from the same page share one texture so the sprite batch can merge them
+		_sprite.setTexture( *atlas.GetPage( region.page )->GetTexture( ) );
+		SetTextureRect( region.rectangle );
+
+		SetPosition( _sprite.getPosition( ).x, _sprite.getPosition( ).y );
+		SetSize( _sprite.getLocalBounds( ).width, _sprite.getLocalBounds( ).height );
+	}
+
 	void Sprite::SetTextureRect( const glm::ivec4 &rectangle )
 	{ _sprite.setTextureRect( sf::IntRect( rectangle.x, rectangle.y, rectangle.z, rectangle.w ) ); }
 
@@ -210,6 +246,12 @@ namespace Sonar
 	bool Sprite::PixelPerfectCollisionCheck( const Sprite &object, const unsigned char &alphaLimit /*= 0 */ )
 	{ return Collision::PixelPerfectTest( _sprite, object.GetSFMLSprite( ), alphaLimit ); }
 
+	void Sprite::SetBlendMode( const sf::BlendMode &blendMode )
+	{ _blendMode = blendMode; }
+
+	const sf::BlendMode &Sprite::GetBlendMode( ) const
+	{ return _blendMode; }
+
 	const sf::Sprite &Sprite::GetSFMLSprite( ) const
 	{ return _sprite; }
 }
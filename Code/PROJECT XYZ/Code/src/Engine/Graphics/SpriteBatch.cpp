@@ -0,0 +1,144 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+	SpriteBatch::SpriteBatch( )
+	{
+		_activeBatches = 0;
+
+		_isEnabled = DEFAULT_SPRITE_BATCH_ENABLED;
+		_sortMode = DEFAULT_SPRITE_BATCH_SORT_MODE;
+
+		_spriteCount = _drawCallCount = _vertexCount = 0;
+		_lastSpriteCount = _lastDrawCallCount = _lastVertexCount = 0;
+	}
+
+	SpriteBatch::~SpriteBatch( ) { }
+
+	void SpriteBatch::Enable( )
+	{ _isEnabled = true; }
+
+	void SpriteBatch::Disable( )
+	{ _isEnabled = false; }
+
+	bool SpriteBatch::IsEnabled( ) const
+	{ return _isEnabled; }
+
+	void SpriteBatch::SetSortMode( const SORT_MODE &sortMode )
+	{ _sortMode = sortMode; }
+
+	SpriteBatch::SORT_MODE SpriteBatch::GetSortMode( ) const
+	{ return _sortMode; }
+
+	void SpriteBatch::Add( const sf::Sprite &sprite, const sf::BlendMode &blendMode )
+	{
+		Batch &batch = GetBatch( sprite.getTexture( ), blendMode );
+
+		const sf::IntRect &rect = sprite.getTextureRect( );
+		const sf::Transform &transform = sprite.getTransform( );
+		const sf::Color &color = sprite.getColor( );
+
+		const float width = static_cast<float>( std::abs( rect.width ) );
+		const float height = static_cast<float>( std::abs( rect.height ) );
+
+		const float left = static_cast<float>( rect.left );
+		const float right = left + rect.width;
+		const float top = static_cast<float>( rect.top );
+		const float bottom = top + rect.height;
+
+		// Same corners as sf::Sprite, transformed on the CPU so every sprite can share one vertex array
+		const sf::Vertex topLeft( transform.transformPoint( 0, 0 ), color, sf::Vector2f( left, top ) );
+		const sf::Vertex bottomLeft( transform.transformPoint( 0, height ), color, sf::Vector2f( left, bottom ) );
+		const sf::Vertex topRight( transform.transformPoint( width, 0 ), color, sf::Vector2f( right, top ) );
+		const sf::Vertex bottomRight( transform.transformPoint( width, height ), color, sf::Vector2f( right, bottom ) );
+
+		batch.vertices.append( topLeft );
+		batch.vertices.append( bottomLeft );
+		batch.vertices.append( topRight );
+		batch.vertices.append( topRight );
+		batch.vertices.append( bottomLeft );
+		batch.vertices.append( bottomRight );
+
+		_spriteCount++;
+	}
+
+	void SpriteBatch::Flush( sf::RenderTarget &target )
+	{
+		for ( unsigned int i = 0; i < _activeBatches; i++ )
+		{
+			Batch &batch = _batches.at( i );
+
+			if ( 0 < batch.vertices.getVertexCount( ) )
+			{
+				sf::RenderStates states( batch.blendMode );
+				states.texture = batch.texture;
+
+				target.draw( batch.vertices, states );
+
+				_drawCallCount++;
+				_vertexCount += batch.vertices.getVertexCount( );
+			}
+
+			// clear( ) keeps the capacity so the next frame doesn't reallocate
+			batch.vertices.clear( );
+		}
+
+		_activeBatches = 0;
+	}
+
+	void SpriteBatch::EndFrame( )
+	{
+		_lastSpriteCount = _spriteCount;
+		_lastDrawCallCount = _drawCallCount;
+		_lastVertexCount = _vertexCount;
+
+		_spriteCount = _drawCallCount = _vertexCount = 0;
+	}
+
+	unsigned int SpriteBatch::GetSpriteCount( ) const
+	{ return _lastSpriteCount; }
+
+	unsigned int SpriteBatch::GetDrawCallCount( ) const
+	{ return _lastDrawCallCount; }
+
+	unsigned int SpriteBatch::GetMergedDrawCallCount( ) const
+	{
+		if ( _lastSpriteCount > _lastDrawCallCount )
+		{ return _lastSpriteCount - _lastDrawCallCount; }
+		else
+		{ return 0; }
+	}
+
+	unsigned int SpriteBatch::GetVertexCount( ) const
+	{ return _lastVertexCount; }
+
+	SpriteBatch::Batch &SpriteBatch::GetBatch( const sf::Texture *texture, const sf::BlendMode &blendMode )
+	{
+		if ( SORT_MODE::TEXTURE == _sortMode )
+		{
+			for ( unsigned int i = 0; i < _activeBatches; i++ )
+			{
+				if ( _batches.at( i ).texture == texture && _batches.at( i ).blendMode == blendMode )
+				{ return _batches.at( i ); }
+			}
+		}
+		else if ( 0 < _activeBatches )
+		{
+			Batch &lastBatch = _batches.at( _activeBatches - 1 );
+
+			if ( lastBatch.texture == texture && lastBatch.blendMode == blendMode )
+			{ return lastBatch; }
+		}
+
+		if ( _activeBatches == _batches.size( ) )
+		{ _batches.push_back( Batch{ texture, blendMode, sf::VertexArray( sf::Triangles ) } ); }
+
+		Batch &batch = _batches.at( _activeBatches );
+		batch.texture = texture;
+		batch.blendMode = blendMode;
+
+		_activeBatches++;
+
+		return batch;
+	}
+}
@@ -3,25 +3,21 @@
 namespace Sonar
 {
 	Texture::Texture( )
-	{ _texture = new sf::Texture( ); }
+	{ _texture = std::make_shared<sf::Texture>( ); }
 
     Texture::Texture( const std::string &filepath )
-	{
-		_texture = new sf::Texture( );
-		_texture->loadFromFile( filepath );
-	}
+	{ SetTexture( filepath ); }
 
-	Texture::~Texture( )
-	{ delete _texture; }
+	Texture::~Texture( ) { }
 
 	void Texture::SetTexture( const std::string &filepath )
-	{ _texture->loadFromFile( filepath ); }
+	{ _texture = ResourceCache::getInstance( )->GetTexture( filepath ); }
 
 	void Texture::SetTexture( const Texture &texture )
-	{ _texture = texture.GetTexture( ); }
+	{ _texture = texture._texture; }
 
 	sf::Texture *Texture::GetTexture( ) const
-	{ return _texture; }
+	{ return _texture.get( ); }
 
 	glm::vec2 Texture::GetSize( ) const
 	{ return glm::vec2( _texture->getSize( ).x, _texture->getSize( ).y ); }
@@ -0,0 +1,326 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+	TextureAtlas::TextureAtlas( const unsigned int &pageSize, const unsigned int &padding ) : _pageSize( pageSize ), _padding( padding )
+	{ _isLoadedFromCache = false; }
+
+	TextureAtlas::~TextureAtlas( )
+	{ ClearPages( ); }
+
+	void TextureAtlas::AddImage( const std::string &filepath )
+	{
+		if ( std::find( _filepaths.begin( ), _filepaths.end( ), filepath ) == _filepaths.end( ) )
+		{ _filepaths.push_back( filepath ); }
+	}
+
+	void TextureAtlas::AddDirectory( const std::string &directory, const std::string &extension )
+	{
+		if ( !std::filesystem::is_directory( directory ) )
+		{ return; }
+
+		std::vector<std::string> filepaths;
+
+		for ( const auto &entry : std::filesystem::directory_iterator( directory ) )
+		{
+			if ( entry.is_regular_file( ) && entry.path( ).extension( ).string( ) == extension )
+			{ filepaths.push_back( entry.path( ).generic_string( ) ); }
+		}
+
+		// Directory order isn't guaranteed, sorting keeps the cache valid between runs
+		std::sort( filepaths.begin( ), filepaths.end( ) );
+
+		for ( const auto &filepath : filepaths )
+		{ AddImage( filepath ); }
+	}
+
+	bool TextureAtlas::Build( const std::string &cacheFilepath )
+	{
+		ClearPages( );
+		_regions.clear( );
+		_isLoadedFromCache = false;
+
+		if ( "" != cacheFilepath && LoadCache( cacheFilepath ) )
+		{
+			_isLoadedFromCache = true;
+
+			return true;
+		}
+
+		std::vector<sf::Image> images( _filepaths.size( ) );
+		std::vector<unsigned int> order;
+		bool isSuccessful = true;
+
+		for ( unsigned int i = 0; i < _filepaths.size( ); i++ )
+		{
+			if ( images.at( i ).loadFromFile( _filepaths.at( i ) ) )
+			{ order.push_back( i ); }
+			else
+			{ isSuccessful = false; }
+		}
+
+		// Packing the tallest images first leaves a flatter skyline and wastes less space
+		std::sort( order.begin( ), order.end( ), [&images]( const unsigned int &a, const unsigned int &b )
+		{
+			if ( images.at( a ).getSize( ).y != images.at( b ).getSize( ).y )
+			{ return images.at( a ).getSize( ).y > images.at( b ).getSize( ).y; }
+			else
+			{ return images.at( a ).getSize( ).x > images.at( b ).getSize( ).x; }
+		} );
+
+		std::vector<Skyline> skylines;
+		std::vector<glm::ivec2> pageSizes;
+		std::vector<sf::Image> pages;
+
+		for ( const auto &index : order )
+		{
+			const sf::Image &image = images.at( index );
+			const glm::ivec2 imageSize( image.getSize( ).x, image.getSize( ).y );
+			const glm::ivec2 paddedSize = imageSize + glm::ivec2( _padding * 2 );
+
+			glm::ivec2 position;
+			unsigned int page = 0;
+
+			while ( page < skylines.size( ) && !PackRectangle( skylines.at( page ), pageSizes.at( page ), paddedSize, position ) )
+			{ page++; }
+
+			if ( page == skylines.size( ) )
+			{
+				// Images larger than a page get a page of their own
+				const glm::ivec2 pageSize( std::max<int>( _pageSize, paddedSize.x ), std::max<int>( _pageSize, paddedSize.y ) );
+
+				skylines.push_back( Skyline( 1, SkylineNode{ 0, 0, pageSize.x } ) );
+				pageSizes.push_back( pageSize );
+				pages.push_back( sf::Image( ) );
+				pages.back( ).create( pageSize.x, pageSize.y, sf::Color::Transparent );
+
+				PackRectangle( skylines.back( ), pageSize, paddedSize, position );
+			}
+
+			pages.at( page ).copy( image, position.x + _padding, position.y + _padding );
+
+			_regions[_filepaths.at( index )] = Region{ page, glm::ivec4( position.x + _padding, position.y + _padding, imageSize.x, imageSize.y ) };
+		}
+
+		for ( const auto &pageImage : pages )
+		{
+			Texture *texture = new Texture( );
+			texture->GetTexture( )->loadFromImage( pageImage );
+
+			_pages.push_back( texture );
+		}
+
+		if ( "" != cacheFilepath && isSuccessful )
+		{ SaveCache( cacheFilepath, pages ); }
+
+		return isSuccessful;
+	}
+
+	bool TextureAtlas::HasRegion( const std::string &filepath ) const
+	{ return _regions.find( filepath ) != _regions.end( ); }
+
+	const TextureAtlas::Region &TextureAtlas::GetRegion( const std::string &filepath ) const
+	{ return _regions.at( filepath ); }
+
+	Texture *TextureAtlas::GetPage( const unsigned int &index ) const
+	{ return _pages.at( index ); }
+
+	unsigned int TextureAtlas::GetPageCount( ) const
+	{ return _pages.size( ); }
+
+	bool TextureAtlas::IsLoadedFromCache( ) const
+	{ return _isLoadedFromCache; }
+
+	bool TextureAtlas::PackRectangle( Skyline &skyline, const glm::ivec2 &pageSize, const glm::ivec2 &size, glm::ivec2 &position ) const
+	{
+		int bestIndex = -1;
+		int bestY = pageSize.y;
+		int bestWidth = pageSize.x;
+
+		for ( unsigned int i = 0; i < skyline.size( ); i++ )
+		{
+			const int y = GetSkylineHeight( skyline, i, pageSize, size );
+
+			if ( -1 != y && ( y < bestY || ( y == bestY && skyline.at( i ).width < bestWidth ) ) )
+			{
+				bestIndex = i;
+				bestY = y;
+				bestWidth = skyline.at( i ).width;
+			}
+		}
+
+		if ( -1 == bestIndex )
+		{ return false; }
+
+		position = glm::ivec2( skyline.at( bestIndex ).x, bestY );
+
+		skyline.insert( skyline.begin( ) + bestIndex, SkylineNode{ position.x, position.y + size.y, size.x } );
+
+		// Shrink or remove the nodes now covered by the new one
+		for ( unsigned int i = bestIndex + 1; i < skyline.size( ); )
+		{
+			const SkylineNode &previous = skyline.at( i - 1 );
+			SkylineNode &node = skyline.at( i );
+
+			if ( node.x < previous.x + previous.width )
+			{
+				const int shrink = previous.x + previous.width - node.x;
+
+				node.x += shrink;
+				node.width -= shrink;
+
+				if ( node.width <= 0 )
+				{
+					skyline.erase( skyline.begin( ) + i );
+
+					continue;
+				}
+			}
+
+			break;
+		}
+
+		// Merge neighbouring nodes at the same height
+		for ( unsigned int i = 0; i + 1 < skyline.size( ); )
+		{
+			if ( skyline.at( i ).y == skyline.at( i + 1 ).y )
+			{
+				skyline.at( i ).width += skyline.at( i + 1 ).width;
+				skyline.erase( skyline.begin( ) + i + 1 );
+			}
+			else
+			{ i++; }
+		}
+
+		return true;
+	}
+
+	int TextureAtlas::GetSkylineHeight( const Skyline &skyline, const unsigned int &index, const glm::ivec2 &pageSize, const glm::ivec2 &size ) const
+	{
+		const int x = skyline.at( index ).x;
+
+		if ( x + size.x > pageSize.x )
+		{ return -1; }
+
+		int y = 0;
+		int widthLeft = size.x;
+
+		for ( unsigned int i = index; widthLeft > 0 && i < skyline.size( ); i++ )
+		{
+			y = std::max( y, skyline.at( i ).y );
+
+			if ( y + size.y > pageSize.y )
+			{ return -1; }
+
+			widthLeft -= skyline.at( i ).width;
+		}
+
+		return y;
+	}
+
+	bool TextureAtlas::LoadCache( const std::string &cacheFilepath )
+	{
+		std::ifstream file( cacheFilepath );
+
+		if ( !file.is_open( ) )
+		{ return false; }
+
+		nlohmann::json layout = nlohmann::json::parse( file, nullptr, false );
+
+		if ( layout.is_discarded( ) || !layout.contains( "sources" ) || !layout.contains( "regions" ) || !layout.contains( "pageCount" ) )
+		{ return false; }
+
+		// Any added, removed or modified image invalidates the layout
+		if ( layout["sources"] != GetSourceInfo( ) || layout["pageSize"] != _pageSize || layout["padding"] != _padding )
+		{ return false; }
+
+		const unsigned int pageCount = layout["pageCount"];
+
+		for ( unsigned int i = 0; i < pageCount; i++ )
+		{
+			Texture *texture = new Texture( );
+
+			if ( !texture->GetTexture( )->loadFromFile( GetPageFilepath( cacheFilepath, i ) ) )
+			{
+				delete texture;
+				ClearPages( );
+
+				return false;
+			}
+
+			_pages.push_back( texture );
+		}
+
+		for ( const auto &region : layout["regions"].items( ) )
+		{
+			const auto &rectangle = region.value( )["rectangle"];
+
+			_regions[region.key( )] = Region{ region.value( )["page"], glm::ivec4( rectangle[0], rectangle[1], rectangle[2], rectangle[3] ) };
+		}
+
+		return true;
+	}
+
+	void TextureAtlas::SaveCache( const std::string &cacheFilepath, const std::vector<sf::Image> &pages ) const
+	{
+		const std::filesystem::path directory = std::filesystem::path( cacheFilepath ).parent_path( );
+
+		if ( !directory.empty( ) )
+		{ std::filesystem::create_directories( directory ); }
+
+		for ( unsigned int i = 0; i < pages.size( ); i++ )
+		{ pages.at( i ).saveToFile( GetPageFilepath( cacheFilepath, i ) ); }
+
+		nlohmann::json layout;
+
+		layout["pageSize"] = _pageSize;
+		layout["padding"] = _padding;
+		layout["pageCount"] = pages.size( );
+		layout["sources"] = GetSourceInfo( );
+
+		for ( const auto &region : _regions )
+		{
+			layout["regions"][region.first] =
+			{
+				{ "page", region.second.page },
+				{ "rectangle", { region.second.rectangle.x, region.second.rectangle.y, region.second.rectangle.z, region.second.rectangle.w } }
+			};
+		}
+
+		FileManager manager;
+		manager.WriteToFile( cacheFilepath, layout.dump( ), FileManager::WRITE_PROPERTY::ADD_TO_CURRENT_LINE, true, true );
+	}
+
+	std::string TextureAtlas::GetPageFilepath( const std::string &cacheFilepath, const unsigned int &index ) const
+	{
+		std::filesystem::path path( cacheFilepath );
+		path.replace_filename( path.stem( ).string( ) + "_" + std::to_string( index ) + ".png" );
+
+		return path.generic_string( );
+	}
+
+	nlohmann::json TextureAtlas::GetSourceInfo( ) const
+	{
+		nlohmann::json sources = nlohmann::json::array( );
+
+		for ( const auto &filepath : _filepaths )
+		{
+			std::error_code error;
+
+			const auto fileSize = std::filesystem::file_size( filepath, error );
+			const auto modified = std::filesystem::last_write_time( filepath, error ).time_since_epoch( ).count( );
+
+			sources.push_back( { { "file", filepath }, { "size", error ? 0 : fileSize }, { "modified", error ? 0 : modified } } );
+		}
+
+		return sources;
+	}
+
+	void TextureAtlas::ClearPages( )
+	{
+		for ( auto &page : _pages )
+		{ delete page; }
+
+		_pages.clear( );
+	}
+}
@@ -0,0 +1,181 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+	TileMap::TileMap( GameDataRef data, MapManager *map, const unsigned int &layer ) : _data( data ), _map( map ), _layer( layer )
+	{
+		_tileset = nullptr;
+		_tileSize = glm::uvec2( 0 );
+		_cellSize = glm::vec2( 0.0f );
+		_position = glm::vec2( 0.0f );
+		_chunkCount = glm::uvec2( 0 );
+		_drawnChunkCount = 0;
+		_rebuiltChunkCount = 0;
+
+		_tileFunction = []( const MapCell &value ) { return ( ' ' == value ) ? -1 : static_cast<int>( value ); };
+	}
+
+	TileMap::~TileMap( ) { }
+
+	void TileMap::Draw( )
+	{
+		_drawnChunkCount = 0;
+		_rebuiltChunkCount = 0;
+
+		if ( nullptr == _tileset || 0 == _tileSize.x || 0 == _tileSize.y || _cellSize.x <= 0.0f || _cellSize.y <= 0.0f )
+		{ return; }
+
+		// A resized or reloaded map gets new meshes, the versions tell which ones
+		if ( _map->GetChunkCount( ) != _chunkCount )
+		{
+			_chunkCount = _map->GetChunkCount( );
+			_chunks.clear( );
+			_chunks.resize( static_cast<std::size_t>( _chunkCount.x ) * _chunkCount.y );
+		}
+
+		if ( _chunks.empty( ) )
+		{ return; }
+
+		sf::RenderWindow &window = _data->window.GetSFMLWindowObject( );
+		const sf::View &view = window.getView( );
+
+		// Bounding box of the (possibly rotated) view in world space
+		const float angle = glm::radians( view.getRotation( ) );
+		const float cosine = std::abs( std::cos( angle ) ), sine = std::abs( std::sin( angle ) );
+		const glm::vec2 viewSize( view.getSize( ).x, view.getSize( ).y );
+		const glm::vec2 halfSize = glm::vec2( viewSize.x * cosine + viewSize.y * sine, viewSize.x * sine + viewSize.y * cosine ) * 0.5f;
+		const glm::vec2 center( view.getCenter( ).x, view.getCenter( ).y );
+
+		const glm::vec2 chunkSize = _cellSize * static_cast<float>( SONAR_MAP_CHUNK_SIZE );
+		const glm::vec2 first = glm::floor( ( center - halfSize - _position ) / chunkSize );
+		const glm::vec2 last = glm::floor( ( center + halfSize - _position ) / chunkSize );
+
+		if ( last.x < 0.0f || last.y < 0.0f || first.x >= _chunkCount.x || first.y >= _chunkCount.y )
+		{ return; }
+
+		const glm::uvec2 begin( std::max( first.x, 0.0f ), std::max( first.y, 0.0f ) );
+		const glm::uvec2 end( std::min<float>( last.x + 1.0f, _chunkCount.x ), std::min<float>( last.y + 1.0f, _chunkCount.y ) );
+
+		// Sprites queued before the map have to be drawn first to keep the draw order
+		if ( _data->spriteBatch.IsEnabled( ) && SpriteBatch::SORT_MODE::DEFERRED == _data->spriteBatch.GetSortMode( ) )
+		{ _data->spriteBatch.Flush( window ); }
+
+		// A tileset from the asset manager is kept resident while the map draws it
+		_data->assets.MarkUsed( *_tileset );
+
+		sf::RenderStates states( _tileset );
+		states.transform.translate( _position.x, _position.y );
+
+		for ( unsigned int chunkY = begin.y; chunkY < end.y; chunkY++ )
+		{
+			for ( unsigned int chunkX = begin.x; chunkX < end.x; chunkX++ )
+			{
+				Chunk &chunk = _chunks[static_cast<std::size_t>( chunkY ) * _chunkCount.x + chunkX];
+
+				if ( _map->GetChunkVersion( chunkX, chunkY, _layer ) != chunk.version )
+				{
+					BuildChunk( chunkX, chunkY, chunk );
+					_rebuiltChunkCount++;
+				}
+
+				// Chunks without a tile cost no draw call
+				if ( 0 == chunk.vertices.getVertexCount( ) )
+				{ continue; }
+
+				window.draw( chunk.vertices, states );
+				_data->frameStats.AddDrawCall( chunk.vertices.getVertexCount( ) );
+
+				_drawnChunkCount++;
+			}
+		}
+	}
+
+	void TileMap::SetTileset( const sf::Texture *texture, const glm::uvec2 &tileSize )
+	{
+		_tileset = texture;
+		_tileSize = tileSize;
+
+		if ( _cellSize.x <= 0.0f || _cellSize.y <= 0.0f )
+		{ _cellSize = glm::vec2( tileSize ); }
+
+		ClearChunks( );
+	}
+
+	void TileMap::SetTileFunction( const TileFunction &tileFunction )
+	{
+		_tileFunction = tileFunction;
+
+		ClearChunks( );
+	}
+
+	void TileMap::SetCellSize( const glm::vec2 &cellSize )
+	{
+		_cellSize = cellSize;
+
+		ClearChunks( );
+	}
+
+	glm::vec2 TileMap::GetCellSize( ) const
+	{ return _cellSize; }
+
+	void TileMap::SetPosition( const glm::vec2 &position )
+	{ _position = position; }
+
+	glm::vec2 TileMap::GetPosition( ) const
+	{ return _position; }
+
+	unsigned int TileMap::GetDrawnChunkCount( ) const
+	{ return _drawnChunkCount; }
+
+	unsigned int TileMap::GetRebuiltChunkCount( ) const
+	{ return _rebuiltChunkCount; }
+
+	void TileMap::BuildChunk( const unsigned int &chunkX, const unsigned int &chunkY, Chunk &chunk )
+	{
+		chunk.version = _map->GetChunkVersion( chunkX, chunkY, _layer );
+		chunk.vertices.clear( );
+		chunk.vertices.setPrimitiveType( sf::Quads );
+
+		const MapCell *cells = _map->GetChunk( chunkX, chunkY, _layer );
+
+		if ( nullptr == cells )
+		{ return; }
+
+		const int columns = _tileset->getSize( ).x / _tileSize.x;
+		const int tileCount = columns * static_cast<int>( _tileset->getSize( ).y / _tileSize.y );
+
+		// Edge chunks stop at the edge of the map
+		const unsigned int width = std::min<unsigned int>( SONAR_MAP_CHUNK_SIZE, _map->GetSizeX( ) - chunkX * SONAR_MAP_CHUNK_SIZE );
+		const unsigned int height = std::min<unsigned int>( SONAR_MAP_CHUNK_SIZE, _map->GetSizeY( ) - chunkY * SONAR_MAP_CHUNK_SIZE );
+
+		for ( unsigned int y = 0; y < height; y++ )
+		{
+			for ( unsigned int x = 0; x < width; x++ )
+			{
+				const int tile = _tileFunction( cells[y * SONAR_MAP_CHUNK_SIZE + x] );
+
+				if ( tile < 0 || tile >= tileCount )
+				{ continue; }
+
+				const float left = ( chunkX * SONAR_MAP_CHUNK_SIZE + x ) * _cellSize.x;
+				const float top = ( chunkY * SONAR_MAP_CHUNK_SIZE + y ) * _cellSize.y;
+				const float textureLeft = static_cast<float>( ( tile % columns ) * _tileSize.x );
+				const float textureTop = static_cast<float>( ( tile / columns ) * _tileSize.y );
+
+				chunk.vertices.append( sf::Vertex( sf::Vector2f( left, top ), sf::Vector2f( textureLeft, textureTop ) ) );
+				chunk.vertices.append( sf::Vertex( sf::Vector2f( left + _cellSize.x, top ), sf::Vector2f( textureLeft + _tileSize.x, textureTop ) ) );
+				chunk.vertices.append( sf::Vertex( sf::Vector2f( left + _cellSize.x, top + _cellSize.y ), sf::Vector2f( textureLeft + _tileSize.x, textureTop + _tileSize.y ) ) );
+				chunk.vertices.append( sf::Vertex( sf::Vector2f( left, top + _cellSize.y ), sf::Vector2f( textureLeft, textureTop + _tileSize.y ) ) );
+			}
+		}
+	}
+
+	void TileMap::ClearChunks( )
+	{
+		for ( Chunk &chunk : _chunks )
+		{
+			chunk.version = 0;
+			chunk.vertices.clear( );
+		}
+	}
+}
@@ -0,0 +1,439 @@
+#include "pch.hpp"
+
+namespace Sonar
+{
+	namespace
+	{
+		/**
+		 * \brief Log layout: magic, version and dt, then one record per event (step delta, type, type specific payload) and an end record holding the session length
+		 */
+		const char LOG_MAGIC[4] = { 'S', 'I', 'N', 'P' };
+		const unsigned char LOG_VERSION = 1;
+		const unsigned long long int LOG_END_RECORD = 0xFF;
+	}
+
+	InputRecorder::InputRecorder( )
+	{
+		_readPosition = 0;
+		_replayIndex = 0;
+		_step = 0;
+		_lastEventStep = 0;
+		_replayLength = 0;
+		_replayDt = 0;
+		_isRecording = false;
+		_isReplaying = false;
+	}
+
+	InputRecorder::~InputRecorder( )
+	{
+		if ( _isRecording )
+		{ StopRecording( ); }
+	}
+
+	bool InputRecorder::StartRecording( const std::string &filepath, const float &dt )
+	{
+		if ( _isRecording )
+		{ StopRecording( ); }
+
+		StopReplay( );
+
+		_file.open( filepath, std::ios::out | std::ios::binary | std::ios::trunc );
+
+		if ( !_file.is_open( ) )
+		{ return false; }
+
+		_buffer.clear( );
+		_buffer.insert( _buffer.end( ), LOG_MAGIC, LOG_MAGIC + sizeof( LOG_MAGIC ) );
+		_buffer.push_back( LOG_VERSION );
+		WriteFloat( dt );
+
+		_step = 0;
+		_lastEventStep = 0;
+		_isRecording = true;
+
+		return true;
+	}
+
+	bool InputRecorder::StopRecording( )
+	{
+		if ( !_isRecording )
+		{ return false; }
+
+		WriteVarint( _step - _lastEventStep );
+		WriteVarint( LOG_END_RECORD );
+		Flush( );
+
+		const bool isWritten = _file.good( );
+
+		_file.close( );
+		_isRecording = false;
+
+		return isWritten;
+	}
+
+	bool InputRecorder::IsRecording( ) const
+	{ return _isRecording; }
+
+	bool InputRecorder::StartReplay( const std::string &filepath )
+	{
+		if ( _isRecording )
+		{ StopRecording( ); }
+
+		StopReplay( );
+
+		std::ifstream file( filepath, std::ios::in | std::ios::binary );
+
+		if ( !file.is_open( ) )
+		{ return false; }
+
+		_buffer.assign( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>( ) );
+		_readPosition = sizeof( LOG_MAGIC ) + 1;
+
+		if ( _buffer.size( ) < _readPosition || !std::equal( LOG_MAGIC, LOG_MAGIC + sizeof( LOG_MAGIC ), _buffer.begin( ) ) || LOG_VERSION != static_cast<unsigned char>( _buffer.at( sizeof( LOG_MAGIC ) ) ) || !ReadFloat( _replayDt ) )
+		{
+			Debug::LogStatic( "Input replay " + filepath + " is not a valid input log" );
+			_buffer.clear( );
+
+			return false;
+		}
+
+		unsigned long long int step = 0, delta = 0, type = 0;
+		bool isEnded = false;
+
+		// Decode everything up front so replaying never touches the disk or parses mid frame
+		while ( !isEnded && ReadVarint( delta ) && ReadVarint( type ) )
+		{
+			step += delta;
+
+			if ( LOG_END_RECORD == type )
+			{
+				isEnded = true;
+				break;
+			}
+
+			sf::Event sfEvent = sf::Event( );
+			sfEvent.type = static_cast<sf::Event::EventType>( type );
+
+			int value = 0;
+			unsigned long long int unsignedValue = 0;
+			bool isValid = true;
+
+			switch ( type )
+			{
+				case Event::Resized:
+					isValid = ReadVarint( unsignedValue );
+					sfEvent.size.width = unsignedValue;
+					isValid = isValid && ReadVarint( unsignedValue );
+					sfEvent.size.height = unsignedValue;
+					break;
+
+				case Event::TextEntered:
+					isValid = ReadVarint( unsignedValue );
+					sfEvent.text.unicode = unsignedValue;
+					break;
+
+				case Event::KeyPressed:
+				case Event::KeyReleased:
+					isValid = ReadSigned( value );
+					sfEvent.key.code = static_cast<sf::Keyboard::Key>( value );
+					isValid = isValid && ReadVarint( unsignedValue );
+					sfEvent.key.alt = 0 != ( unsignedValue & 1 );
+					sfEvent.key.control = 0 != ( unsignedValue & 2 );
+					sfEvent.key.shift = 0 != ( unsignedValue & 4 );
+					sfEvent.key.system = 0 != ( unsignedValue & 8 );
+					break;
+
+				case Event::MouseWheelMoved:
+					isValid = ReadSigned( sfEvent.mouseWheel.delta ) && ReadSigned( sfEvent.mouseWheel.x ) && ReadSigned( sfEvent.mouseWheel.y );
+					break;
+
+				case Event::MouseWheelScrolled:
+					isValid = ReadSigned( value );
+					sfEvent.mouseWheelScroll.wheel = static_cast<sf::Mouse::Wheel>( value );
+					isValid = isValid && ReadFloat( sfEvent.mouseWheelScroll.delta ) && ReadSigned( sfEvent.mouseWheelScroll.x ) && ReadSigned( sfEvent.mouseWheelScroll.y );
+					break;
+
+				case Event::MouseButtonPressed:
+				case Event::MouseButtonReleased:
+					isValid = ReadSigned( value );
+					sfEvent.mouseButton.button = static_cast<sf::Mouse::Button>( value );
+					isValid = isValid && ReadSigned( sfEvent.mouseButton.x ) && ReadSigned( sfEvent.mouseButton.y );
+					break;
+
+				case Event::MouseMoved:
+					isValid = ReadSigned( sfEvent.mouseMove.x ) && ReadSigned( sfEvent.mouseMove.y );
+					break;
+
+				case Event::JoystickButtonPressed:
+				case Event::JoystickButtonReleased:
+					isValid = ReadVarint( unsignedValue );
+					sfEvent.joystickButton.joystickId = unsignedValue;
+					isValid = isValid && ReadVarint( unsignedValue );
+					sfEvent.joystickButton.button = unsignedValue;
+					break;
+
+				case Event::JoystickMoved:
+					isValid = ReadVarint( unsignedValue );
+					sfEvent.joystickMove.joystickId = unsignedValue;
+					isValid = isValid && ReadSigned( value );
+					sfEvent.joystickMove.axis = static_cast<sf::Joystick::Axis>( value );
+					isValid = isValid && ReadFloat( sfEvent.joystickMove.position );
+					break;
+
+				case Event::JoystickConnected:
+				case Event::JoystickDisconnected:
+					isValid = ReadVarint( unsignedValue );
+					sfEvent.joystickConnect.joystickId = unsignedValue;
+					break;
+
+				case Event::TouchBegan:
+				case Event::TouchMoved:
+				case Event::TouchEnded:
+					isValid = ReadVarint( unsignedValue );
+					sfEvent.touch.finger = unsignedValue;
+					isValid = isValid && ReadSigned( sfEvent.touch.x ) && ReadSigned( sfEvent.touch.y );
+					break;
+
+				case Event::SensorChanged:
+					isValid = ReadSigned( value );
+					sfEvent.sensor.type = static_cast<sf::Sensor::Type>( value );
+					isValid = isValid && ReadFloat( sfEvent.sensor.x ) && ReadFloat( sfEvent.sensor.y ) && ReadFloat( sfEvent.sensor.z );
+					break;
+
+				default:
+					// The remaining types carry no data
+					isValid = type < Event::Count;
+					break;
+			}
+
+			if ( !isValid )
+			{ break; }
+
+			_replayEvents.push_back( std::make_pair( step, Event( sfEvent ) ) );
+		}
+
+		// A log cut short (the game crashed while recording) still replays up to its last event
+		if ( !isEnded )
+		{
+			Debug::LogStatic( "Input replay " + filepath + " has no end record, replaying up to its last event" );
+			step = _replayEvents.empty( ) ? 0 : _replayEvents.back( ).first + 1;
+		}
+
+		_buffer.clear( );
+
+		_replayLength = step;
+		_replayIndex = 0;
+		_step = 0;
+		_isReplaying = true;
+
+		return true;
+	}
+
+	void InputRecorder::StopReplay( )
+	{
+		_replayEvents.clear( );
+		_replayIndex = 0;
+		_isReplaying = false;
+	}
+
+	bool InputRecorder::IsReplaying( ) const
+	{ return _isReplaying; }
+
+	float InputRecorder::GetReplayDt( ) const
+	{ return _replayDt; }
+
+	unsigned long long int InputRecorder::GetReplayLength( ) const
+	{ return _replayLength; }
+
+	void InputRecorder::Record( const Event &event )
+	{
+		if ( !_isRecording )
+		{ return; }
+
+		WriteVarint( _step - _lastEventStep );
+		WriteVarint( event.type );
+		_lastEventStep = _step;
+
+		switch ( event.type )
+		{
+			case Event::Resized:
+				WriteVarint( event.size.width );
+				WriteVarint( event.size.height );
+				break;
+
+			case Event::TextEntered:
+				WriteVarint( event.text.unicode );
+				break;
+
+			case Event::KeyPressed:
+			case Event::KeyReleased:
+				WriteSigned( static_cast<int>( event.key.code ) );
+				WriteVarint( ( event.key.alt ? 1 : 0 ) | ( event.key.control ? 2 : 0 ) | ( event.key.shift ? 4 : 0 ) | ( event.key.system ? 8 : 0 ) );
+				break;
+
+			case Event::MouseWheelMoved:
+				WriteSigned( event.mouseWheel.delta );
+				WriteSigned( event.mouseWheel.x );
+				WriteSigned( event.mouseWheel.y );
+				break;
+
+			case Event::MouseWheelScrolled:
+				WriteSigned( static_cast<int>( event.mouseWheelScroll.wheel ) );
+				WriteFloat( event.mouseWheelScroll.delta );
+				WriteSigned( event.mouseWheelScroll.x );
+				WriteSigned( event.mouseWheelScroll.y );
+				break;
+
+			case Event::MouseButtonPressed:
+			case Event::MouseButtonReleased:
+				WriteSigned( static_cast<int>( event.mouseButton.button ) );
+				WriteSigned( event.mouseButton.x );
+				WriteSigned( event.mouseButton.y );
+				break;
+
+			case Event::MouseMoved:
+				WriteSigned( event.mouseMove.x );
+				WriteSigned( event.mouseMove.y );
+				break;
+
+			case Event::JoystickButtonPressed:
+			case Event::JoystickButtonReleased:
+				WriteVarint( event.joystickButton.joystickId );
+				WriteVarint( event.joystickButton.button );
+				break;
+
+			case Event::JoystickMoved:
+				WriteVarint( event.joystickMove.joystickId );
+				WriteSigned( event.joystickMove.axis );
+				WriteFloat( event.joystickMove.position );
+				break;
+
+			case Event::JoystickConnected:
+			case Event::JoystickDisconnected:
+				WriteVarint( event.joystickConnect.joystickId );
+				break;
+
+			case Event::TouchBegan:
+			case Event::TouchMoved:
+			case Event::TouchEnded:
+				WriteVarint( event.touch.finger );
+				WriteSigned( event.touch.x );
+				WriteSigned( event.touch.y );
+				break;
+
+			case Event::SensorChanged:
+				WriteSigned( event.sensor.type );
+				WriteFloat( event.sensor.x );
+				WriteFloat( event.sensor.y );
+				WriteFloat( event.sensor.z );
+				break;
+
+			default:
+				break;
+		}
+
+		if ( _buffer.size( ) >= DEFAULT_INPUT_RECORDER_FLUSH_SIZE )
+		{ Flush( ); }
+	}
+
+	bool InputRecorder::GetReplayEvent( Event &event )
+	{
+		if ( !_isReplaying || _replayIndex >= _replayEvents.size( ) || _replayEvents.at( _replayIndex ).first != _step )
+		{ return false; }
+
+		event = _replayEvents.at( _replayIndex ).second;
+		_replayIndex++;
+
+		return true;
+	}
+
+	void InputRecorder::EndStep( )
+	{
+		if ( !_isRecording && !_isReplaying )
+		{ return; }
+
+		_step++;
+
+		if ( _isReplaying && _step >= _replayLength )
+		{
+			Debug::LogStatic( "Input replay finished after " + std::to_string( _replayLength ) + " steps" );
+			StopReplay( );
+		}
+	}
+
+	unsigned long long int InputRecorder::GetStep( ) const
+	{ return _step; }
+
+	void InputRecorder::WriteVarint( unsigned long long int value )
+	{
+		while ( value >= 0x80 )
+		{
+			_buffer.push_back( static_cast<char>( ( value & 0x7F ) | 0x80 ) );
+			value >>= 7;
+		}
+
+		_buffer.push_back( static_cast<char>( value ) );
+	}
+
+	void InputRecorder::WriteSigned( const int &value )
+	{ WriteVarint( ( static_cast<unsigned int>( value ) << 1 ) ^ static_cast<unsigned int>( value >> 31 ) ); }
+
+	void InputRecorder::WriteFloat( const float &value )
+	{
+		char bytes[sizeof( float )];
+		std::memcpy( bytes, &value, sizeof( float ) );
+
+		_buffer.insert( _buffer.end( ), bytes, bytes + sizeof( float ) );
+	}
+
+	bool InputRecorder::ReadVarint( unsigned long long int &value )
+	{
+		value = 0;
+
+		for ( unsigned int shift = 0; shift < 64; shift += 7 )
+		{
+			if ( _readPosition >= _buffer.size( ) )
+			{ return false; }
+
+			const unsigned char byte = static_cast<unsigned char>( _buffer.at( _readPosition++ ) );
+			value |= static_cast<unsigned long long int>( byte & 0x7F ) << shift;
+
+			if ( 0 == ( byte & 0x80 ) )
+			{ return true; }
+		}
+
+		return false;
+	}
+
+	bool InputRecorder::ReadSigned( int &value )
+	{
+		unsigned long long int encoded = 0;
+
+		if ( !ReadVarint( encoded ) )
+		{ return false; }
+
+		value = static_cast<int>( ( encoded >> 1 ) ^ ( ~( encoded & 1 ) + 1 ) );
+
+		return true;
+	}
+
+	bool InputRecorder::ReadFloat( float &value )
+	{
+		if ( _readPosition + sizeof( float ) > _buffer.size( ) )
+		{ return false; }
+
+		std::memcpy( &value, &_buffer.at( _readPosition ), sizeof( float ) );
+		_readPosition += sizeof( float );
+
+		return true;
+	}
+
+	void InputRecorder::Flush( )
+	{
+		if ( !_buffer.empty( ) )
+		{
+			_file.write( _buffer.data( ), _buffer.size( ) );
+			_buffer.clear( );
+		}
+	}
+}
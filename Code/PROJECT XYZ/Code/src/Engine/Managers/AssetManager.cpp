@@ -1,68 +1,727 @@
 #include "pch.hpp"
 
+namespace
+{
+	/**
+	 * \brief Get an asset type's name for the residency window
+	 */
+	const char *GetTypeName( const Sonar::AssetManager::ASSET_TYPE &type )
+	{
+		switch ( type )
+		{
+			case Sonar::AssetManager::ASSET_TYPE::TEXTURE:
+				return "Texture";
+
+			case Sonar::AssetManager::ASSET_TYPE::FONT:
+				return "Font";
+
+			case Sonar::AssetManager::ASSET_TYPE::SOUND:
+				return "Sound";
+
+			case Sonar::AssetManager::ASSET_TYPE::MUSIC:
+				return "Music";
+		}
+
+		return "";
+	}
+}
+
 namespace Sonar
 {
-	void AssetManager::LoadTexture( const std::string &name, const std::string &fileName )
+	AssetManager::AssetManager( JobSystem *jobs ) : _frame( 0 ), _isResidencyWindowVisible( DEFAULT_ASSET_MANAGER_RESIDENCY_WINDOW_VISIBLE ), _jobs( jobs ), _requestedLoads( 0 ), _completedLoads( 0 ), _failedLoads( 0 )
+	{
+		_budgets.fill( 0 );
+		SetBudget( ASSET_TYPE::TEXTURE, DEFAULT_ASSET_MANAGER_TEXTURE_BUDGET );
+		SetBudget( ASSET_TYPE::FONT, DEFAULT_ASSET_MANAGER_FONT_BUDGET );
+		SetBudget( ASSET_TYPE::SOUND, DEFAULT_ASSET_MANAGER_SOUND_BUDGET );
+	}
+
+	AssetManager::~AssetManager( )
+	{
+		// Jobs only hold their own load, so any still running finish on their own
+		std::lock_guard<std::mutex> lock( _pendingMutex );
+		_pendingLoads.clear( );
+	}
+
+	template<typename T, typename Loader>
+	AssetHandle AssetManager::Load( AssetSlots<T> &slots, const std::string &name, const std::string &fileName, Loader &&load )
+	{
+		AssetHandle handle = slots.GetHandle( name );
+		std::shared_ptr<const std::vector<char>> source;
+
+		// Reloading in place keeps the handle and any references to the asset valid
+		if ( T *existing = slots.Find( handle ) )
+		{
+			if ( !load( *existing, source ) )
+			{ return AssetHandle( ); }
+		}
+		else
+		{
+			std::unique_ptr<T> asset = std::make_unique<T>( );
+
+			if ( !load( *asset, source ) )
+			{ return AssetHandle( ); }
+
+			handle = slots.Add( name, std::move( asset ) );
+		}
+
+		return Track( slots, handle, fileName, source );
+	}
+
+	template<typename T>
+	AssetHandle AssetManager::Track( AssetSlots<T> &slots, const AssetHandle &handle, const std::string &fileName, const std::shared_ptr<const std::vector<char>> &source )
+	{
+		if ( auto *residency = slots.GetResidency( handle ) )
+		{
+			residency->fileName = fileName;
+			residency->source = source;
+			residency->size = EstimateSize( *slots.Find( handle ), fileName );
+			residency->lastUsedFrame = _frame;
+			residency->isEvicted = false;
+		}
+
+		return handle;
+	}
+
+	template<typename T>
+	T &AssetManager::Use( AssetSlots<T> &slots, const AssetHandle &handle )
+	{
+		T *asset = slots.Find( handle );
+
+		if ( nullptr == asset )
+		{
+			static T empty;
+
+			return empty;
+		}
+
+		auto *residency = slots.GetResidency( handle );
+		residency->lastUsedFrame = _frame;
+
+		// Evicted assets kept their object, so reloading into it makes the eviction invisible to anything referencing it
+		if ( residency->isEvicted )
+		{
+			SONAR_PROFILE_SCOPE( "Asset Reload" );
+
+			if ( !Read( *asset, residency->fileName, residency->source ) )
+			{ Debug::LogStatic( "Failed to reload evicted asset \"" + residency->fileName + "\"" ); }
+
+			residency->size = EstimateSize( *asset, residency->fileName );
+			residency->isEvicted = false;
+		}
+
+		return *asset;
+	}
+
+	template<typename T>
+	void AssetManager::EnforceBudget( AssetSlots<T> &slots, const ASSET_TYPE &type )
 	{
-		sf::Texture tex;
+		const std::size_t budget = GetBudget( type );
 
-		if (tex.loadFromFile(fileName))
+		if ( 0 == budget )
+		{ return; }
+
+		std::size_t residentSize = 0;
+		std::vector<std::pair<unsigned long long, AssetHandle>> candidates;
+
+		slots.ForEach( [&]( const AssetHandle &handle, const std::string &name, const auto &residency )
+		{
+			if ( residency.isEvicted )
+			{ return; }
+
+			residentSize += residency.size;
+
+			// Assets used this frame stay even over budget, evicting them would only reload them next frame
+			if ( residency.lastUsedFrame < _frame )
+			{ candidates.emplace_back( residency.lastUsedFrame, handle ); }
+		} );
+
+		if ( residentSize <= budget )
+		{ return; }
+
+		std::sort( candidates.begin( ), candidates.end( ), []( const auto &first, const auto &second ) { return first.first < second.first; } );
+
+		for ( const auto &candidate : candidates )
 		{
-			this->_textures[name] = tex;
+			if ( residentSize <= budget )
+			{ break; }
+
+			T &asset = *slots.Find( candidate.second );
+
+			// Sound buffers stay loaded while a voice plays them
+			if constexpr ( std::is_same<T, sf::SoundBuffer>::value )
+			{
+				if ( IsPlaying( asset ) )
+				{ continue; }
+			}
+
+			auto *residency = slots.GetResidency( candidate.second );
+
+			// Fonts hold the decompressed pack entry they read from, it's freed with them unless something else still reads it
+			Release( asset );
+			residency->source.reset( );
+			residency->isEvicted = true;
+			residentSize -= residency->size;
 		}
 	}
 
-	const sf::Texture &AssetManager::GetTexture( const std::string &name ) const
+	template<typename T>
+	void AssetManager::CollectResidentAssets( const AssetSlots<T> &slots, const ASSET_TYPE &type, std::vector<ResidentAsset> &assets ) const
 	{
-		return this->_textures.at(name);
+		slots.ForEach( [&]( const AssetHandle &handle, const std::string &name, const auto &residency )
+		{ assets.push_back( { type, name, residency.fileName, residency.size, residency.lastUsedFrame, residency.isEvicted } ); } );
 	}
 
-	void AssetManager::LoadFont( const std::string &name, const std::string &fileName )
-    {
-        sf::Font font;
+	bool AssetManager::MountPack( const std::string &filepath )
+	{ return ResourceCache::getInstance( )->MountPack( filepath ); }
+
+	AssetHandle AssetManager::LoadTexture( const std::string &name, const std::string &fileName )
+	{ return Load( _textures, name, fileName, [this, &fileName]( sf::Texture &texture, auto &source ) { return Read( texture, fileName, source ); } ); }
+
+	const sf::Texture &AssetManager::GetTexture( const AssetHandle &handle )
+	{ return Use( _textures, handle ); }
+
+	const sf::Texture &AssetManager::GetTexture( const AssetName &name )
+	{ return GetTexture( _textures.GetHandle( name ) ); }
+
+	AssetHandle AssetManager::GetTextureHandle( const AssetName &name ) const
+	{ return _textures.GetHandle( name ); }
 
-        if (font.loadFromFile(fileName))
-        {
-            this->_fonts[name] = font;
-        }
-    }
+	void AssetManager::UnloadTexture( const AssetHandle &handle )
+	{ _textures.Remove( handle ); }
 
-    const sf::Font &AssetManager::GetFont( const std::string &name ) const
-    {
-        return this->_fonts.at(name);
-    }
+	AssetHandle AssetManager::LoadFont( const std::string &name, const std::string &fileName )
+	{ return Load( _fonts, name, fileName, [this, &fileName]( sf::Font &font, auto &source ) { return Read( font, fileName, source ); } ); }
 
-    void AssetManager::LoadSound( const std::string &name, const std::string &fileName )
-    {
-        sf::SoundBuffer buffer;
-        
-        if (buffer.loadFromFile(fileName))
-        {
-            this->_sounds[name] = buffer;
-        }
-    }
+	const sf::Font &AssetManager::GetFont( const AssetHandle &handle )
+	{ return Use( _fonts, handle ); }
 
-    const sf::Sound &AssetManager::GetSound( const std::string &name ) const
-    {
-        static sf::Sound sound;
-        
-        sound.setBuffer(this->_sounds.at(name));
-        
-        return sound;
-    }
+	const sf::Font &AssetManager::GetFont( const AssetName &name )
+	{ return GetFont( _fonts.GetHandle( name ) ); }
 
-    void AssetManager::LoadMusic( const std::string &name, const std::string &fileName )
-    {
-        sf::Music music;
-                
-        if (music.openFromFile(fileName))
-        {
-            this->_musics[name].openFromFile(fileName);
-        }
-    }
+	AssetHandle AssetManager::GetFontHandle( const AssetName &name ) const
+	{ return _fonts.GetHandle( name ); }
+
+	void AssetManager::UnloadFont( const AssetHandle &handle )
+	{ _fonts.Remove( handle ); }
+
+	AssetHandle AssetManager::LoadSound( const std::string &name, const std::string &fileName )
+	{ return Load( _sounds, name, fileName, [this, &fileName]( sf::SoundBuffer &buffer, auto &source ) { return Read( buffer, fileName, source ); } ); }
+
+	sf::Sound &AssetManager::GetSound( const AssetHandle &handle )
+	{
+		// Prefer a stopped voice, otherwise cut off the one that has been playing longest
+		sf::Sound *voice = &_voices.front( );
+
+		for ( auto &candidate : _voices )
+		{
+			if ( sf::Sound::Stopped == candidate.getStatus( ) )
+			{
+				voice = &candidate;
+				break;
+			}
+
+			if ( candidate.getPlayingOffset( ) > voice->getPlayingOffset( ) )
+			{ voice = &candidate; }
+		}
+
+		voice->stop( );
+		voice->setBuffer( GetSoundBuffer( handle ) );
+
+		return *voice;
+	}
+
+	sf::Sound &AssetManager::GetSound( const AssetName &name )
+	{ return GetSound( _sounds.GetHandle( name ) ); }
+
+	const sf::SoundBuffer &AssetManager::GetSoundBuffer( const AssetHandle &handle )
+	{ return Use( _sounds, handle ); }
+
+	AssetHandle AssetManager::GetSoundHandle( const AssetName &name ) const
+	{ return _sounds.GetHandle( name ); }
+
+	void AssetManager::UnloadSound( const AssetHandle &handle )
+	{ _sounds.Remove( handle ); }
+
+	AssetHandle AssetManager::LoadMusic( const std::string &name, const std::string &fileName )
+	{ return Load( _musics, name, fileName, [this, &fileName]( sf::Music &music, auto &source ) { return Read( music, fileName, source ); } ); }
+
+	sf::Music &AssetManager::GetMusic( const AssetHandle &handle )
+	{ return Use( _musics, handle ); }
+
+	sf::Music &AssetManager::GetMusic( const AssetName &name )
+	{ return GetMusic( _musics.GetHandle( name ) ); }
+
+	AssetHandle AssetManager::GetMusicHandle( const AssetName &name ) const
+	{ return _musics.GetHandle( name ); }
+
+	void AssetManager::UnloadMusic( const AssetHandle &handle )
+	{ _musics.Remove( handle ); }
+
+	AssetFuture AssetManager::LoadTextureAsync( const std::string &name, const std::string &fileName )
+	{ return LoadAsync( ASSET_TYPE::TEXTURE, name, fileName ); }
+
+	AssetFuture AssetManager::LoadFontAsync( const std::string &name, const std::string &fileName )
+	{ return LoadAsync( ASSET_TYPE::FONT, name, fileName ); }
+
+	AssetFuture AssetManager::LoadSoundAsync( const std::string &name, const std::string &fileName )
+	{ return LoadAsync( ASSET_TYPE::SOUND, name, fileName ); }
+
+	AssetFuture AssetManager::LoadMusicAsync( const std::string &name, const std::string &fileName )
+	{ return LoadAsync( ASSET_TYPE::MUSIC, name, fileName ); }
+
+	void AssetManager::ProcessUploads( const float &timeBudget )
+	{
+		SONAR_PROFILE_SCOPE( "Asset Uploads" );
+
+		Clock clock;
+
+		do
+		{
+			std::shared_ptr<PendingLoad> load;
+
+			{
+				std::lock_guard<std::mutex> lock( _pendingMutex );
+
+				// Uploads follow decoding order rather than request order so one large file doesn't hold back the rest
+				const auto decoded = std::find_if( _pendingLoads.begin( ), _pendingLoads.end( ), []( const std::shared_ptr<PendingLoad> &pending )
+				{ return nullptr == pending->job || pending->job->IsFinished( ); } );
+
+				if ( _pendingLoads.end( ) == decoded )
+				{ return; }
+
+				load = *decoded;
+				_pendingLoads.erase( decoded );
+			}
+
+			const AssetHandle handle = Upload( *load );
+
+			if ( !handle.IsValid( ) )
+			{ Debug::LogStatic( "Failed to load \"" + load->name + "\" from \"" + load->fileName + "\"" ); }
+
+			{
+				std::lock_guard<std::mutex> lock( _pendingMutex );
+
+				_completedLoads++;
+
+				if ( !handle.IsValid( ) )
+				{ _failedLoads++; }
+			}
+
+			load->promise.set_value( handle );
+		} while ( Time::MicrosecondsToMilliseconds( clock.GetElapsedTime( ).AsMicroseconds( ) ) < timeBudget );
+	}
+
+	AssetManager::LoadProgress AssetManager::GetLoadProgress( ) const
+	{
+		LoadProgress progress;
+
+		std::lock_guard<std::mutex> lock( _pendingMutex );
+
+		progress.requested = _requestedLoads;
+		progress.completed = _completedLoads;
+		progress.failed = _failedLoads;
+		progress.decoded = progress.completed + std::count_if( _pendingLoads.begin( ), _pendingLoads.end( ), []( const std::shared_ptr<PendingLoad> &pending )
+		{ return nullptr == pending->job || pending->job->IsFinished( ); } );
+
+		return progress;
+	}
+
+	AssetFuture AssetManager::LoadAsync( const ASSET_TYPE &type, const std::string &name, const std::string &fileName )
+	{
+		std::shared_ptr<PendingLoad> load = std::make_shared<PendingLoad>( );
+		load->type = type;
+		load->name = name;
+		load->fileName = fileName;
+		load->pack = FindPack( fileName );
+
+		AssetFuture future = load->promise.get_future( ).share( );
+
+		// Without workers the load is decoded here and only the upload waits for ProcessUploads
+		if ( nullptr == _jobs || 0 == _jobs->GetThreadCount( ) )
+		{ Decode( *load ); }
+		else
+		{ load->job = _jobs->Schedule( [load]( ) { Decode( *load ); } ); }
+
+		std::lock_guard<std::mutex> lock( _pendingMutex );
+
+		// A new batch starts once the previous one has been fully uploaded
+		if ( _completedLoads == _requestedLoads )
+		{
+			_requestedLoads = 0;
+			_completedLoads = 0;
+			_failedLoads = 0;
+		}
+
+		_requestedLoads++;
+		_pendingLoads.push_back( load );
+
+		return future;
+	}
+
+	void AssetManager::Decode( PendingLoad &load )
+	{
+		SONAR_PROFILE_SCOPE( "Asset Decode" );
+
+		// Packed files are decompressed here too, so the worker does all of the reading
+		load.packed = ( nullptr != load.pack ) ? load.pack->Read( load.fileName ) : AssetPack::View( );
+
+		const AssetPack::View &packed = load.packed;
+
+		switch ( load.type )
+		{
+			case ASSET_TYPE::TEXTURE:
+				load.isDecoded = packed.IsValid( ) ? load.image.loadFromMemory( packed.data, packed.size ) : load.image.loadFromFile( load.fileName );
 
-    const sf::Music &AssetManager::GetMusic( const std::string &name ) const
-    {
-        return _musics.at(name);
-    }
+				// The pixels are copied, so a decompressed entry can be freed already
+				load.packed = AssetPack::View( );
+
+				break;
+
+			case ASSET_TYPE::FONT:
+				// Fonts only touch the GPU when glyphs are rendered, so the whole font loads here
+				load.font = std::make_unique<sf::Font>( );
+				load.isDecoded = packed.IsValid( ) ? load.font->loadFromMemory( packed.data, packed.size ) : load.font->loadFromFile( load.fileName );
+
+				break;
+
+			case ASSET_TYPE::SOUND:
+			{
+				sf::InputSoundFile file;
+
+				if ( !( packed.IsValid( ) ? file.openFromMemory( packed.data, packed.size ) : file.openFromFile( load.fileName ) ) )
+				{ break; }
+
+				load.samples.resize( file.getSampleCount( ) );
+				load.samples.resize( file.read( load.samples.data( ), load.samples.size( ) ) );
+				load.channelCount = file.getChannelCount( );
+				load.sampleRate = file.getSampleRate( );
+				load.isDecoded = !load.samples.empty( );
+
+				// The samples are copied, so a decompressed entry can be freed already
+				load.packed = AssetPack::View( );
+
+				break;
+			}
+
+			case ASSET_TYPE::MUSIC:
+				// Music streams while playing, opening it only reads the header
+				load.music = std::make_unique<sf::Music>( );
+				load.isDecoded = packed.IsValid( ) ? load.music->openFromMemory( packed.data, packed.size ) : load.music->openFromFile( load.fileName );
+
+				break;
+		}
+	}
+
+	AssetHandle AssetManager::Upload( PendingLoad &load )
+	{
+		if ( !load.isDecoded )
+		{ return AssetHandle( ); }
+
+		switch ( load.type )
+		{
+			case ASSET_TYPE::TEXTURE:
+				return Load( _textures, load.name, load.fileName, [&load]( sf::Texture &texture, auto & )
+				{
+					sf::Texture uploaded;
+					uploaded.setSmooth( texture.isSmooth( ) );
+					uploaded.setRepeated( texture.isRepeated( ) );
+
+					if ( !uploaded.loadFromImage( load.image ) )
+					{ return false; }
+
+					texture.swap( uploaded );
+
+					return true;
+				} );
+
+			case ASSET_TYPE::FONT:
+			{
+				const AssetHandle handle = _fonts.GetHandle( load.name );
+
+				if ( sf::Font *existing = _fonts.Find( handle ) )
+				{
+					*existing = *load.font;
+
+					return Track( _fonts, handle, load.fileName, load.packed.bytes );
+				}
+
+				return Track( _fonts, _fonts.Add( load.name, std::move( load.font ) ), load.fileName, load.packed.bytes );
+			}
+
+			case ASSET_TYPE::SOUND:
+				return Load( _sounds, load.name, load.fileName, [&load]( sf::SoundBuffer &buffer, auto & )
+				{ return buffer.loadFromSamples( load.samples.data( ), load.samples.size( ), load.channelCount, load.sampleRate ); } );
+
+			case ASSET_TYPE::MUSIC:
+			{
+				const AssetHandle handle = _musics.GetHandle( load.name );
+
+				// Playing music references the existing object, so it's reopened in place rather than replaced
+				if ( sf::Music *existing = _musics.Find( handle ) )
+				{
+					std::shared_ptr<const std::vector<char>> source;
+
+					return Read( *existing, load.fileName, source ) ? Track( _musics, handle, load.fileName, source ) : AssetHandle( );
+				}
+
+				return Track( _musics, _musics.Add( load.name, std::move( load.music ) ), load.fileName, load.packed.bytes );
+			}
+		}
+
+		return AssetHandle( );
+	}
+
+	AssetPack *AssetManager::FindPack( const std::string &fileName ) const
+	{ return ResourceCache::getInstance( )->FindPack( fileName ); }
+
+	void AssetManager::MarkUsed( const sf::Texture &texture )
+	{ Use( _textures, _textures.FindHandle( texture ) ); }
+
+	void AssetManager::MarkUsed( const sf::Font &font )
+	{ Use( _fonts, _fonts.FindHandle( font ) ); }
+
+	void AssetManager::SetBudget( const ASSET_TYPE &type, const std::size_t &bytes )
+	{ _budgets.at( static_cast<std::size_t>( type ) ) = bytes; }
+
+	std::size_t AssetManager::GetBudget( const ASSET_TYPE &type ) const
+	{ return _budgets.at( static_cast<std::size_t>( type ) ); }
+
+	std::size_t AssetManager::GetResidentSize( const ASSET_TYPE &type ) const
+	{
+		std::size_t residentSize = 0;
+
+		for ( const ResidentAsset &asset : GetResidentAssets( ) )
+		{
+			if ( type == asset.type && !asset.isEvicted )
+			{ residentSize += asset.size; }
+		}
+
+		return residentSize;
+	}
+
+	std::vector<AssetManager::ResidentAsset> AssetManager::GetResidentAssets( ) const
+	{
+		std::vector<ResidentAsset> assets;
+
+		CollectResidentAssets( _textures, ASSET_TYPE::TEXTURE, assets );
+		CollectResidentAssets( _fonts, ASSET_TYPE::FONT, assets );
+		CollectResidentAssets( _sounds, ASSET_TYPE::SOUND, assets );
+		CollectResidentAssets( _musics, ASSET_TYPE::MUSIC, assets );
+
+		// Evicted assets go last, they're only listed so their reload cost is visible
+		std::sort( assets.begin( ), assets.end( ), []( const ResidentAsset &first, const ResidentAsset &second )
+		{ return ( first.isEvicted != second.isEvicted ) ? second.isEvicted : first.size > second.size; } );
+
+		return assets;
+	}
+
+	void AssetManager::EndFrame( )
+	{
+		SONAR_PROFILE_SCOPE( "Asset Budgets" );
+
+		EnforceBudget( _textures, ASSET_TYPE::TEXTURE );
+		EnforceBudget( _fonts, ASSET_TYPE::FONT );
+		EnforceBudget( _sounds, ASSET_TYPE::SOUND );
+
+		_frame++;
+	}
+
+	void AssetManager::ShowResidencyWindow( )
+	{ _isResidencyWindowVisible = true; }
+
+	void AssetManager::HideResidencyWindow( )
+	{ _isResidencyWindowVisible = false; }
+
+	bool AssetManager::IsResidencyWindowVisible( ) const
+	{ return _isResidencyWindowVisible; }
+
+	void AssetManager::DrawResidencyWindow( ) const
+	{
+		if ( !_isResidencyWindowVisible )
+		{ return; }
+
+		if ( ImGui::Begin( "Asset Residency" ) )
+		{
+			const std::vector<ResidentAsset> assets = GetResidentAssets( );
+
+			for ( const ASSET_TYPE &type : { ASSET_TYPE::TEXTURE, ASSET_TYPE::FONT, ASSET_TYPE::SOUND } )
+			{
+				std::size_t residentSize = 0;
+
+				for ( const ResidentAsset &asset : assets )
+				{
+					if ( type == asset.type && !asset.isEvicted )
+					{ residentSize += asset.size; }
+				}
+
+				if ( 0 == GetBudget( type ) )
+				{ ImGui::Text( "%s: %.2f MB (no budget)", GetTypeName( type ), residentSize / ( 1024.0f * 1024.0f ) ); }
+				else
+				{ ImGui::Text( "%s: %.2f / %.2f MB", GetTypeName( type ), residentSize / ( 1024.0f * 1024.0f ), GetBudget( type ) / ( 1024.0f * 1024.0f ) ); }
+			}
+
+			ImGui::Separator( );
+
+			if ( ImGui::BeginTable( "Assets", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY ) )
+			{
+				ImGui::TableSetupColumn( "Name" );
+				ImGui::TableSetupColumn( "Type" );
+				ImGui::TableSetupColumn( "Size (KB)" );
+				ImGui::TableSetupColumn( "Last Used (frames ago)" );
+				ImGui::TableSetupColumn( "State" );
+				ImGui::TableHeadersRow( );
+
+				for ( const ResidentAsset &asset : assets )
+				{
+					ImGui::TableNextRow( );
+					ImGui::TableNextColumn( );
+					ImGui::TextUnformatted( asset.name.c_str( ) );
+					ImGui::TableNextColumn( );
+					ImGui::TextUnformatted( GetTypeName( asset.type ) );
+					ImGui::TableNextColumn( );
+					ImGui::Text( "%.1f", asset.size / 1024.0f );
+					ImGui::TableNextColumn( );
+					ImGui::Text( "%llu", _frame - asset.lastUsedFrame );
+					ImGui::TableNextColumn( );
+					ImGui::TextUnformatted( asset.isEvicted ? "Evicted" : "Resident" );
+				}
+
+				ImGui::EndTable( );
+			}
+		}
+
+		ImGui::End( );
+	}
+
+	bool AssetManager::Read( sf::Texture &texture, const std::string &fileName, std::shared_ptr<const std::vector<char>> &source )
+	{
+		// Loaded separately so a failed reload leaves the current texture alone, the texture's settings carry over
+		sf::Texture loaded;
+		loaded.setSmooth( texture.isSmooth( ) );
+		loaded.setRepeated( texture.isRepeated( ) );
+
+		if ( AssetPack *pack = FindPack( fileName ) )
+		{
+			const AssetPack::View packed = pack->Read( fileName );
+
+			if ( !loaded.loadFromMemory( packed.data, packed.size ) )
+			{ return false; }
+		}
+		else if ( !loaded.loadFromFile( fileName ) )
+		{ return false; }
+
+		// The pixels are uploaded, so the pack entry is only read while loading
+		texture.swap( loaded );
+		source.reset( );
+
+		return true;
+	}
+
+	bool AssetManager::Read( sf::Font &font, const std::string &fileName, std::shared_ptr<const std::vector<char>> &source )
+	{
+		sf::Font loaded;
+		AssetPack::View packed;
+
+		// Fonts read glyphs from their memory as they're rendered, so a decompressed entry is kept as the font's source
+		if ( AssetPack *pack = FindPack( fileName ) )
+		{
+			packed = pack->Read( fileName );
+
+			if ( !loaded.loadFromMemory( packed.data, packed.size ) )
+			{ return false; }
+		}
+		else if ( !loaded.loadFromFile( fileName ) )
+		{ return false; }
+
+		font = loaded;
+		source = packed.bytes;
+
+		return true;
+	}
+
+	bool AssetManager::Read( sf::SoundBuffer &buffer, const std::string &fileName, std::shared_ptr<const std::vector<char>> &source )
+	{
+		sf::SoundBuffer loaded;
+
+		if ( AssetPack *pack = FindPack( fileName ) )
+		{
+			const AssetPack::View packed = pack->Read( fileName );
+
+			if ( !loaded.loadFromMemory( packed.data, packed.size ) )
+			{ return false; }
+		}
+		else if ( !loaded.loadFromFile( fileName ) )
+		{ return false; }
+
+		buffer = loaded;
+		source.reset( );
+
+		return true;
+	}
+
+	bool AssetManager::Read( sf::Music &music, const std::string &fileName, std::shared_ptr<const std::vector<char>> &source )
+	{
+		// Music streams from the file (or the mapped pack), so it's opened straight into the slot
+		if ( AssetPack *pack = FindPack( fileName ) )
+		{
+			const AssetPack::View packed = pack->Read( fileName );
+
+			if ( !music.openFromMemory( packed.data, packed.size ) )
+			{ return false; }
+
+			source = packed.bytes;
+
+			return true;
+		}
+
+		if ( !music.openFromFile( fileName ) )
+		{ return false; }
+
+		source.reset( );
+
+		return true;
+	}
+
+	std::size_t AssetManager::EstimateSize( const sf::Texture &texture, const std::string &fileName ) const
+	{ return static_cast<std::size_t>( texture.getSize( ).x ) * texture.getSize( ).y * 4; }
+
+	std::size_t AssetManager::EstimateSize( const sf::Font &font, const std::string &fileName ) const
+	{
+		// Fonts keep their whole file to read glyphs from
+		if ( AssetPack *pack = FindPack( fileName ) )
+		{ return pack->Read( fileName ).size; }
+
+		std::error_code error;
+		const std::uintmax_t size = std::filesystem::file_size( fileName, error );
+
+		return error ? 0 : size;
+	}
+
+	std::size_t AssetManager::EstimateSize( const sf::SoundBuffer &buffer, const std::string &fileName ) const
+	{ return buffer.getSampleCount( ) * sizeof( sf::Int16 ); }
+
+	std::size_t AssetManager::EstimateSize( const sf::Music &music, const std::string &fileName ) const
+	{ return 0; }
+
+	void AssetManager::Release( sf::Texture &texture )
+	{
+		sf::Texture released;
+		released.setSmooth( texture.isSmooth( ) );
+		released.setRepeated( texture.isRepeated( ) );
+
+		texture.swap( released );
+	}
+
+	void AssetManager::Release( sf::Font &font )
+	{ font = sf::Font( ); }
+
+	void AssetManager::Release( sf::SoundBuffer &buffer )
+	{ buffer = sf::SoundBuffer( ); }
+
+	bool AssetManager::IsPlaying( const sf::SoundBuffer &buffer ) const
+	{
+		return std::any_of( _voices.begin( ), _voices.end( ), [&buffer]( const sf::Sound &voice )
+		{ return &buffer == voice.getBuffer( ) && sf::Sound::Stopped != voice.getStatus( ); } );
+	}
 }
@@ -0,0 +1,412 @@
+#include "pch.hpp"
+
+namespace
+{
+	/**
+	 * \brief LZ4 block format limits
+	 */
+	const std::size_t LZ4_MIN_MATCH = 4;
+	const std::size_t LZ4_LAST_LITERALS = 5; // The last bytes of a block are always literals
+	const std::size_t LZ4_MATCH_FIND_LIMIT = 12; // No match starts in the last bytes of a block
+	const std::size_t LZ4_MAX_OFFSET = 65535;
+	const unsigned int LZ4_HASH_BITS = 16;
+
+	uint32_t Read32( const char *data )
+	{
+		uint32_t value;
+		std::memcpy( &value, data, sizeof( value ) );
+
+		return value;
+	}
+
+	/**
+	 * \brief Write an LZ4 length that didn't fit in its token nibble
+	 */
+	void WriteLength( std::vector<char> &block, std::size_t length )
+	{
+		for ( ; length >= 255; length -= 255 )
+		{ block.push_back( static_cast<char>( 255 ) ); }
+
+		block.push_back( static_cast<char>( length ) );
+	}
+
+	/**
+	 * \brief Read an LZ4 length that didn't fit in its token nibble
+	 */
+	bool ReadLength( const uint8_t *&input, const uint8_t *end, std::size_t &length )
+	{
+		uint8_t byte;
+
+		do
+		{
+			if ( input >= end )
+			{ return false; }
+
+			byte = *input++;
+			length += byte;
+		} while ( 255 == byte );
+
+		return true;
+	}
+
+	/**
+	 * \brief Write an LZ4 sequence (literals followed by a match, a match length of 0 ends the block)
+	 */
+	void WriteSequence( std::vector<char> &block, const char *literals, const std::size_t &literalLength, const std::size_t &offset, const std::size_t &matchLength )
+	{
+		const std::size_t extraMatchLength = ( matchLength > 0 ) ? matchLength - LZ4_MIN_MATCH : 0;
+
+		block.push_back( static_cast<char>( ( std::min<std::size_t>( literalLength, 15 ) << 4 ) | std::min<std::size_t>( extraMatchLength, 15 ) ) );
+
+		if ( literalLength >= 15 )
+		{ WriteLength( block, literalLength - 15 ); }
+
+		block.insert( block.end( ), literals, literals + literalLength );
+
+		if ( 0 == matchLength )
+		{ return; }
+
+		block.push_back( static_cast<char>( offset & 0xFF ) );
+		block.push_back( static_cast<char>( offset >> 8 ) );
+
+		if ( extraMatchLength >= 15 )
+		{ WriteLength( block, extraMatchLength - 15 ); }
+	}
+
+	/**
+	 * \brief Check if a file is audio (stored uncompressed so music streams from the mapped file)
+	 */
+	bool IsAudio( const std::filesystem::path &filepath )
+	{
+		std::string extension = filepath.extension( ).string( );
+		std::transform( extension.begin( ), extension.end( ), extension.begin( ), []( const unsigned char &character ) { return std::tolower( character ); } );
+
+		return ".ogg" == extension || ".flac" == extension || ".wav" == extension;
+	}
+}
+
+namespace Sonar
+{
+	AssetPack::AssetPack( ) { }
+
+	AssetPack::~AssetPack( )
+	{ Close( ); }
+
+	bool AssetPack::Open( const std::string &filepath )
+	{
+		Close( );
+
+		if ( !_file.Open( filepath ) )
+		{ return false; }
+
+		const char *data = _file.GetData( );
+		const std::size_t size = _file.GetSize( );
+
+		Header header;
+
+		if ( size < sizeof( header ) )
+		{
+			Close( );
+
+			return false;
+		}
+
+		std::memcpy( &header, data, sizeof( header ) );
+
+		if ( 0 != std::memcmp( header.magic, SONAR_ASSET_PACK_MAGIC, sizeof( header.magic ) ) || SONAR_ASSET_PACK_VERSION != header.version || header.indexOffset > size )
+		{
+			Debug::LogStatic( "\"" + filepath + "\" isn't a version " + std::to_string( SONAR_ASSET_PACK_VERSION ) + " asset pack" );
+			Close( );
+
+			return false;
+		}
+
+		std::size_t position = header.indexOffset;
+
+		_entries.reserve( header.entryCount );
+
+		for ( uint32_t i = 0; i < header.entryCount; i++ )
+		{
+			Record record;
+
+			if ( size - position < sizeof( record ) )
+			{ break; }
+
+			std::memcpy( &record, data + position, sizeof( record ) );
+			position += sizeof( record );
+
+			if ( size - position < record.pathLength || record.offset > size || size - record.offset < record.storedSize )
+			{ break; }
+
+			_entries.emplace( std::string( data + position, record.pathLength ), record );
+			position += record.pathLength;
+		}
+
+		if ( _entries.size( ) != header.entryCount )
+		{
+			Debug::LogStatic( "\"" + filepath + "\" has a damaged index" );
+			Close( );
+
+			return false;
+		}
+
+		return true;
+	}
+
+	void AssetPack::Close( )
+	{
+		_file.Close( );
+		_entries.clear( );
+
+		std::lock_guard<std::mutex> lock( _mutex );
+		_decompressed.clear( );
+	}
+
+	bool AssetPack::IsOpen( ) const
+	{ return _file.IsOpen( ); }
+
+	bool AssetPack::Contains( const std::string &path ) const
+	{ return _entries.end( ) != _entries.find( NormalizePath( path ) ); }
+
+	AssetPack::View AssetPack::Read( const std::string &path )
+	{
+		View view;
+
+		const std::string entryPath = NormalizePath( path );
+		const auto entry = _entries.find( entryPath );
+
+		if ( _entries.end( ) == entry )
+		{ return view; }
+
+		const Record &record = entry->second;
+
+		if ( 0 == ( record.flags & SONAR_ASSET_PACK_FLAG_COMPRESSED ) )
+		{
+			view.data = _file.GetData( ) + record.offset;
+			view.size = record.storedSize;
+
+			return view;
+		}
+
+		std::lock_guard<std::mutex> lock( _mutex );
+
+		std::weak_ptr<const std::vector<char>> &decompressed = _decompressed[entryPath];
+
+		view.bytes = decompressed.lock( );
+
+		// Nothing holds a view of the entry anymore, so it was freed and is decompressed again
+		if ( nullptr == view.bytes )
+		{
+			std::shared_ptr<std::vector<char>> bytes = std::make_shared<std::vector<char>>( record.size );
+
+			if ( !Decompress( _file.GetData( ) + record.offset, record.storedSize, bytes->data( ), bytes->size( ) ) )
+			{
+				Debug::LogStatic( "Asset pack entry \"" + entryPath + "\" is damaged" );
+
+				return view;
+			}
+
+			view.bytes = bytes;
+			decompressed = view.bytes;
+		}
+
+		view.data = view.bytes->data( );
+		view.size = view.bytes->size( );
+
+		return view;
+	}
+
+	unsigned int AssetPack::GetEntryCount( ) const
+	{ return _entries.size( ); }
+
+	bool AssetPack::Build( const std::string &filepath, const std::vector<std::string> &directories, const bool &isCompressed )
+	{
+		std::vector<std::pair<std::string, std::filesystem::path>> files;
+
+		for ( const std::string &directory : directories )
+		{
+			const std::filesystem::path root = std::filesystem::absolute( directory ).lexically_normal( );
+
+			std::error_code error;
+
+			for ( const auto &file : std::filesystem::recursive_directory_iterator( root, error ) )
+			{
+				if ( file.is_regular_file( ) )
+				{ files.emplace_back( NormalizePath( file.path( ).lexically_relative( root.parent_path( ) ).string( ) ), file.path( ) ); }
+			}
+
+			if ( error )
+			{
+				Debug::LogStatic( "Couldn't read \"" + directory + "\": " + error.message( ) );
+
+				return false;
+			}
+		}
+
+		// Sorted so the same resources always build the same pack
+		std::sort( files.begin( ), files.end( ) );
+
+		std::ofstream pack( filepath, std::ios::out | std::ios::binary | std::ios::trunc );
+
+		if ( !pack.is_open( ) )
+		{ return false; }
+
+		Header header;
+		std::memcpy( header.magic, SONAR_ASSET_PACK_MAGIC, sizeof( header.magic ) );
+		header.version = SONAR_ASSET_PACK_VERSION;
+		header.entryCount = files.size( );
+		header.reserved = 0;
+		header.indexOffset = 0;
+
+		pack.write( reinterpret_cast<const char *>( &header ), sizeof( header ) );
+
+		std::vector<Record> records;
+		records.reserve( files.size( ) );
+
+		for ( const auto &file : files )
+		{
+			std::ifstream input( file.second, std::ios::in | std::ios::binary );
+			const std::vector<char> bytes( ( std::istreambuf_iterator<char>( input ) ), std::istreambuf_iterator<char>( ) );
+
+			Record record;
+			record.offset = pack.tellp( );
+			record.size = bytes.size( );
+			record.flags = 0;
+			record.pathLength = file.first.size( );
+
+			std::vector<char> block;
+
+			if ( isCompressed && !IsAudio( file.second ) )
+			{ block = Compress( bytes.data( ), bytes.size( ) ); }
+
+			// Entries that don't shrink are stored so they're read straight from the mapped file
+			if ( !block.empty( ) && block.size( ) < bytes.size( ) )
+			{
+				record.flags |= SONAR_ASSET_PACK_FLAG_COMPRESSED;
+				record.storedSize = block.size( );
+				pack.write( block.data( ), block.size( ) );
+			}
+			else
+			{
+				record.storedSize = bytes.size( );
+				pack.write( bytes.data( ), bytes.size( ) );
+			}
+
+			records.push_back( record );
+		}
+
+		header.indexOffset = pack.tellp( );
+
+		for ( std::size_t i = 0; i < files.size( ); i++ )
+		{
+			pack.write( reinterpret_cast<const char *>( &records.at( i ) ), sizeof( Record ) );
+			pack.write( files.at( i ).first.data( ), files.at( i ).first.size( ) );
+		}
+
+		pack.seekp( 0 );
+		pack.write( reinterpret_cast<const char *>( &header ), sizeof( header ) );
+
+		return pack.good( );
+	}
+
+	std::string AssetPack::NormalizePath( const std::string &path )
+	{ return std::filesystem::path( path ).lexically_normal( ).generic_string( ); }
+
+	std::vector<char> AssetPack::Compress( const char *data, const std::size_t &size )
+	{
+		std::vector<char> block;
+		block.reserve( size / 2 + 16 );
+
+		std::size_t position = 0;
+		std::size_t anchor = 0;
+
+		if ( size > LZ4_MATCH_FIND_LIMIT )
+		{
+			// Last position each 4 byte sequence was seen at, plus one so 0 means unseen
+			std::vector<uint32_t> table( 1u << LZ4_HASH_BITS, 0 );
+
+			const std::size_t matchEndLimit = size - LZ4_LAST_LITERALS;
+
+			while ( position + LZ4_MATCH_FIND_LIMIT <= size )
+			{
+				const uint32_t sequence = Read32( data + position );
+				uint32_t &entry = table[( sequence * 2654435761u ) >> ( 32 - LZ4_HASH_BITS )];
+
+				const std::size_t candidate = entry;
+				entry = position + 1;
+
+				if ( 0 == candidate || position - ( candidate - 1 ) > LZ4_MAX_OFFSET || Read32( data + candidate - 1 ) != sequence )
+				{
+					position++;
+
+					continue;
+				}
+
+				std::size_t matchLength = LZ4_MIN_MATCH;
+
+				while ( position + matchLength < matchEndLimit && data[candidate - 1 + matchLength] == data[position + matchLength] )
+				{ matchLength++; }
+
+				WriteSequence( block, data + anchor, position - anchor, position - ( candidate - 1 ), matchLength );
+
+				position += matchLength;
+				anchor = position;
+			}
+		}
+
+		WriteSequence( block, data + anchor, size - anchor, 0, 0 );
+
+		return block;
+	}
+
+	bool AssetPack::Decompress( const char *block, const std::size_t &blockSize, char *output, const std::size_t &size )
+	{
+		const uint8_t *input = reinterpret_cast<const uint8_t *>( block );
+		const uint8_t *inputEnd = input + blockSize;
+
+		std::size_t written = 0;
+
+		while ( input < inputEnd )
+		{
+			const uint8_t token = *input++;
+
+			std::size_t literalLength = token >> 4;
+
+			if ( 15 == literalLength && !ReadLength( input, inputEnd, literalLength ) )
+			{ return false; }
+
+			if ( static_cast<std::size_t>( inputEnd - input ) < literalLength || size - written < literalLength )
+			{ return false; }
+
+			std::copy( input, input + literalLength, output + written );
+			input += literalLength;
+			written += literalLength;
+
+			// The last sequence has no match
+			if ( input == inputEnd )
+			{ break; }
+
+			if ( inputEnd - input < 2 )
+			{ return false; }
+
+			const std::size_t offset = input[0] | ( input[1] << 8 );
+			input += 2;
+
+			std::size_t matchLength = token & 0x0F;
+
+			if ( 15 == matchLength && !ReadLength( input, inputEnd, matchLength ) )
+			{ return false; }
+
+			matchLength += LZ4_MIN_MATCH;
+
+			if ( 0 == offset || offset > written || size - written < matchLength )
+			{ return false; }
+
+			// Byte by byte since a match can overlap the bytes it's writing
+			for ( std::size_t i = 0; i < matchLength; i++, written++ )
+			{ output[written] = output[written - offset]; }
+		}
+
+		return written == size;
+	}
+}
@@ -2,8 +2,43 @@
 
 namespace Sonar
 {
+	FileManager::LineIterator::LineIterator( const char *position, const char *end ) : _position( position ), _next( position ), _end( end )
+	{ ReadLine( ); }
+
+	FileManager::LineIterator &FileManager::LineIterator::operator ++( )
+	{
+		_position = _next;
+		ReadLine( );
+
+		return *this;
+	}
+
+	void FileManager::LineIterator::ReadLine( )
+	{
+		if ( _position == _end )
+		{
+			_line = std::string_view( );
+
+			return;
+		}
+
+		const char *newline = static_cast<const char *>( std::memchr( _position, '\n', _end - _position ) );
+		const char *lineEnd = ( nullptr != newline ) ? newline : _end;
+
+		_next = ( nullptr != newline ) ? newline + 1 : _end;
+
+		// Files written on Windows end their lines with \r\n
+		if ( lineEnd != _position && '\r' == *( lineEnd - 1 ) )
+		{ lineEnd--; }
+
+		_line = std::string_view( _position, lineEnd - _position );
+	}
+
 	FileManager::FileManager( )
-	{ _fileStatus =FILE_STATUS::NOT_OPENED; }
+	{
+		_fileStatus =FILE_STATUS::NOT_OPENED;
+		_isIndexed = false;
+	}
 
 	FileManager::~FileManager( ) { }
 
@@ -23,7 +58,7 @@ namespace Sonar
 
 		if ( !std::filesystem::is_directory( std::filesystem::status( filepath ) ) )
 		{
-			char bitmaskIO;
+			std::ios::openmode bitmaskIO;
 
 			if ( ACCESS_METHOD::READING == accessMethod )
 			{ bitmaskIO = std::ios::in; }
@@ -42,14 +77,6 @@ namespace Sonar
 		}
 		else
 		{ _fileStatus = FILE_STATUS::IS_FOLDER_NOT_A_FILE; }
-
-		if ( ACCESS_METHOD::READING == accessMethod )
-		{
-			std::string lineData;
-
-			while ( std::getline( _file, lineData ) )
-			{ _fileData.push_back( lineData ); }
-		}
 	}
 
 	void FileManager::CloseFile( )
@@ -57,6 +84,10 @@ namespace Sonar
 
 	void FileManager::WriteToFile( const std::string &filepath, const std::string &data, const WRITE_PROPERTY &writeProperty, const bool &createIfDoesntExist, const bool &overwriteIfExists )
 	{
+		// A mapped file can't be truncated on every platform and its views would go stale
+		if ( filepath == _mappedFilepath )
+		{ UnmapFile( ); }
+
 		OpenFile( filepath, ACCESS_METHOD::WRITING, createIfDoesntExist, overwriteIfExists );
 
 		if ( ACCESS_METHOD::WRITING == _accessMethod )
@@ -83,6 +114,10 @@ namespace Sonar
 
 	void FileManager::WriteToFile( const std::string &filepath,const std::vector<std::string> &data, const WRITE_PROPERTY &writeProperty, const bool &createIfDoesntExist, const bool &overwriteIfExists )
 	{
+		// A mapped file can't be truncated on every platform and its views would go stale
+		if ( filepath == _mappedFilepath )
+		{ UnmapFile( ); }
+
 		OpenFile( filepath, ACCESS_METHOD::WRITING, createIfDoesntExist, overwriteIfExists );
 
 		if ( ACCESS_METHOD::WRITING == _accessMethod )
@@ -122,34 +157,145 @@ namespace Sonar
 		CloseFile( );
 	}
 
+	std::shared_future<bool> FileManager::WriteToFileAsync( const std::string &filepath, const std::string &data, const FileWriteQueue::Callback &callback )
+	{
+		// A mapped file can't be replaced on every platform and its views would go stale
+		if ( filepath == _mappedFilepath )
+		{ UnmapFile( ); }
+
+		return FileWriteQueue::getInstance( )->Write( filepath, data, callback );
+	}
+
 	std::vector<std::string> FileManager::GetFileContents( const std::string &filepath )
 	{
-		OpenFile( filepath, ACCESS_METHOD::READING );
+		std::vector<std::string> fileData;
 
-		CloseFile( );
+		for ( const std::string_view &line : GetLines( filepath ) )
+		{ fileData.emplace_back( line ); }
 
-		return _fileData;
+		return fileData;
 	}
 
 	std::string FileManager::GetLineFromFile( const std::string &filepath, const unsigned int &lineNumber )
+	{ return std::string( GetLineView( filepath, lineNumber ) ); }
+
+	std::string_view FileManager::GetLineView( const std::string &filepath, const unsigned int &lineNumber )
 	{
-		OpenFile( filepath, ACCESS_METHOD::READING );
+		if ( !MapFile( filepath ) )
+		{ return std::string_view( ); }
 
-		for ( unsigned int i = 0; i < _fileData.size( ); i++ )
+		IndexLines( );
+
+		if ( lineNumber >= _lineOffsets.size( ) )
 		{
-			if ( lineNumber == i )
+			_fileStatus = FILE_STATUS::UNKNOWN_ERROR;
+
+			return std::string_view( );
+		}
+
+		const char *data = _mappedFile.GetData( );
+		const std::size_t lineEnd = ( lineNumber + 1 < _lineOffsets.size( ) ) ? _lineOffsets.at( lineNumber + 1 ) : _mappedFile.GetSize( );
+
+		return *LineIterator( data + _lineOffsets.at( lineNumber ), data + lineEnd );
+	}
+
+	unsigned int FileManager::GetLineCount( const std::string &filepath )
+	{
+		if ( !MapFile( filepath ) )
+		{ return 0; }
+
+		IndexLines( );
+
+		return _lineOffsets.size( );
+	}
+
+	FileManager::LineRange FileManager::GetLines( const std::string &filepath )
+	{
+		if ( !MapFile( filepath ) )
+		{ return LineRange( nullptr, nullptr ); }
+
+		return LineRange( _mappedFile.GetData( ), _mappedFile.GetData( ) + _mappedFile.GetSize( ) );
+	}
+
+	bool FileManager::MapFile( const std::string &filepath )
+	{
+		// Reads see the latest save even while it's still queued
+		FileWriteQueue::getInstance( )->Wait( filepath );
+
+		std::error_code error;
+		const std::filesystem::file_status status = std::filesystem::status( filepath, error );
+
+		if ( !std::filesystem::exists( status ) )
+		{
+			UnmapFile( );
+			_fileStatus = FILE_STATUS::DOESNT_EXIST;
+
+			return false;
+		}
+
+		if ( std::filesystem::is_directory( status ) )
+		{
+			UnmapFile( );
+			_fileStatus = FILE_STATUS::IS_FOLDER_NOT_A_FILE;
+
+			return false;
+		}
+
+		const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time( filepath, error );
+		const std::uintmax_t size = std::filesystem::file_size( filepath, error );
+
+		// The mapping and line index are reused until the file changes on disk
+		if ( !_mappedFile.IsOpen( ) || filepath != _mappedFilepath || writeTime != _mappedWriteTime || size != _mappedFile.GetSize( ) )
+		{
+			UnmapFile( );
+
+			if ( !_mappedFile.Open( filepath ) )
 			{
-				_fileStatus = FILE_STATUS::OPEN;
+				_fileStatus = FILE_STATUS::UNKNOWN_ERROR;
 
-				return _fileData.at( i );
+				return false;
 			}
+
+			_mappedFilepath = filepath;
+			_mappedWriteTime = writeTime;
 		}
 
-		CloseFile( );
+		_fileStatus = FILE_STATUS::OPEN;
 
-		_fileStatus = FILE_STATUS::UNKNOWN_ERROR;
-		
-		return "";
+		return true;
 	}
 
+	void FileManager::UnmapFile( )
+	{
+		_mappedFile.Close( );
+		_mappedFilepath.clear( );
+		_lineOffsets.clear( );
+		_isIndexed = false;
+	}
+
+	void FileManager::IndexLines( )
+	{
+		if ( _isIndexed )
+		{ return; }
+
+		const char *data = _mappedFile.GetData( );
+		const std::size_t size = _mappedFile.GetSize( );
+
+		_lineOffsets.clear( );
+
+		// Same lines as std::getline, a newline at the very end doesn't start another line
+		for ( std::size_t offset = 0; offset < size; )
+		{
+			_lineOffsets.push_back( offset );
+
+			const char *newline = static_cast<const char *>( std::memchr( data + offset, '\n', size - offset ) );
+
+			if ( nullptr == newline )
+			{ break; }
+
+			offset = newline - data + 1;
+		}
+
+		_isIndexed = true;
+	}
 }
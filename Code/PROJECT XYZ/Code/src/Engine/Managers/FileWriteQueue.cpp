@@ -0,0 +1,197 @@
+#include "pch.hpp"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Sonar
+{
+	FileWriteQueue *FileWriteQueue::getInstance( )
+	{
+		static FileWriteQueue instance;
+
+		return &instance;
+	}
+
+	FileWriteQueue::FileWriteQueue( )
+	{
+		_pendingCount = 0;
+		_isRunning = true;
+
+		_thread = std::thread( &FileWriteQueue::Run, this );
+	}
+
+	FileWriteQueue::~FileWriteQueue( )
+	{
+		{
+			std::lock_guard<std::mutex> lock( _mutex );
+			_isRunning = false;
+		}
+
+		_queuedCondition.notify_all( );
+		_thread.join( );
+	}
+
+	std::shared_future<bool> FileWriteQueue::Write( const std::string &filepath, std::string data, const Callback &callback )
+	{
+		std::shared_future<bool> future;
+
+		{
+			std::lock_guard<std::mutex> lock( _mutex );
+
+			auto request = _requests.find( filepath );
+
+			// A write that hasn't started yet just takes the newer data, it keeps its place in the queue
+			if ( _requests.end( ) == request )
+			{
+				request = _requests.emplace( filepath, Request( ) ).first;
+				request->second.promise = std::make_shared<std::promise<bool>>( );
+				request->second.future = request->second.promise->get_future( ).share( );
+
+				_order.push_back( filepath );
+				_pendingCount++;
+			}
+
+			request->second.data = std::move( data );
+
+			if ( nullptr != callback )
+			{ request->second.callbacks.push_back( callback ); }
+
+			future = request->second.future;
+		}
+
+		_queuedCondition.notify_one( );
+
+		return future;
+	}
+
+	void FileWriteQueue::Wait( const std::string &filepath )
+	{
+		if ( 0 == _pendingCount )
+		{ return; }
+
+		std::unique_lock<std::mutex> lock( _mutex );
+		_finishedCondition.wait( lock, [&]( ) { return !IsPending( filepath ); } );
+	}
+
+	void FileWriteQueue::Flush( )
+	{
+		std::unique_lock<std::mutex> lock( _mutex );
+		_finishedCondition.wait( lock, [this]( ) { return 0 == _pendingCount; } );
+	}
+
+	unsigned int FileWriteQueue::GetPendingCount( ) const
+	{ return _pendingCount; }
+
+	bool FileWriteQueue::WriteAtomically( const std::string &filepath, const std::string &data )
+	{
+		const std::string temporaryFilepath = filepath + ".tmp";
+
+#ifdef _WIN32
+		HANDLE file = CreateFileA( temporaryFilepath.c_str( ), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr );
+
+		if ( INVALID_HANDLE_VALUE == file )
+		{ return false; }
+
+		DWORD written = 0;
+		bool isWritten = data.empty( ) || ( WriteFile( file, data.data( ), static_cast<DWORD>( data.size( ) ), &written, nullptr ) && data.size( ) == written );
+
+		isWritten = isWritten && FlushFileBuffers( file );
+		CloseHandle( file );
+
+		if ( !isWritten || !MoveFileExA( temporaryFilepath.c_str( ), filepath.c_str( ), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH ) )
+		{
+			DeleteFileA( temporaryFilepath.c_str( ) );
+
+			return false;
+		}
+#else
+		const int file = open( temporaryFilepath.c_str( ), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+
+		if ( -1 == file )
+		{ return false; }
+
+		bool isWritten = true;
+
+		for ( std::size_t written = 0; isWritten && written < data.size( ); )
+		{
+			const ssize_t result = write( file, data.data( ) + written, data.size( ) - written );
+
+			if ( result >= 0 )
+			{ written += result; }
+			else if ( EINTR != errno )
+			{ isWritten = false; }
+		}
+
+		// The data has to be on disk before the rename, or a crash could leave the new name pointing at an empty file
+		isWritten = isWritten && 0 == fsync( file );
+		isWritten = ( 0 == close( file ) ) && isWritten;
+
+		if ( !isWritten || 0 != rename( temporaryFilepath.c_str( ), filepath.c_str( ) ) )
+		{
+			unlink( temporaryFilepath.c_str( ) );
+
+			return false;
+		}
+
+		// Flushing the directory makes the rename itself survive a crash
+		const std::string directory = std::filesystem::path( filepath ).parent_path( ).string( );
+		const int directoryFile = open( directory.empty( ) ? "." : directory.c_str( ), O_RDONLY );
+
+		if ( -1 != directoryFile )
+		{
+			fsync( directoryFile );
+			close( directoryFile );
+		}
+#endif
+
+		return true;
+	}
+
+	void FileWriteQueue::Run( )
+	{
+		std::unique_lock<std::mutex> lock( _mutex );
+
+		while ( true )
+		{
+			_queuedCondition.wait( lock, [this]( ) { return !_order.empty( ) || !_isRunning; } );
+
+			// Queued writes are finished before stopping so no save is lost on exit
+			if ( _order.empty( ) )
+			{ return; }
+
+			const std::string filepath = _order.front( );
+			_order.pop_front( );
+
+			// Taken out of the queue so writes made while this one runs queue up behind it rather than joining it
+			Request request = std::move( _requests.at( filepath ) );
+			_requests.erase( filepath );
+			_writingFilepath = filepath;
+
+			lock.unlock( );
+
+			const bool isWritten = WriteAtomically( filepath, request.data );
+
+			if ( !isWritten )
+			{ Debug::LogStatic( "Couldn't save \"" + filepath + "\"" ); }
+
+			for ( const Callback &callback : request.callbacks )
+			{ callback( isWritten ); }
+
+			request.promise->set_value( isWritten );
+
+			lock.lock( );
+
+			_writingFilepath.clear( );
+			_pendingCount--;
+
+			_finishedCondition.notify_all( );
+		}
+	}
+
+	bool FileWriteQueue::IsPending( const std::string &filepath ) const
+	{ return filepath == _writingFilepath || _requests.end( ) != _requests.find( filepath ); }
+}
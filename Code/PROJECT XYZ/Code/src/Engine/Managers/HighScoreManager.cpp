@@ -9,6 +9,7 @@ namespace Sonar
 
 	void HighScoreManager::LoadScoresFromFile( const std::string &filepath )
 	{
+		_loadedFilepath = filepath;
 		_scoresList.clear( );
 		_scores.clear( );
 
@@ -50,7 +51,9 @@ namespace Sonar
 
 	void HighScoreManager::SaveScore( const std::string &filepath, const long long &score, const std::string &name )
 	{
-		LoadScoresFromFile( filepath );
+		// This manager wrote the file last, so the scores in memory already match it
+		if ( filepath != _loadedFilepath )
+		{ LoadScoresFromFile( filepath ); }
 
 		int position = CheckScore( _scores, score );
 
@@ -64,17 +67,22 @@ namespace Sonar
 
 	int HighScoreManager::CheckScore( const std::vector<long long> &scores, const long long &score ) const
 	{
-		for ( unsigned int i = 0; i < scores.size( ); i++ )
-		{
-			if ( score > scores.at( i ) )
-			{ return i; }
-		}
+		// Scores are sorted highest first, so the new score goes before the first lower one
+		const auto position = std::upper_bound( scores.begin( ), scores.end( ), score, std::greater<long long>( ) );
 
-		return -1;
+		if ( scores.end( ) == position )
+		{ return -1; }
+
+		return position - scores.begin( );
 	}
 
 	void HighScoreManager::SetMaximumNumberOfHighScores( const unsigned int &maxNumOfHighScores )
-	{ _maxNumOfHighScores = maxNumOfHighScores; }
+	{
+		_maxNumOfHighScores = maxNumOfHighScores;
+
+		// The scores in memory are sized for the old maximum
+		_loadedFilepath.clear( );
+	}
 
 	unsigned int HighScoreManager::GetMaximumNumberOfHighScores( ) const
 	{ return _maxNumOfHighScores; }
@@ -96,36 +104,24 @@ namespace Sonar
 			_scoresList.push_back( scoreInfo );
 		}
 
+		// A file made with a different size is reloaded to the manager's maximum before scores are saved to it
+		_loadedFilepath = ( maxNumOfHighScores == _maxNumOfHighScores ) ? filepath : "";
+
 		SaveFile( filepath );
 	}
 
 	void HighScoreManager::UpdateScores( const unsigned int &position, const long long &score, const std::string &name )
 	{
-		std::vector<ScoreInfo> newScoresList;
-		std::vector<long long> newScores;
+		// The lowest score drops off the end, so overwrite it with the new score and rotate it into place
+		ScoreInfo &newScoreInfo = _scoresList.back( );
+		newScoreInfo._dateTime = Time::GetCurrentEpochDateTime( );
+		newScoreInfo._name = name;
+		newScoreInfo._score = score;
 
-		for ( unsigned int i = 0; i < position; i++ )
-		{
-			newScoresList.push_back( _scoresList.at( i ) );
-			newScores.push_back( _scores.at( i ) );
-		}
-
-		ScoreInfo newScoreinfo;
-		newScoreinfo._dateTime = Time::GetCurrentEpochDateTime( );
-		newScoreinfo._name = name;
-		newScoreinfo._score = score;
-
-		newScoresList.push_back( newScoreinfo );
-		newScores.push_back( score );
-
-		for ( unsigned int i = position; i < _scoresList.size( ) - 1; i++ )
-		{
-			newScoresList.push_back( _scoresList.at( i ) );
-			newScores.push_back( _scores.at( i ) );
-		}
+		_scores.back( ) = score;
 
-		_scoresList = newScoresList;
-		_scores = newScores;
+		std::rotate( _scoresList.begin( ) + position, _scoresList.end( ) - 1, _scoresList.end( ) );
+		std::rotate( _scores.begin( ) + position, _scores.end( ) - 1, _scores.end( ) );
 	}
 
 	void HighScoreManager::SaveFile( const std::string &filepath )
@@ -143,7 +139,7 @@ namespace Sonar
 		}
 
 		FileManager manager;
-		manager.WriteToFile( filepath, scoreListJSON.dump( ), FileManager::WRITE_PROPERTY::ADD_TO_CURRENT_LINE, true, true );
+		manager.WriteToFileAsync( filepath, scoreListJSON.dump( ) );
 	}
 
 }
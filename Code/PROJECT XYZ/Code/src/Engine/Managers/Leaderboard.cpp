@@ -0,0 +1,493 @@
+#include "pch.hpp"
+
+namespace
+{
+	/**
+	 * \brief Size of the file header (magic, version)
+	 */
+	const std::size_t LEADERBOARD_HEADER_SIZE = 8;
+
+	/**
+	 * \brief Size of a record before its name (score, date time, name length)
+	 */
+	const std::size_t LEADERBOARD_RECORD_SIZE = 18;
+
+	template<typename T>
+	void WriteValue( std::string &buffer, const T &value )
+	{ buffer.append( reinterpret_cast<const char *>( &value ), sizeof( value ) ); }
+
+	template<typename T>
+	T ReadValue( const char *data )
+	{
+		T value;
+		std::memcpy( &value, data, sizeof( value ) );
+
+		return value;
+	}
+
+	std::string MakeHeader( )
+	{
+		std::string header( SONAR_LEADERBOARD_MAGIC, 4 );
+		WriteValue<uint32_t>( header, SONAR_LEADERBOARD_VERSION );
+
+		return header;
+	}
+}
+
+namespace Sonar
+{
+	Leaderboard::Leaderboard( )
+	{
+		_entries.emplace_back( );
+		_root = 0;
+		_sequence = 0;
+		_recordCount = 0;
+		_isOpen = false;
+	}
+
+	Leaderboard::~Leaderboard( )
+	{ Close( ); }
+
+	bool Leaderboard::Open( const std::string &filepath )
+	{
+		Close( );
+
+		// A compaction queued before the file was last closed has to land before it's read
+		FileWriteQueue::getInstance( )->Wait( filepath );
+
+		bool isDamaged = false;
+
+		{
+			MappedFile file;
+
+			if ( file.Open( filepath ) && file.GetSize( ) > 0 )
+			{
+				const char *data = file.GetData( );
+				const std::size_t size = file.GetSize( );
+
+				if ( size < LEADERBOARD_HEADER_SIZE || 0 != std::memcmp( data, SONAR_LEADERBOARD_MAGIC, 4 ) || SONAR_LEADERBOARD_VERSION != ReadValue<uint32_t>( data + 4 ) )
+				{
+					Debug::LogStatic( "\"" + filepath + "\" isn't a version " + std::to_string( SONAR_LEADERBOARD_VERSION ) + " leaderboard" );
+
+					return false;
+				}
+
+				std::size_t position = LEADERBOARD_HEADER_SIZE;
+
+				// A record cut short by a crash ends the replay, compaction then drops it from the file
+				while ( size - position >= LEADERBOARD_RECORD_SIZE )
+				{
+					const uint16_t nameLength = ReadValue<uint16_t>( data + position + 16 );
+
+					if ( size - position - LEADERBOARD_RECORD_SIZE < nameLength )
+					{ break; }
+
+					Apply( std::string( data + position + LEADERBOARD_RECORD_SIZE, nameLength ), ReadValue<long long>( data + position ), ReadValue<unsigned long long>( data + position + 8 ) );
+
+					position += LEADERBOARD_RECORD_SIZE + nameLength;
+					_recordCount++;
+				}
+
+				if ( position != size )
+				{
+					Debug::LogStatic( "\"" + filepath + "\" ends with a damaged record, it will be dropped" );
+					isDamaged = true;
+				}
+			}
+			else if ( std::filesystem::is_directory( filepath ) )
+			{ return false; }
+			else
+			{
+				std::ofstream newFile( filepath, std::ios::out | std::ios::binary | std::ios::trunc );
+				const std::string header = MakeHeader( );
+
+				newFile.write( header.data( ), header.size( ) );
+
+				if ( !newFile.good( ) )
+				{ return false; }
+			}
+		}
+
+		_filepath = filepath;
+		_isOpen = true;
+
+		// Appending after a damaged record would bury the new records behind it
+		if ( isDamaged )
+		{ Compact( ); }
+
+		return true;
+	}
+
+	void Leaderboard::Close( )
+	{
+		if ( _isOpen )
+		{
+			if ( _compaction.valid( ) )
+			{ _compaction.wait( ); }
+
+			WriteRecords( );
+			_file.close( );
+		}
+
+		_entries.clear( );
+		_entries.emplace_back( );
+		_players.clear( );
+		_root = 0;
+		_sequence = 0;
+		_filepath.clear( );
+		_recordCount = 0;
+		_unwrittenRecords.clear( );
+		_compaction = std::shared_future<bool>( );
+		_isOpen = false;
+	}
+
+	bool Leaderboard::IsOpen( ) const
+	{ return _isOpen; }
+
+	int Leaderboard::Submit( const std::string &name, const long long &score )
+	{
+		const uint32_t node = Apply( name, score, Time::GetCurrentEpochDateTime( ) );
+
+		if ( 0 == node )
+		{ return -1; }
+
+		if ( _isOpen )
+		{
+			AppendRecord( node, _unwrittenRecords );
+			_recordCount++;
+
+			WriteRecords( );
+
+			if ( _recordCount >= DEFAULT_LEADERBOARD_COMPACTION_MINIMUM && _recordCount >= GetCount( ) * DEFAULT_LEADERBOARD_COMPACTION_RATIO )
+			{ Compact( ); }
+		}
+
+		return GetRank( name );
+	}
+
+	int Leaderboard::GetRank( const std::string &name ) const
+	{
+		const auto player = _players.find( name );
+
+		if ( _players.end( ) == player )
+		{ return -1; }
+
+		const uint32_t key = player->second;
+
+		unsigned int rank = 0;
+
+		for ( uint32_t node = _root; 0 != node; )
+		{
+			const Entry &entry = _entries[node];
+
+			if ( key == node )
+			{ return rank + _entries[entry.left].size; }
+
+			if ( Precedes( key, node ) )
+			{ node = entry.left; }
+			else
+			{
+				rank += _entries[entry.left].size + 1;
+				node = entry.right;
+			}
+		}
+
+		return -1;
+	}
+
+	unsigned int Leaderboard::GetRankOfScore( const long long &score ) const
+	{
+		unsigned int rank = 0;
+
+		for ( uint32_t node = _root; 0 != node; )
+		{
+			const Entry &entry = _entries[node];
+
+			if ( entry.score > score )
+			{
+				rank += _entries[entry.left].size + 1;
+				node = entry.right;
+			}
+			else
+			{ node = entry.left; }
+		}
+
+		return rank;
+	}
+
+	bool Leaderboard::GetEntry( const unsigned int &rank, ScoreInfo &entry ) const
+	{
+		unsigned int remaining = rank;
+
+		for ( uint32_t node = _root; 0 != node; )
+		{
+			const Entry &current = _entries[node];
+			const unsigned int leftSize = _entries[current.left].size;
+
+			if ( remaining < leftSize )
+			{ node = current.left; }
+			else if ( remaining == leftSize )
+			{
+				entry = GetScoreInfo( node );
+
+				return true;
+			}
+			else
+			{
+				remaining -= leftSize + 1;
+				node = current.right;
+			}
+		}
+
+		return false;
+	}
+
+	std::vector<ScoreInfo> Leaderboard::GetPage( const unsigned int &page, const unsigned int &pageSize ) const
+	{
+		std::vector<ScoreInfo> entries;
+
+		const unsigned long long begin = static_cast<unsigned long long>( page ) * pageSize;
+
+		if ( begin >= GetCount( ) )
+		{ return entries; }
+
+		const unsigned int end = std::min<unsigned long long>( begin + pageSize, GetCount( ) );
+
+		entries.reserve( end - begin );
+		Collect( _root, 0, begin, end, entries );
+
+		return entries;
+	}
+
+	unsigned int Leaderboard::GetCount( ) const
+	{ return _entries[_root].size; }
+
+	void Leaderboard::Compact( )
+	{
+		if ( !_isOpen )
+		{ return; }
+
+		if ( _compaction.valid( ) )
+		{
+			if ( std::future_status::ready != _compaction.wait_for( std::chrono::seconds( 0 ) ) )
+			{ return; }
+
+			_compaction = std::shared_future<bool>( );
+		}
+
+		std::string snapshot = MakeHeader( );
+		WriteSnapshot( _root, snapshot );
+
+		// The snapshot already holds every record still waiting to be written
+		_file.close( );
+		_unwrittenRecords.clear( );
+		_recordCount = GetCount( );
+
+		_compaction = FileWriteQueue::getInstance( )->Write( _filepath, std::move( snapshot ) );
+	}
+
+	uint32_t Leaderboard::Apply( const std::string &name, const long long &score, const unsigned long long &dateTime )
+	{
+		auto player = _players.find( name );
+		uint32_t node;
+
+		if ( _players.end( ) == player )
+		{
+			node = _entries.size( );
+			_entries.emplace_back( );
+
+			player = _players.emplace( name, node ).first;
+
+			_entries[node].name = &player->first;
+			_entries[node].priority = _random( );
+		}
+		else
+		{
+			node = player->second;
+
+			if ( score <= _entries[node].score )
+			{ return 0; }
+
+			Erase( node );
+		}
+
+		Entry &entry = _entries[node];
+		entry.score = score;
+		entry.dateTime = dateTime;
+		entry.sequence = _sequence++;
+		entry.left = 0;
+		entry.right = 0;
+		entry.size = 1;
+
+		Insert( node );
+
+		return node;
+	}
+
+	bool Leaderboard::Precedes( const uint32_t &node, const uint32_t &other ) const
+	{
+		const Entry &entry = _entries[node];
+		const Entry &otherEntry = _entries[other];
+
+		if ( entry.score != otherEntry.score )
+		{ return entry.score > otherEntry.score; }
+
+		return entry.sequence < otherEntry.sequence;
+	}
+
+	void Leaderboard::Resize( const uint32_t &node )
+	{
+		Entry &entry = _entries[node];
+		entry.size = _entries[entry.left].size + _entries[entry.right].size + 1;
+	}
+
+	uint32_t Leaderboard::Merge( const uint32_t &left, const uint32_t &right )
+	{
+		if ( 0 == left )
+		{ return right; }
+
+		if ( 0 == right )
+		{ return left; }
+
+		if ( _entries[left].priority > _entries[right].priority )
+		{
+			_entries[left].right = Merge( _entries[left].right, right );
+			Resize( left );
+
+			return left;
+		}
+
+		_entries[right].left = Merge( left, _entries[right].left );
+		Resize( right );
+
+		return right;
+	}
+
+	void Leaderboard::Split( const uint32_t node, const uint32_t &key, uint32_t &left, uint32_t &right )
+	{
+		if ( 0 == node )
+		{
+			left = 0;
+			right = 0;
+
+			return;
+		}
+
+		if ( Precedes( node, key ) )
+		{
+			Split( _entries[node].right, key, _entries[node].right, right );
+			left = node;
+		}
+		else
+		{
+			Split( _entries[node].left, key, left, _entries[node].left );
+			right = node;
+		}
+
+		Resize( node );
+	}
+
+	uint32_t Leaderboard::RemoveFirst( const uint32_t &node )
+	{
+		Entry &entry = _entries[node];
+
+		if ( 0 == entry.left )
+		{ return entry.right; }
+
+		entry.left = RemoveFirst( entry.left );
+		Resize( node );
+
+		return node;
+	}
+
+	void Leaderboard::Insert( const uint32_t &node )
+	{
+		uint32_t left, right;
+
+		Split( _root, node, left, right );
+		_root = Merge( Merge( left, node ), right );
+	}
+
+	void Leaderboard::Erase( const uint32_t &node )
+	{
+		uint32_t left, right;
+
+		// The node is the first of the nodes that don't rank ahead of it
+		Split( _root, node, left, right );
+		_root = Merge( left, RemoveFirst( right ) );
+	}
+
+	void Leaderboard::Collect( const uint32_t &node, const unsigned int &offset, const unsigned int &begin, const unsigned int &end, std::vector<ScoreInfo> &entries ) const
+	{
+		const Entry &entry = _entries[node];
+
+		if ( 0 == node || offset >= end || offset + entry.size <= begin )
+		{ return; }
+
+		Collect( entry.left, offset, begin, end, entries );
+
+		const unsigned int rank = offset + _entries[entry.left].size;
+
+		if ( rank >= begin && rank < end )
+		{ entries.push_back( GetScoreInfo( node ) ); }
+
+		Collect( entry.right, rank + 1, begin, end, entries );
+	}
+
+	void Leaderboard::WriteSnapshot( const uint32_t &node, std::string &snapshot ) const
+	{
+		if ( 0 == node )
+		{ return; }
+
+		// Rank order keeps equal scores in the order they were reached once the file is replayed
+		WriteSnapshot( _entries[node].left, snapshot );
+		AppendRecord( node, snapshot );
+		WriteSnapshot( _entries[node].right, snapshot );
+	}
+
+	void Leaderboard::AppendRecord( const uint32_t &node, std::string &records ) const
+	{
+		const Entry &entry = _entries[node];
+		const uint16_t nameLength = std::min<std::size_t>( entry.name->size( ), UINT16_MAX );
+
+		WriteValue( records, entry.score );
+		WriteValue( records, entry.dateTime );
+		WriteValue( records, nameLength );
+		records.append( entry.name->data( ), nameLength );
+	}
+
+	void Leaderboard::WriteRecords( )
+	{
+		if ( _unwrittenRecords.empty( ) )
+		{ return; }
+
+		if ( _compaction.valid( ) )
+		{
+			if ( std::future_status::ready != _compaction.wait_for( std::chrono::seconds( 0 ) ) )
+			{ return; }
+
+			// A failed compaction left the old file in place, which the records still follow on from
+			_compaction = std::shared_future<bool>( );
+		}
+
+		if ( !_file.is_open( ) )
+		{ _file.open( _filepath, std::ios::out | std::ios::binary | std::ios::app ); }
+
+		_file.write( _unwrittenRecords.data( ), _unwrittenRecords.size( ) );
+		_file.flush( );
+
+		_unwrittenRecords.clear( );
+	}
+
+	ScoreInfo Leaderboard::GetScoreInfo( const uint32_t &node ) const
+	{
+		const Entry &entry = _entries[node];
+
+		ScoreInfo scoreInfo;
+		scoreInfo._name = *entry.name;
+		scoreInfo._dateTime = entry.dateTime;
+		scoreInfo._score = entry.score;
+
+		return scoreInfo;
+	}
+}
@@ -1,119 +1,222 @@
 #include "pch.hpp"
 
-namespace Sonar
+namespace
 {
-	MapManager::MapManager( const int &arraySizeX, const int &arraySizeY )
+	/**
+	 * \brief Amount of cells in a chunk
+	 */
+	const std::size_t MAP_CHUNK_AREA = SONAR_MAP_CHUNK_SIZE * SONAR_MAP_CHUNK_SIZE;
+
+	/**
+	 * \brief Value of cells that haven't been set
+	 */
+	const Sonar::MapCell MAP_EMPTY_CELL = ' ';
+
+	/**
+	 * \brief Run a function for each non empty field of a CSV line
+	 */
+	template<typename Function>
+	void ForEachField( const std::string_view &line, Function &&function )
 	{
-		_arraySize[0] = arraySizeX;
-		_arraySize[1] = arraySizeY;
+		std::size_t start = 0;
 
-		_map = new char *[arraySizeY];
+		while ( start <= line.size( ) )
+		{
+			std::size_t end = line.find( ',', start );
 
-		for ( int i = 0; i < arraySizeY; i++ )
-		{ _map[i] = new char[arraySizeX]; }
+			if ( std::string_view::npos == end )
+			{ end = line.size( ); }
 
-		for ( int y = 0; y < arraySizeY; y++ )
-		{
-			for ( int x = 0; x < arraySizeX; x++ )
-			{ _map[y][x] = ' '; }
+			if ( end > start )
+			{ function( line.substr( start, end - start ) ); }
+
+			start = end + 1;
 		}
 	}
 
-	MapManager::~MapManager( )
-	{ DeleteMapPointer( ); }
+	/**
+	 * \brief Read a CSV field as a cell, a single character is stored as is and anything longer as a number
+	 */
+	Sonar::MapCell ParseField( const std::string_view &field )
+	{
+		Sonar::MapCell value;
+
+		if ( field.size( ) > 1 && std::errc( ) == std::from_chars( field.data( ), field.data( ) + field.size( ), value ).ec )
+		{ return value; }
+
+		return static_cast<unsigned char>( field[0] );
+	}
+}
+
+namespace Sonar
+{
+	MapManager::MapManager( const int &arraySizeX, const int &arraySizeY, const unsigned int &layerCount )
+	{
+		_lastVersion = 0;
 
-	void MapManager::InitializeMapWithAValue( const char &value )
+		Resize( std::max( arraySizeX, 0 ), std::max( arraySizeY, 0 ), layerCount );
+	}
+
+	MapManager::~MapManager( ) { }
+
+	void MapManager::InitializeMapWithAValue( const MapCell &value )
 	{
-		for ( unsigned int y = 0; y < _arraySize[1]; y++ )
+		_storage.assign( GetCellCount( ), value );
+		_cells = _storage.data( );
+		_mappedFile.Close( );
+
+		ChangeAllChunks( );
+	}
+
+	void MapManager::SetValue( const MapCell &value, const unsigned int &posX, const unsigned int &posY, const unsigned int &layer )
+	{
+		if ( posX < _arraySize.x && posY < _arraySize.y && layer < _layerCount )
 		{
-			for ( unsigned int x = 0; x < _arraySize[0]; x++ )
-			{ _map[y][x] = value; }
+			DetachFromFile( );
+			_storage[GetIndex( posX, posY, layer )] = value;
+
+			_chunkVersions[( static_cast<std::size_t>( layer ) * _chunkCount.y + posY / SONAR_MAP_CHUNK_SIZE ) * _chunkCount.x + posX / SONAR_MAP_CHUNK_SIZE] = ++_lastVersion;
 		}
 	}
 
-	void MapManager::SetValue( const char &value, const unsigned int &posX, const unsigned int &posY )
+	MapCell MapManager::GetValue( const unsigned int &posX, const unsigned int &posY, const unsigned int &layer ) const
 	{
-		if ( posX < _arraySize[0] && posY < _arraySize[1] )
-		{ _map[posY][posX] = value; }
+		if ( posX < _arraySize.x && posY < _arraySize.y && layer < _layerCount )
+		{ return _cells[GetIndex( posX, posY, layer )]; }
+		else
+		{ return MAP_EMPTY_CELL; }
 	}
 
-	char MapManager::GetValue( const unsigned int &posX, const unsigned int &posY ) const
+	const MapCell *MapManager::GetChunk( const unsigned int &chunkX, const unsigned int &chunkY, const unsigned int &layer ) const
 	{
-		if ( posX < _arraySize[0] && posY < _arraySize[1] )
-		{ return _map[posY][posX]; }
+		if ( chunkX < _chunkCount.x && chunkY < _chunkCount.y && layer < _layerCount )
+		{ return _cells + GetIndex( chunkX * SONAR_MAP_CHUNK_SIZE, chunkY * SONAR_MAP_CHUNK_SIZE, layer ); }
 		else
-		{ return ' '; }
+		{ return nullptr; }
 	}
 
-	void MapManager::SaveMap( const std::string &filepath )
+	unsigned long long MapManager::GetChunkVersion( const unsigned int &chunkX, const unsigned int &chunkY, const unsigned int &layer ) const
 	{
-		std::string mapCSV = "";
+		if ( chunkX < _chunkCount.x && chunkY < _chunkCount.y && layer < _layerCount )
+		{ return _chunkVersions[( static_cast<std::size_t>( layer ) * _chunkCount.y + chunkY ) * _chunkCount.x + chunkX]; }
+		else
+		{ return 0; }
+	}
 
-		for ( unsigned int y = 0; y < _arraySize[1]; y++ )
-		{
-			for ( unsigned int x = 0; x < _arraySize[0]; x++ )
-			{
-				mapCSV += _map[x][y];
+	std::shared_future<bool> MapManager::SaveMap( const std::string &filepath )
+	{
+		// Some platforms can't replace a file that's mapped
+		DetachFromFile( );
 
-				if ( !( y + 1 == _arraySize[1] && x + 1 == _arraySize[0] ) )
-				{ mapCSV += ","; }
-			}
+		Header header;
+		std::memcpy( header.magic, SONAR_MAP_MAGIC, sizeof( header.magic ) );
+		header.version = SONAR_MAP_VERSION;
+		header.sizeX = _arraySize.x;
+		header.sizeY = _arraySize.y;
+		header.layerCount = _layerCount;
+		header.chunkSize = SONAR_MAP_CHUNK_SIZE;
 
-			mapCSV += "\n";
-		}
+		std::string data( sizeof( header ) + GetCellCount( ) * sizeof( MapCell ), '\0' );
+		std::memcpy( &data[0], &header, sizeof( header ) );
 
-		FileManager fileManager;
+		if ( !_storage.empty( ) )
+		{ std::memcpy( &data[sizeof( header )], _storage.data( ), _storage.size( ) * sizeof( MapCell ) ); }
 
-		fileManager.WriteToFile( filepath, mapCSV, FileManager::WRITE_PROPERTY::ADD_TO_CURRENT_LINE, true, true );
+		return FileWriteQueue::getInstance( )->Write( filepath, std::move( data ) );
 	}
 
-	void MapManager::LoadMap( const std::string &filepath )
+	bool MapManager::LoadMap( const std::string &filepath )
 	{
-		DeleteMapPointer( );
+		// The file is read through its own mapping, so a save that's still queued has to land first
+		FileWriteQueue::getInstance( )->Wait( filepath );
 
-		FileManager fileManager;
+		Resize( 0, 0, 0 );
+
+		if ( !_mappedFile.Open( filepath ) )
+		{ return false; }
+
+		const char *data = _mappedFile.GetData( );
+		const std::size_t size = _mappedFile.GetSize( );
+
+		Header header;
+
+		if ( size < sizeof( header ) || 0 != std::memcmp( data, SONAR_MAP_MAGIC, sizeof( header.magic ) ) )
+		{
+			_mappedFile.Close( );
+
+			return ImportCSV( filepath );
+		}
+
+		std::memcpy( &header, data, sizeof( header ) );
+
+		const unsigned long long chunkCountX = ( header.sizeX + SONAR_MAP_CHUNK_SIZE - 1ull ) / SONAR_MAP_CHUNK_SIZE;
+		const unsigned long long chunkCountY = ( header.sizeY + SONAR_MAP_CHUNK_SIZE - 1ull ) / SONAR_MAP_CHUNK_SIZE;
+		const unsigned long long fileCellCount = ( size - sizeof( header ) ) / sizeof( MapCell );
+
+		// Checked by dividing so huge sizes in a damaged header can't overflow
+		const bool isSizeValid = ( 0 == header.layerCount || 0 == chunkCountX * chunkCountY ) ?
+			sizeof( header ) == size :
+			chunkCountX * chunkCountY <= fileCellCount / header.layerCount / MAP_CHUNK_AREA && sizeof( header ) + chunkCountX * chunkCountY * header.layerCount * MAP_CHUNK_AREA * sizeof( MapCell ) == size;
+
+		if ( SONAR_MAP_VERSION != header.version || SONAR_MAP_CHUNK_SIZE != header.chunkSize || !isSizeValid )
+		{
+			Debug::LogStatic( "\"" + filepath + "\" isn't a version " + std::to_string( SONAR_MAP_VERSION ) + " map with " + std::to_string( SONAR_MAP_CHUNK_SIZE ) + " cell chunks" );
+			_mappedFile.Close( );
+
+			return false;
+		}
+
+		_arraySize = glm::uvec2( header.sizeX, header.sizeY );
+		_chunkCount = glm::uvec2( chunkCountX, chunkCountY );
+		_layerCount = header.layerCount;
 
-		csv::CSVFormat csvFormat;
-		csvFormat.no_header( );
+		// The header keeps the cells aligned, they're used straight from the mapping
+		_cells = reinterpret_cast<const MapCell *>( data + sizeof( header ) );
 
-		csv::CSVReader *reader = new csv::CSVReader( filepath, csvFormat );
+		ChangeAllChunks( );
 
-		for ( csv::CSVRow &row : *reader ) { }
+		return true;
+	}
 
-		_arraySize.y = reader->n_rows( ) + 1;
+	bool MapManager::ImportCSV( const std::string &filepath )
+	{
+		FileManager fileManager;
 
-		reader = new csv::CSVReader( filepath, csvFormat );
+		const FileManager::LineRange lines = fileManager.GetLines( filepath );
 
-		int x = 0, y = 0;
+		if ( FileManager::FILE_STATUS::OPEN != fileManager.GetStatus( ) )
+		{
+			Resize( 0, 0, 0 );
 
-		_map = new char *[_arraySize.y];
+			return false;
+		}
 
-		for ( csv::CSVRow &row : *reader )
+		unsigned int width = 0, height = 0;
+
+		for ( const std::string_view &line : lines )
 		{
-			x = 0;
+			unsigned int x = 0;
+			ForEachField( line, [&]( const std::string_view & ) { x++; } );
 
-			std::vector<char> allCharsInARow;
+			width = std::max( width, x );
+			height++;
+		}
 
-			for ( csv::CSVField &field : row )
-			{
-				const std::string strValue = field.get<>( );
+		Resize( width, height, 1 );
 
-				if ( "" != strValue )
-				{
-					allCharsInARow.push_back( strValue[0] );
-					x++;
-				}
-			}
-			
-			_map[y] = new char[x];
+		unsigned int y = 0;
 
-			for ( unsigned int i = 0; i < allCharsInARow.size( ); i++ )
-			{ _map[y][i] = allCharsInARow.at( i ); }
+		for ( const std::string_view &line : lines )
+		{
+			unsigned int x = 0;
+			ForEachField( line, [&]( const std::string_view &field ) { _storage[GetIndex( x++, y, 0 )] = ParseField( field ); } );
 
 			y++;
 		}
 
-		_arraySize.x = x;
+		ChangeAllChunks( );
+
+		return true;
 	}
 
 	glm::uvec2 MapManager::GetSize( ) const
@@ -125,6 +228,46 @@ namespace Sonar
 	unsigned int MapManager::GetSizeY( ) const
 	{ return _arraySize.y; }
 
-	void MapManager::DeleteMapPointer( )
-	{ delete _map; }
+	unsigned int MapManager::GetLayerCount( ) const
+	{ return _layerCount; }
+
+	glm::uvec2 MapManager::GetChunkCount( ) const
+	{ return _chunkCount; }
+
+	void MapManager::Resize( const unsigned int &sizeX, const unsigned int &sizeY, const unsigned int &layerCount )
+	{
+		_mappedFile.Close( );
+
+		_arraySize = glm::uvec2( sizeX, sizeY );
+		_chunkCount = ( _arraySize + glm::uvec2( SONAR_MAP_CHUNK_SIZE - 1 ) ) / glm::uvec2( SONAR_MAP_CHUNK_SIZE );
+		_layerCount = layerCount;
+
+		_storage.assign( GetCellCount( ), MAP_EMPTY_CELL );
+		_cells = _storage.data( );
+
+		ChangeAllChunks( );
+	}
+
+	std::size_t MapManager::GetCellCount( ) const
+	{ return static_cast<std::size_t>( _layerCount ) * _chunkCount.x * _chunkCount.y * MAP_CHUNK_AREA; }
+
+	std::size_t MapManager::GetIndex( const unsigned int &posX, const unsigned int &posY, const unsigned int &layer ) const
+	{
+		const std::size_t chunk = ( static_cast<std::size_t>( layer ) * _chunkCount.y + posY / SONAR_MAP_CHUNK_SIZE ) * _chunkCount.x + posX / SONAR_MAP_CHUNK_SIZE;
+
+		return chunk * MAP_CHUNK_AREA + ( posY % SONAR_MAP_CHUNK_SIZE ) * SONAR_MAP_CHUNK_SIZE + posX % SONAR_MAP_CHUNK_SIZE;
+	}
+
+	void MapManager::DetachFromFile( )
+	{
+		if ( !_mappedFile.IsOpen( ) )
+		{ return; }
+
+		_storage.assign( _cells, _cells + GetCellCount( ) );
+		_cells = _storage.data( );
+		_mappedFile.Close( );
+	}
+
+	void MapManager::ChangeAllChunks( )
+	{ _chunkVersions.assign( static_cast<std::size_t>( _layerCount ) * _chunkCount.x * _chunkCount.y, ++_lastVersion ); }
 }
@@ -1,8 +1,50 @@
 #include "pch.hpp"
+#include "SplashState.hpp"
 
-int main( )
+int main( int argc, char *argv[] )
 {
-    Sonar::Game( SCREEN_WIDTH, SCREEN_HEIGHT, WINDOW_TITLE );
+    std::string recordFilepath;
+    std::string replayFilepath;
+    bool isHeadless = false;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        const std::string argument = argv[i];
+
+        if ( "--record" == argument && i + 1 < argc )
+        { recordFilepath = argv[++i]; }
+        else if ( "--replay" == argument && i + 1 < argc )
+        { replayFilepath = argv[++i]; }
+        else if ( "--headless" == argument )
+        { isHeadless = true; }
+        else
+        {
+            std::cerr << "Usage: ProjectXYZ [--record input.log] [--replay input.log [--headless]]" << std::endl;
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Replays the log as fast as possible without opening the window, then reports how it ran
+    if ( isHeadless )
+    {
+        if ( replayFilepath.empty( ) )
+        {
+            std::cerr << "--headless needs a log to --replay" << std::endl;
+
+            return EXIT_FAILURE;
+        }
+
+        Sonar::HeadlessRunner runner;
+        runner.AddState( Sonar::StateRef( new Sonar::SplashState( runner.GetGameData( ) ) ) );
+
+        const Sonar::HeadlessRunner::Report report = runner.RunReplay( replayFilepath );
+        runner.LogReport( report );
+
+        return ( 0 < report.steps ) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    Sonar::Game( SCREEN_WIDTH, SCREEN_HEIGHT, WINDOW_TITLE, DEFAULT_GAME_MULTITHREADED, recordFilepath, replayFilepath );
 
     return EXIT_SUCCESS;
 }
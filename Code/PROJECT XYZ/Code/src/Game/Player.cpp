@@ -58,12 +58,18 @@ namespace Sonar
         {
             _player->SetPositionY( -_player->GetHeight( ) );
         }
-		
+
+		// Draw only reads these, so it never sees the rectangles halfway through a step
+		_data->snapshots.SetTransform( PLAYER_SNAPSHOT_ID, _player->GetPosition( ), _player->GetRotation( ), _player->GetScale( ) );
+		_data->snapshots.SetTransform( OBJECT2_SNAPSHOT_ID, object2->GetPosition( ), object2->GetRotation( ), object2->GetScale( ) );
     }
 
-    void Player::Draw( float dt )
+    void Player::Draw( float interpolation )
     {
-		_player->Draw( );
-		object2->Draw( );
+		if ( _data->snapshots.HasTransform( PLAYER_SNAPSHOT_ID ) )
+		{ _player->Draw( _data->snapshots.GetTransform( PLAYER_SNAPSHOT_ID, interpolation ) ); }
+
+		if ( _data->snapshots.HasTransform( OBJECT2_SNAPSHOT_ID ) )
+		{ object2->Draw( _data->snapshots.GetTransform( OBJECT2_SNAPSHOT_ID, interpolation ) ); }
     }
 }
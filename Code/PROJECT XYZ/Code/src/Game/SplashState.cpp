@@ -5,8 +5,6 @@ namespace Sonar
 {
 	SplashState::SplashState( GameDataRef data ) : _data( data )
 	{
-		ImGui::SFML::Init( _data->window.GetSFMLWindowObject( ) );
-
         player = new Player( _data );
         physicsWorld = new PhysicsWorld( _data );
 
@@ -169,7 +167,7 @@ namespace Sonar
 	void SplashState::Update( const float &dt )
 	{
 		
-        //player->Update( dt );
+        player->Update( dt );
         
         //physicsWorld->Update( dt );
 
@@ -190,7 +188,7 @@ namespace Sonar
 
 	void SplashState::Draw( const float &dt )
 	{
-        //player->Draw( dt );
+        player->Draw( dt );
 		//physicsWorld->Draw( dt );
 
 		
@@ -0,0 +1,53 @@
+#include "pch.hpp"
+
+int main( int argc, char *argv[] )
+{
+	std::string outputFilepath = DEFAULT_ASSET_PACK_FILEPATH;
+	std::vector<std::string> directories;
+
+	bool isCompressed = true;
+
+	for ( int i = 1; i < argc; i++ )
+	{
+		const std::string argument = argv[i];
+
+		if ( "--output" == argument && i + 1 < argc )
+		{ outputFilepath = argv[++i]; }
+		else if ( "--store" == argument )
+		{ isCompressed = false; }
+		else if ( !argument.empty( ) && '-' != argument.front( ) )
+		{ directories.push_back( argument ); }
+		else
+		{
+			directories.clear( );
+			break;
+		}
+	}
+
+	if ( directories.empty( ) )
+	{
+		std::cerr << "Usage: sonar_pack [--output Resources.pak] [--store] directory..." << std::endl;
+
+		return EXIT_FAILURE;
+	}
+
+	if ( !Sonar::AssetPack::Build( outputFilepath, directories, isCompressed ) )
+	{
+		std::cerr << "Failed to write " << outputFilepath << std::endl;
+
+		return EXIT_FAILURE;
+	}
+
+	Sonar::AssetPack pack;
+
+	if ( !pack.Open( outputFilepath ) )
+	{
+		std::cerr << "Failed to open " << outputFilepath << " after writing it" << std::endl;
+
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "Packed " << pack.GetEntryCount( ) << " files into " << outputFilepath << std::endl;
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,35 @@
+#!/bin/sh
+#
+# Run sonar_stress on a machine without a GPU or display (CI)
+#
+# Mesa's llvmpipe software rasteriser does the OpenGL work and Xvfb provides the display,
+# both need to be installed (Debian/Ubuntu: xvfb, libgl1-mesa-dri)
+#
+#   ./run_stress.sh build/sonar_stress --output sonar_stress.json
+#
+# Scenes load from Resources/ so they're run from the project folder
+
+set -e
+
+if [ -z "$1" ]; then
+	echo "Usage: run_stress.sh path/to/sonar_stress [sonar_stress arguments]" >&2
+	exit 1
+fi
+
+STRESS="$(cd "$(dirname "$1")" && pwd)/$(basename "$1")"
+shift
+
+cd "$(dirname "$0")/../.."
+
+# Force the software rasteriser even when a GPU driver is present so results are comparable between machines
+export LIBGL_ALWAYS_SOFTWARE=1
+export GALLIUM_DRIVER=llvmpipe
+
+# Keep llvmpipe's thread count fixed, otherwise frame times scale with the CI machine's core count
+export LP_NUM_THREADS="${LP_NUM_THREADS:-4}"
+
+if [ -n "$DISPLAY" ] && [ -z "$SONAR_FORCE_XVFB" ]; then
+	exec "$STRESS" "$@"
+fi
+
+exec xvfb-run --auto-servernum --server-args="-screen 0 1280x720x24" "$STRESS" "$@"